@@ -1,61 +1,101 @@
 #include "MatchScheduler.hpp"
+#include "apuec_trace.hpp"
+#include "bracket.hpp"
+#include "group_stage.hpp"
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <cstring>
 
-MatchScheduler::MatchScheduler() {
+MatchScheduler::MatchScheduler(ostream* output, ChangeListener* listener)
+    : out(outputOrDiscard(output)), changes(listener) {
     teamCount = 0;
+    matchesPlayed = 0;
+    champion.name[0] = '\0';
+    format = FORMAT_GROUP_STAGE;
+    bracketReset = true;
+    live = nullptr;
+    matchDay = nullptr;
+    outcomes = nullptr;
+    whatIfEngine = nullptr;
+    dayStations = 4;
+    dayMatchMinutes = 30;
+    dayRestMinutes = 10;
+    logRows = 0;
+    logBytes = 0;
+    logNanos = 0;
     srand((unsigned int)time(NULL));
     resultFile.open("result.csv");
     if (!resultFile.is_open()) {
-        cout << "Error opening result.csv for logging." << endl;
+        *out << "Error opening result.csv for logging." << endl;
     } else {
         resultFile << "Team A,Team B,Winner\n";
     }
 }
 
+MatchScheduler::~MatchScheduler() {
+    delete whatIfEngine;
+    delete outcomes;
+    delete matchDay;
+    delete live;
+}
+
+// The top 96 seeds of the file, best first (teams[0] is seed 1)
 void MatchScheduler::readTeams(const char* filename) {
+    teamCount = 0;
+    vector<MatchTeam> entrants;
+    if (!readEntrants(filename, entrants)) {
+        return;
+    }
+    for (size_t i = 0; i < entrants.size() && teamCount < 96; i++) {
+        teams[teamCount++] = entrants[i];
+    }
+
+    if (teamCount < 96) {
+        *out << "Not enough teams in " << filename << " (need at least 96)" << endl;
+        teamCount = 0;
+    }
+}
+
+static int seedPriority(const char* status) {
+    if (strcmp(status, "early bird") == 0) return 0;
+    if (strcmp(status, "normal") == 0) return 1;
+    if (strcmp(status, "wild card") == 0) return 2;
+    return 3;
+}
+
+// Every team in the file in seed order: early bird, normal, wild card,
+// file order within a status
+bool MatchScheduler::readEntrants(const char* filename, vector<MatchTeam>& entrants) {
     ifstream file(filename);
     if (!file.is_open()) {
-        cout << "Error: Cannot open " << filename << endl;
-        teamCount = 0;
-        return;
+        *out << "Error: Cannot open " << filename << endl;
+        return false;
     }
 
-    PriorityQueueMatch pq;
+    vector<MatchTeam> byStatus[4];
     string line;
-    teamCount = 0;
-    while (getline(file, line) && teamCount < MAX_TEAMS) {
+    while (getline(file, line)) {
         size_t comma = line.find(',');
         if (comma == string::npos) continue;
 
-        string tname = line.substr(0, comma);
-        string tstatus = line.substr(comma + 1);
-
         MatchTeam t;
-        strncpy(t.name, tname.c_str(), 49);
+        strncpy(t.name, line.substr(0, comma).c_str(), 49);
         t.name[49] = '\0';
-        strncpy(t.status, tstatus.c_str(), 19);
+        strncpy(t.status, line.substr(comma + 1).c_str(), 19);
         t.status[19] = '\0';
         t.points = 0;
-
-        pq.insert(t);
-        teamCount++;
+        byStatus[seedPriority(t.status)].push_back(t);
     }
     file.close();
 
-    int i = 0;
-    while (!pq.isEmpty() && i < 96) {
-        teams[i++] = pq.remove();
-    }
-    teamCount = i;
-
-    if (teamCount < 96) {
-        cout << "Not enough teams in " << filename << " (need at least 96)" << endl;
-        teamCount = 0;
+    entrants.clear();
+    for (int s = 0; s < 4; s++) {
+        entrants.insert(entrants.end(), byStatus[s].begin(), byStatus[s].end());
     }
+    return true;
 }
 
 int MatchScheduler::randomWinner(int a, int b) {
@@ -63,126 +103,241 @@ int MatchScheduler::randomWinner(int a, int b) {
 }
 
 void MatchScheduler::printMatch(const MatchTeam& t1, const MatchTeam& t2, const MatchTeam& winner) {
-    cout << "Match: [" << t1.name << "] VS [" << t2.name << "] --> Winner: [" << winner.name << "]\n";
-    logMatchResult(t1.name, t2.name, winner.name);
+    printMatch(t1.name, t2.name, winner.name);
+}
+
+void MatchScheduler::printMatch(const char* teamA, const char* teamB, const char* winner) {
+    *out << "Match: [" << teamA << "] VS [" << teamB << "] --> Winner: [" << winner << "]\n";
+    playMatch(teamA, teamB, winner);
+}
+
+void MatchScheduler::playMatch(const char* teamA, const char* teamB, const char* winner) {
+    logMatchResult(teamA, teamB, winner);
+    matchesPlayed++;
+    if (changes) {
+        const char* loser = (strcmp(winner, teamA) == 0) ? teamB : teamA;
+        changes->onChange(MATCH_PLAYED, winner, loser);
+    }
+}
+
+static long long elapsedNanos(chrono::steady_clock::time_point since) {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - since).count();
 }
 
 void MatchScheduler::logMatchResult(const char* teamA, const char* teamB, const char* winner) {
     if (resultFile.is_open()) {
+        chrono::steady_clock::time_point started = chrono::steady_clock::now();
         resultFile << teamA << "," << teamB << "," << winner << "\n";
+        logNanos += elapsedNanos(started);
+        logRows++;
+        logBytes += strlen(teamA) + strlen(teamB) + strlen(winner) + 3;
+    }
+}
+
+void MatchScheduler::closeLog() {
+    if (resultFile.is_open()) {
+        chrono::steady_clock::time_point started = chrono::steady_clock::now();
+        resultFile.close();
+        logNanos += elapsedNanos(started);
     }
 }
 
+void MatchScheduler::flushLog() {
+    if (resultFile.is_open()) {
+        resultFile.flush();
+    }
+}
+
+bool MatchScheduler::restoreTournament(const vector<MatchLogEntry>& matches, const char* championName) {
+    APUEC_TRACE_SCOPE("MatchScheduler::restoreTournament");
+    if (!resultFile.is_open()) {
+        return false;
+    }
+
+    matchesPlayed = 0;
+    if (changes) changes->onChange(TOURNAMENT_STARTED, "snapshot", "");
+    for (size_t i = 0; i < matches.size(); i++) {
+        const MatchLogEntry& match = matches[i];
+        logMatchResult(match.teamA.c_str(), match.teamB.c_str(), match.winner.c_str());
+        matchesPlayed++;
+        if (changes) {
+            const string& loser = (match.winner == match.teamA) ? match.teamB : match.teamA;
+            changes->onChange(MATCH_PLAYED, match.winner, loser);
+        }
+    }
+
+    strncpy(champion.name, championName, sizeof(champion.name) - 1);
+    champion.name[sizeof(champion.name) - 1] = '\0';
+    closeLog();
+    if (changes) changes->onChange(TOURNAMENT_FINISHED, champion.name, "");
+    return true;
+}
+
 void MatchScheduler::knockoutRound(int& numTeams) {
-    cout << "\n=== Knockout Round: " << numTeams << " Teams ===\n";
+    APUEC_TRACE_SCOPE("MatchScheduler::knockoutRound");
+    *out << "\n=== Knockout Round: " << numTeams << " Teams ===\n";
 
-    QueueMatch queue;
+    // The kernel plays team indexes; the names are only touched for the
+    // commentary and the final write-back
+    MatchTeam entrants[MAX_TEAMS];
+    int ids[MAX_TEAMS];
     for (int i = 0; i < numTeams; i++) {
-        queue.enqueue(teams[i]);
+        entrants[i] = teams[i];
+        ids[i] = i;
     }
+    int nextRoundCount = knockout.playRound(ids, numTeams, (unsigned int)rand());
 
-    int nextRoundCount = 0;
-    while (!queue.isEmpty()) {
-        if (queue.isEmpty()) break;
-        MatchTeam t1 = queue.dequeue();
-        if (queue.isEmpty()) {
-            teams[nextRoundCount++] = t1;
-            break;
-        }
-        MatchTeam t2 = queue.dequeue();
-        int winnerIndex = randomWinner(0, 1);
-        MatchTeam winner = (winnerIndex == 0) ? t1 : t2;
-        printMatch(t1, t2, winner);
-        teams[nextRoundCount++] = winner;
+    for (int i = 0; i < numTeams / 2; i++) {
+        printMatch(entrants[2 * i], entrants[2 * i + 1], entrants[ids[i]]);
+    }
+    for (int i = 0; i < nextRoundCount; i++) {
+        teams[i] = entrants[ids[i]];
     }
     numTeams = nextRoundCount;
 }
 
-static void shuffleTeams(MatchTeam arr[], int size) {
-    for (int i = size - 1; i > 0; --i) {
-        int j = rand() % (i + 1);
-        MatchTeam temp = arr[i];
-        arr[i] = arr[j];
-        arr[j] = temp;
+// The opening knockout rounds pair neighbours, so every block of
+// teamCount / blocks consecutive teams (a power of two) sends one team on.
+// Seeds are snaked across the blocks tier by tier, and each block is laid
+// out with the standard table: the top `blocks` seeds head separate
+// blocks, and a block's top two can only meet in its last round.
+void MatchScheduler::seedOpeningRounds(int blocks) {
+    int blockSize = teamCount / blocks;
+    BracketSeeding section(blockSize);
+    MatchTeam seeded[MAX_TEAMS];
+    for (int b = 0; b < blocks; ++b) {
+        for (int p = 0; p < blockSize; ++p) {
+            int tier = section.getSeedAt(p);
+            int seed = tier * blocks + (tier % 2 == 0 ? b : blocks - 1 - b);
+            seeded[b * blockSize + p] = teams[seed];
+        }
+    }
+    for (int i = 0; i < blocks * blockSize; ++i) {
+        teams[i] = seeded[i];
     }
 }
 
 void MatchScheduler::groupStage(MatchTeam allTeams[12], MatchTeam finalists[6]) {
-    cout << "\n=== Group Stage ===\n";
+    APUEC_TRACE_SCOPE("MatchScheduler::groupStage");
+    *out << "\n=== Group Stage ===\n";
 
-    // Step 1: Load and shuffle using CircularQueue
-    CircularQueueMatch teamPool;
+    // Step 1: Snake-seed into 3 groups of 4. allTeams[b] won opening
+    // block b, which seed b heads (seedOpeningRounds), so it keeps seed b.
+    MatchTeam entrants[12];
     for (int i = 0; i < 12; ++i) {
-        teamPool.enqueue(allTeams[i]);
+        entrants[i] = allTeams[i];
+        entrants[i].points = 0;
     }
-
-    // Shuffle by rotating
-    for (int i = 0; i < 24; ++i) {
-        int rotateTimes = rand() % 12;
-        for (int j = 0; j < rotateTimes; ++j) {
-            MatchTeam temp = teamPool.dequeue();
-            teamPool.enqueue(temp);
+    GroupStage stage(12, 3, GROUP_ROUND_ROBIN);
+
+    // Step 2: Display teams in each group
+    for (int g = 0; g < stage.getGroupCount(); ++g) {
+        *out << "\nGroup " << (g + 1) << ":\n";
+        const int* members = stage.getGroupMembers(g);
+        for (int i = 0; i < stage.getGroupSize(g); ++i) {
+            *out << "  - " << entrants[members[i]].name << "\n";
         }
     }
 
-    // Step 2: Distribute into 3 groups
-    MatchTeam groupTeams[3][4];
-    for (int g = 0; g < 3; ++g) {
-        for (int i = 0; i < 4; ++i) {
-            MatchTeam t = teamPool.dequeue();
-            t.points = 0;
-            groupTeams[g][i] = t;
-        }
-    }
-
-    // Step 3: Display teams in each group
-    for (int g = 0; g < 3; ++g) {
-        cout << "\nGroup " << (g + 1) << ":\n";
-        for (int i = 0; i < 4; ++i) {
-            cout << "  - " << groupTeams[g][i].name << "\n";
+    // Step 3: Round robin, every pair once (3 rounds, 6 matches per group)
+    vector<GroupFixture> fixtures;
+    while (stage.nextRound(fixtures)) {
+        *out << "\n-- Group Round " << stage.getRoundsPlayed() << " --\n";
+        for (size_t i = 0; i < fixtures.size(); ++i) {
+            const GroupFixture& fixture = fixtures[i];
+            int winner = randomWinner(fixture.teamA, fixture.teamB);
+            printMatch(entrants[fixture.teamA], entrants[fixture.teamB], entrants[winner]);
+            stage.recordResult(fixture, winner);
         }
     }
 
+    // Step 4: Standings; the top 2 of each group advance
+    vector<int> ranked;
     int finalistIndex = 0;
-
-    // Step 4: Simulate matches group by group
-    for (int g = 0; g < 3; ++g) {
-        cout << "\n-- Group " << (g + 1) << " Matches --\n";
-
-        bool advanced[4] = {false, false, false, false};
-        int qualifiedCount = 0;
-
-        while (qualifiedCount < 2) {
-            for (int i = 0; i < 3; ++i) {
-                for (int j = i + 1; j < 4; ++j) {
-                    if (advanced[i] || advanced[j]) continue;
-
-                    MatchTeam& teamA = groupTeams[g][i];
-                    MatchTeam& teamB = groupTeams[g][j];
-                    int winnerIdx = randomWinner(0, 1);
-                    MatchTeam& winner = (winnerIdx == 0) ? teamA : teamB;
-
-                    printMatch(teamA, teamB, winner);
-                    winner.points++;
-
-                    if (winner.points == 3 && !advanced[&winner - groupTeams[g]]) {
-                        advanced[&winner - groupTeams[g]] = true;
-                        finalists[finalistIndex++] = winner;
-                        cout << " >> " << winner.name << " advances with 3 points!\n";
-                        qualifiedCount++;
-                        if (qualifiedCount == 2) break;
-                    }
-                }
-                if (qualifiedCount == 2) break;
+    for (int g = 0; g < stage.getGroupCount(); ++g) {
+        *out << "\n-- Group " << (g + 1) << " Standings --\n";
+        stage.rankGroup(g, ranked);
+        for (size_t i = 0; i < ranked.size(); ++i) {
+            int team = ranked[i];
+            entrants[team].points = stage.getPoints(team);
+            *out << (i + 1) << ". " << entrants[team].name << " - " << stage.getPoints(team)
+                 << " pts (W" << stage.getWins(team) << " L" << stage.getLosses(team)
+                 << ", SB " << stage.getSonnebornBerger(team) << ")";
+            if (i < 2) {
+                finalists[finalistIndex++] = entrants[team];
+                *out << " >> advances";
             }
+            *out << "\n";
         }
     }
 
     // Step 5: Finalist summary
-    cout << "\n=== Finalists advancing to Knockout Stage ===\n";
+    *out << "\n=== Finalists advancing to Knockout Stage ===\n";
     for (int i = 0; i < 6; ++i) {
-        cout << (i + 1) << ". " << finalists[i].name << " (Points: " << finalists[i].points << ")\n";
+        *out << (i + 1) << ". " << finalists[i].name << " (Points: " << finalists[i].points << ")\n";
+    }
+}
+
+
+bool MatchScheduler::runSwissQualifier(const char* filename, int rounds, int qualifierCount) {
+    APUEC_TRACE_SCOPE("MatchScheduler::runSwissQualifier");
+    if (!resultFile.is_open()) {
+        *out << "Match log is closed; the qualifier must run before the tournament.\n";
+        return false;
+    }
+    vector<MatchTeam> entrants;
+    if (!readEntrants(filename, entrants)) {
+        return false;
+    }
+    if (entrants.size() < 2) {
+        *out << "Not enough teams in " << filename << " for a Swiss qualifier\n";
+        return false;
+    }
+
+    int fieldSize = (int)entrants.size();
+    *out << "\n=== Swiss Qualifier: " << fieldSize << " Teams, " << rounds << " Rounds ===\n";
+    matchesPlayed = 0;
+    qualifiers.clear();
+    GroupStage stage(fieldSize, 1, GROUP_SWISS, rounds);
+
+    // Large rounds get a one-line summary instead of a line per match
+    const size_t MAX_COMMENTARY_MATCHES = 64;
+    vector<GroupFixture> fixtures;
+    while (stage.nextRound(fixtures)) {
+        bool commentary = fixtures.size() <= MAX_COMMENTARY_MATCHES;
+        *out << "\n-- Swiss Round " << stage.getRoundsPlayed() << " --\n";
+        for (size_t i = 0; i < fixtures.size(); ++i) {
+            const GroupFixture& fixture = fixtures[i];
+            if (fixture.teamB < 0) {
+                if (commentary) *out << ">> " << entrants[fixture.teamA].name << " gets a BYE\n";
+                continue;
+            }
+            int winner = randomWinner(fixture.teamA, fixture.teamB);
+            if (commentary) {
+                printMatch(entrants[fixture.teamA], entrants[fixture.teamB], entrants[winner]);
+            } else {
+                playMatch(entrants[fixture.teamA].name, entrants[fixture.teamB].name, entrants[winner].name);
+            }
+            stage.recordResult(fixture, winner);
+        }
+        if (!commentary) {
+            *out << fixtures.size() << " pairings played\n";
+        }
+    }
+    flushLog();
+
+    vector<int> ranked;
+    stage.rankGroup(0, ranked);
+    int take = qualifierCount < fieldSize ? qualifierCount : fieldSize;
+    *out << "\n=== Qualified (" << take << " of " << fieldSize << ", " << stage.getRematches()
+         << " rematches) ===\n";
+    for (int i = 0; i < take; ++i) {
+        int team = ranked[i];
+        qualifiers.push_back(entrants[team].name);
+        *out << (i + 1) << ". " << entrants[team].name << " - " << stage.getPoints(team)
+             << " pts (Buchholz " << stage.getBuchholz(team) << ")\n";
     }
+    return true;
 }
 
 
@@ -194,79 +349,354 @@ int MatchScheduler::findTeamIndex(MatchTeam arr[], int size, const char* name) {
 }
 
 void MatchScheduler::knockoutStage(MatchTeam finalists[6], int size) {
-    cout << "\n=== Knockout Stage ===\n";
+    APUEC_TRACE_SCOPE("MatchScheduler::knockoutStage");
+    *out << "\n=== Knockout Stage ===\n";
+
+    // Step 1: Seed group winners ahead of runners-up, each by points
+    // (finalists hold winner, runner-up per group). The two best winners
+    // get the byes and can only meet in the final.
+    int bySeed[6];
+    int seeds = 0;
+    for (int place = 0; place < 2; ++place) {
+        int first = seeds;
+        for (int i = place; i < size; i += 2) {
+            int j = seeds++;
+            while (j > first && finalists[bySeed[j - 1]].points < finalists[i].points) {
+                bySeed[j] = bySeed[j - 1];
+                --j;
+            }
+            bySeed[j] = i;
+        }
+    }
 
-    // Step 1: Load finalists into CircularQueue and shuffle
-    CircularQueueMatch teamQueue;
-    for (int i = 0; i < size; ++i) {
-        teamQueue.enqueue(finalists[i]);
+    Bracket bracket(size, BRACKET_SINGLE_ELIMINATION);
+    BracketSeeding seeding(size);
+    int placement[8];
+    seeding.place(placement, bySeed);
+    bracket.start(placement);
+
+    // Step 2: Quarterfinals (with byes), semifinals and final in order
+    static const char* const ROUND_NAMES[] = { "Quarterfinals", "Semifinals", "Final" };
+    int headingRound = -1;
+    for (int i = 0; i < bracket.getNodeCount(); ++i) {
+        int round = bracket.getNode(i).round;
+        if (round != headingRound) {
+            *out << "\n-- " << ROUND_NAMES[round + 3 - bracket.getUpperRounds()] << " --\n";
+            headingRound = round;
+        }
+        if (bracket.isBye(i)) {
+            *out << ">> " << finalists[bracket.getWinner(i)].name << " gets a BYE to the Semifinals!\n";
+            continue;
+        }
+        int winnerSlot = randomWinner(0, 1);
+        const MatchTeam& t1 = finalists[bracket.getTeam(i, 0)];
+        const MatchTeam& t2 = finalists[bracket.getTeam(i, 1)];
+        printMatch(t1, t2, winnerSlot == 0 ? t1 : t2);
+        bracket.setWinner(i, winnerSlot);
     }
 
-    // Shuffle: dequeue-rotate-enqueue
-    for (int i = 0; i < 12; ++i) {
-        int r = rand() % size;
-        for (int j = 0; j < r; ++j) {
-            MatchTeam t = teamQueue.dequeue();
-            teamQueue.enqueue(t);
+    champion = finalists[bracket.getChampion()];
+    *out << "\n=== TOURNAMENT WINNER: " << champion.name << " ===\n";
+}
+
+void MatchScheduler::doubleElimination() {
+    APUEC_TRACE_SCOPE("MatchScheduler::doubleElimination");
+    Bracket bracket(teamCount, BRACKET_DOUBLE_ELIMINATION, bracketReset);
+    bracket.start();
+
+    // Nodes are in playing order; a round heading is printed before its
+    // first match or bye, so an unplayed reset prints nothing
+    int headingNode = -1;
+    for (int i = 0; i < bracket.getNodeCount(); ++i) {
+        const BracketNode& node = bracket.getNode(i);
+        bool played = bracket.isReady(i);
+        bool bye = bracket.isBye(i) && bracket.getWinner(i) >= 0;
+        if (!played && !bye) continue;
+
+        if (headingNode < 0 || bracket.getNode(headingNode).side != node.side ||
+            bracket.getNode(headingNode).round != node.round) {
+            *out << "\n=== " << bracket.getRoundName(i) << " ===\n";
+            headingNode = i;
+        }
+
+        if (bye) {
+            *out << ">> " << teams[bracket.getWinner(i)].name << " gets a BYE\n";
+            continue;
+        }
+        int winnerSlot = randomWinner(0, 1);
+        const MatchTeam& t1 = teams[bracket.getTeam(i, 0)];
+        const MatchTeam& t2 = teams[bracket.getTeam(i, 1)];
+        printMatch(t1, t2, winnerSlot == 0 ? t1 : t2);
+        bracket.setWinner(i, winnerSlot);
+        if (node.side == SIDE_UPPER) {
+            *out << " >> " << teams[bracket.getLoser(i)].name << " drops to the Lower Bracket\n";
         }
     }
 
-    // Step 2: Quarterfinals - 3 matches
-    QueueMatch quarterWinners;
-    for (int i = 0; i < 3; ++i) {
-        MatchTeam t1 = teamQueue.dequeue();
-        MatchTeam t2 = teamQueue.dequeue();
-        int winnerIndex = randomWinner(0, 1);
-        MatchTeam winner = (winnerIndex == 0) ? t1 : t2;
-        printMatch(t1, t2, winner);
-        quarterWinners.enqueue(winner);
+    champion = teams[bracket.getChampion()];
+    *out << "\n=== TOURNAMENT WINNER: " << champion.name << " ===\n";
+}
+
+void MatchScheduler::announceReady(const vector<LiveMatch>& matches) {
+    for (size_t i = 0; i < matches.size(); ++i) {
+        const LiveMatch& match = matches[i];
+        *out << "Ready #" << match.id << " (" << match.round << "): [" << match.teamA << "] VS ["
+             << match.teamB << "]\n";
+        if (changes) changes->onChange(MATCH_READY, match.teamA, match.teamB);
     }
+}
 
-    // Step 3: Semifinal - 1 match + 1 bye
-    MatchTeam semi1 = quarterWinners.dequeue();
-    MatchTeam semi2 = quarterWinners.dequeue();
-    MatchTeam byeTeam = quarterWinners.dequeue();  // gets auto pass to final
+bool MatchScheduler::startLiveTournament(const char* filename, BracketFormat bracketFormat, bool reset,
+                                         vector<LiveMatch>& ready) {
+    APUEC_TRACE_SCOPE("MatchScheduler::startLiveTournament");
+    ready.clear();
+    if (!resultFile.is_open()) {
+        *out << "Match log is closed; a tournament has already finished.\n";
+        return false;
+    }
+    readTeams(filename);
+    if (teamCount == 0) {
+        *out << "No teams available to start tournament.\n";
+        return false;
+    }
 
-    MatchTeam finalist1;
-    int semifinalWinner = randomWinner(0, 1);
-    finalist1 = (semifinalWinner == 0) ? semi1 : semi2;
-    printMatch(semi1, semi2, finalist1);
+    vector<string> names;
+    for (int i = 0; i < teamCount; ++i) {
+        names.push_back(teams[i].name);
+    }
+    delete whatIfEngine;
+    delete outcomes;
+    delete matchDay;
+    delete live;
+    live = new LiveBracket(names, bracketFormat, reset);
+    matchDay = new MatchDayPlanner(live->getBracket(), dayStations, dayMatchMinutes, dayRestMinutes);
+    outcomes = new OutcomeModel(teamCount);
+    whatIfEngine = new WhatIfEngine(live->getBracket(), *outcomes);
+
+    matchesPlayed = 0;
+    champion.name[0] = '\0';
+    if (changes) changes->onChange(TOURNAMENT_STARTED, filename, "");
+    *out << "\n=== Live Tournament: " << teamCount << " Teams ===\n";
+    live->start(ready);
+    announceReady(ready);
+    return true;
+}
 
-    cout << ">> " << byeTeam.name << " gets a BYE to the Final!\n";
+bool MatchScheduler::reportResult(const string& winner, const string& loser, vector<LiveMatch>& nowReady,
+                                  string& error, int minute) {
+    APUEC_TRACE_SCOPE("MatchScheduler::reportResult");
+    nowReady.clear();
+    if (!isLive()) {
+        error = "No live tournament is running";
+        return false;
+    }
+    LiveMatch played;
+    if (!live->report(winner, loser, played, nowReady, error)) {
+        return false;
+    }
 
-    // Step 4: Final
-    MatchTeam champion;
-    int finalWinner = randomWinner(0, 1);
-    champion = (finalWinner == 0) ? finalist1 : byeTeam;
-    printMatch(finalist1, byeTeam, champion);
+    matchDay->finishMatch(played.id, minute);
+    printMatch(played.teamA.c_str(), played.teamB.c_str(), winner.c_str());
+    flushLog();
+    announceReady(nowReady);
+
+    if (live->isFinished()) {
+        strncpy(champion.name, live->getChampion().c_str(), sizeof(champion.name) - 1);
+        champion.name[sizeof(champion.name) - 1] = '\0';
+        *out << "\n=== TOURNAMENT WINNER: " << champion.name << " ===\n";
+        closeLog();
+        if (changes) changes->onChange(TOURNAMENT_FINISHED, champion.name, "");
+    }
+    return true;
+}
 
-    cout << "\n=== TOURNAMENT WINNER: " << champion.name << " ===\n";
+void MatchScheduler::getReadyMatches(vector<LiveMatch>& matches) const {
+    matches.clear();
+    if (isLive()) {
+        live->getReadyMatches(matches);
+    }
 }
 
+bool MatchScheduler::setMatchDay(int stations, int matchMinutes, int restMinutes) {
+    if (stations < 1 || matchMinutes < 1 || restMinutes < 0) {
+        return false;
+    }
+    dayStations = stations;
+    dayMatchMinutes = matchMinutes;
+    dayRestMinutes = restMinutes;
+    if (live != nullptr) {
+        delete matchDay;
+        matchDay = new MatchDayPlanner(live->getBracket(), dayStations, dayMatchMinutes, dayRestMinutes);
+    }
+    return true;
+}
 
-void MatchScheduler::startTournament(const char* filename) {
-    readTeams(filename);
-    if (teamCount == 0) {
-        cout << "No teams available to start tournament.\n";
-        return;
+bool MatchScheduler::beginMatch(int id, int station, int minute, string& error) {
+    if (!isLive()) {
+        error = "No live tournament is running";
+        return false;
+    }
+    const Bracket& bracket = live->getBracket();
+    if (id < 0 || id >= bracket.getNodeCount() || !bracket.isReady(id)) {
+        error = "Match #" + to_string(id) + " is not ready";
+        return false;
+    }
+    if (station < 0 || station >= dayStations) {
+        error = "No station " + to_string(station);
+        return false;
+    }
+    if (!matchDay->startMatch(id, station, minute)) {
+        error = "Match #" + to_string(id) + " cannot start on station " + to_string(station) +
+                " (already started, station busy or bad minute)";
+        return false;
     }
+    LiveMatch match = live->describe(id);
+    *out << "Station " << station << " at minute " << minute << ": [" << match.teamA << "] VS ["
+         << match.teamB << "]\n";
+    return true;
+}
 
-    int currentTeams = 96;
-    knockoutRound(currentTeams);
-    knockoutRound(currentTeams);
-    knockoutRound(currentTeams);
+bool MatchScheduler::setRating(const string& team, double rating, string& error) {
+    if (live == nullptr) {
+        error = "No live tournament is running";
+        return false;
+    }
+    int entrant = live->findEntrant(team);
+    if (entrant < 0) {
+        error = "Unknown team: " + team;
+        return false;
+    }
+    outcomes->setRating(entrant, rating);
+    return true;
+}
 
-    // Prepare teams for group stage
-    MatchTeam groupTeams[12];
-    for (int i = 0; i < 12; ++i) {
-        groupTeams[i] = teams[i];
+bool MatchScheduler::whatIf(const string& team, const vector<pair<string, string> >& assumptions,
+                            vector<RoundChance>& chances, string& error) {
+    APUEC_TRACE_SCOPE("MatchScheduler::whatIf");
+    chances.clear();
+    if (live == nullptr) {
+        error = "No live tournament is running";
+        return false;
+    }
+    int entrant = live->findEntrant(team);
+    if (entrant < 0) {
+        error = "Unknown team: " + team;
+        return false;
+    }
+    // In double elimination only upper bracket chances are exact; a team
+    // that dropped out of it may still be playing, so its zeros would mislead
+    bool upperOnly = live->getBracket().getFormat() != BRACKET_SINGLE_ELIMINATION;
+    if (upperOnly && !whatIfEngine->inUpperBracket(entrant)) {
+        error = team + " is out of the upper bracket; what-if only covers the upper bracket in double elimination";
+        return false;
     }
 
-    MatchTeam finalists[6];
-    groupStage(groupTeams, finalists);
-    knockoutStage(finalists, 6);
+    whatIfEngine->clearFixes();
+    for (size_t i = 0; i < assumptions.size(); ++i) {
+        int winner = live->findEntrant(assumptions[i].first);
+        int loser = assumptions[i].second.empty() ? -1 : live->findEntrant(assumptions[i].second);
+        if (winner < 0 || (loser < 0 && !assumptions[i].second.empty())) {
+            error = "Unknown team: " + (winner < 0 ? assumptions[i].first : assumptions[i].second);
+            return false;
+        }
+        if (upperOnly && (!whatIfEngine->inUpperBracket(winner) ||
+                          (loser >= 0 && !whatIfEngine->inUpperBracket(loser)))) {
+            error = assumptions[i].first + (loser < 0 ? "'s next match" : " vs " + assumptions[i].second) +
+                    " is not in the upper bracket; what-if only covers the upper bracket in double elimination";
+            return false;
+        }
+        bool ok = (loser < 0) ? whatIfEngine->fixNext(winner) : whatIfEngine->fix(winner, loser);
+        if (!ok && upperOnly && loser < 0) {
+            error = assumptions[i].first + "'s next match is the grand final; what-if only covers the upper bracket in double elimination";
+            return false;
+        }
+        if (!ok) {
+            error = assumptions[i].first + (loser < 0 ? " has no upper bracket match left" :
+                    " cannot beat " + assumptions[i].second + " given the other results");
+            return false;
+        }
+    }
+    if (!whatIfEngine->evaluate()) {
+        error = "The assumed results cannot all happen";
+        return false;
+    }
 
-    if (resultFile.is_open()) {
-        resultFile.close();
+    const Bracket& bracket = live->getBracket();
+    int rounds = whatIfEngine->getRounds();
+    for (int round = 1; round <= rounds; ++round) {
+        RoundChance chance;
+        if (round < rounds) {
+            chance.round = bracket.getRoundName(whatIfEngine->getUpperNode(round, 0));
+        } else {
+            chance.round = bracket.getFormat() == BRACKET_SINGLE_ELIMINATION ? "Champion" : "Upper Bracket winner";
+        }
+        chance.probability = whatIfEngine->getReachProbability(entrant, round);
+        chances.push_back(chance);
+    }
+    return true;
+}
+
+bool MatchScheduler::planMatchDay(int now, vector<ScheduledMatch>& plan, int& finish) {
+    APUEC_TRACE_SCOPE("MatchScheduler::planMatchDay");
+    plan.clear();
+    finish = now;
+    if (!isLive()) {
+        return false;
+    }
+    matchDay->plan(now);
+    const vector<PlannedMatch>& planned = matchDay->getPlan();
+    plan.reserve(planned.size());
+    for (size_t i = 0; i < planned.size(); ++i) {
+        ScheduledMatch scheduled;
+        scheduled.match = live->describe(planned[i].node);
+        scheduled.station = planned[i].station;
+        scheduled.start = planned[i].start;
+        scheduled.end = planned[i].end;
+        scheduled.started = planned[i].started;
+        plan.push_back(scheduled);
     }
+    finish = matchDay->getProjectedFinish();
+    return true;
+}
+
+
+bool MatchScheduler::startTournament(const char* filename) {
+    APUEC_TRACE_SCOPE("MatchScheduler::startTournament");
+    if (isLive()) {
+        *out << "A live tournament is in progress.\n";
+        return false;
+    }
+    readTeams(filename);
+    if (teamCount == 0) {
+        *out << "No teams available to start tournament.\n";
+        return false;
+    }
+
+    matchesPlayed = 0;
+    champion.name[0] = '\0';
+    if (changes) changes->onChange(TOURNAMENT_STARTED, filename, "");
+
+    if (format == FORMAT_DOUBLE_ELIMINATION) {
+        doubleElimination();
+    } else {
+        int currentTeams = 96;
+        seedOpeningRounds(12);
+        knockoutRound(currentTeams);
+        knockoutRound(currentTeams);
+        knockoutRound(currentTeams);
+
+        // Prepare teams for group stage
+        MatchTeam groupTeams[12];
+        for (int i = 0; i < 12; ++i) {
+            groupTeams[i] = teams[i];
+        }
+
+        MatchTeam finalists[6];
+        groupStage(groupTeams, finalists);
+        knockoutStage(finalists, 6);
+    }
+
+    closeLog();
+    if (changes) changes->onChange(TOURNAMENT_FINISHED, champion.name, "");
+    return true;
 }
@@ -4,6 +4,14 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <string>
+#include <vector>
+#include "apuec_output.hpp"
+#include "apuec_events.hpp"
+#include "knockout_kernel.hpp"
+#include "live_bracket.hpp"
+#include "match_day.hpp"
+#include "what_if.hpp"
 using namespace std;
 
 const int MAX_TEAMS = 128;
@@ -152,25 +160,141 @@ class CircularQueueMatch {
         }
     };
 
+// How startTournament plays the selected teams
+enum TournamentFormat {
+    FORMAT_GROUP_STAGE = 0,         // Knockout to 12, round-robin groups, knockout of the final six
+    FORMAT_DOUBLE_ELIMINATION = 1   // One upper/lower bracket over all selected teams
+};
+
+// One result.csv row
+struct MatchLogEntry {
+    string teamA;
+    string teamB;
+    string winner;
+};
+
 // ================ MatchScheduler =================
+// One unfinished live match on the match-day plan
+struct ScheduledMatch {
+    LiveMatch match;        // Teams still to be decided are "TBD"
+    int station;
+    int start;              // Minutes from the start of the day
+    int end;
+    bool started;           // On its station now
+};
+
+// Probability of reaching one round, from a what-if query
+struct RoundChance {
+    string round;           // "Round 3", "Champion", ...
+    double probability;
+};
+
 class MatchScheduler {
 private:
     MatchTeam teams[MAX_TEAMS];
     int teamCount;
     ofstream resultFile;
+    ostream* out;           // Match commentary (never null)
+    ChangeListener* changes;    // Match results (may be null)
+    MatchTeam champion;     // Winner of the last completed tournament
+    int matchesPlayed;
+    TournamentFormat format;
+    bool bracketReset;      // Double elimination: replay the final if the lower bracket champion wins
+    long long logRows;      // result.csv rows written so far
+    long long logBytes;
+    long long logNanos;     // Time spent writing and closing result.csv
+
+    vector<string> qualifiers;  // Top of the last Swiss qualifier, best first
+    KnockoutKernel knockout;    // Single-threaded: opening rounds are at most MAX_TEAMS / 2 matches
+    LiveBracket* live;          // Tournament fed by reported results (nullptr = none)
+    MatchDayPlanner* matchDay;  // Stations and times for live, created with it
+    OutcomeModel* outcomes;     // Ratings of the live entrants, created with it
+    WhatIfEngine* whatIfEngine; // Over live and outcomes
+    int dayStations;
+    int dayMatchMinutes;
+    int dayRestMinutes;
 
     int randomWinner(int a, int b);
     void printMatch(const MatchTeam& t1, const MatchTeam& t2, const MatchTeam& winner);
+    void printMatch(const char* teamA, const char* teamB, const char* winner);
+    void playMatch(const char* teamA, const char* teamB, const char* winner);  // Log and publish, no commentary
+    void announceReady(const vector<LiveMatch>& matches);
+    void seedOpeningRounds(int blocks);
     void knockoutRound(int &numTeams);
     void groupStage(MatchTeam allTeams[12], MatchTeam finalists[6]);
     void knockoutStage(MatchTeam finalists[6], int size);
+    void doubleElimination();
     void logMatchResult(const char* teamA, const char* teamB, const char* winner);
+    void closeLog();        // Close result.csv, timed with the row writes
     void readTeams(const char* filename);
+    bool readEntrants(const char* filename, vector<MatchTeam>& entrants);
     int findTeamIndex(MatchTeam arr[], int size, const char* name);
 
+    // Disable copying (owns the live bracket and the engines over it)
+    MatchScheduler(const MatchScheduler&);
+    MatchScheduler& operator=(const MatchScheduler&);
+
 public:
-    MatchScheduler();
-    void startTournament(const char* filename);
+    MatchScheduler(ostream* output = &cout, ChangeListener* listener = nullptr);
+    ~MatchScheduler();
+    void setOutput(ostream* output) { out = outputOrDiscard(output); }   // nullptr = silent
+    void setListener(ChangeListener* listener) { changes = listener; }
+
+    void setFormat(TournamentFormat tournamentFormat, bool reset = true) {
+        format = tournamentFormat;
+        bracketReset = reset;
+    }
+    bool startTournament(const char* filename);     // False if the teams file is unusable
+    const char* getChampion() const { return champion.name; }
+    int getMatchesPlayed() const { return matchesPlayed; }
+    // Open qualifier: Swiss rounds over every team in filename (name,status
+    // lines, any number of teams, seeded by status), logged to result.csv
+    // like tournament matches. The top qualifierCount stay in
+    // getQualifiers(). False if the file has fewer than two teams or the
+    // log is already closed.
+    bool runSwissQualifier(const char* filename, int rounds, int qualifierCount);
+    const vector<string>& getQualifiers() const { return qualifiers; }
+    void flushLog();        // Push buffered result.csv rows to the file
+    long long getLogRows() const { return logRows; }
+    long long getLogBytes() const { return logBytes; }
+    long long getLogNanos() const { return logNanos; }
+    // Live tournament: the selected teams in a bracket that only advances
+    // on reported results. Each report is appended to result.csv and
+    // flushed at once, so the log holds every result reported so far.
+    // ready receives the first playable matches; false if the teams file
+    // is unusable or the log is already closed.
+    bool startLiveTournament(const char* filename, BracketFormat bracketFormat, bool reset,
+                             vector<LiveMatch>& ready);
+    // "winner beat loser"; nowReady receives the matches it made playable.
+    // minute (if >= 0) is when the match ended, for the match-day plan;
+    // without it a begun match is taken to have ended on schedule.
+    // The report of the deciding final finishes the tournament.
+    bool reportResult(const string& winner, const string& loser, vector<LiveMatch>& nowReady, string& error,
+                      int minute = -1);
+    bool isLive() const { return live != nullptr && !live->isFinished(); }
+    void getReadyMatches(vector<LiveMatch>& matches) const;
+    // Match day of the live tournament (default 4 stations, 30 minute
+    // matches, 10 minutes rest). Changing it restarts the planner, so
+    // matches already on a station must be begun again. False if a value
+    // is out of range.
+    bool setMatchDay(int stations, int matchMinutes, int restMinutes);
+    // Ready match id goes on station (0-based) at minute
+    bool beginMatch(int id, int station, int minute, string& error);
+    // Station and times for every unfinished match from minute now, in
+    // bracket order; finish receives the projected end of the last match
+    bool planMatchDay(int now, vector<ScheduledMatch>& plan, int& finish);
+    // Elo rating of a live team for what-if queries (all start at 1500,
+    // which is the simulator's coin flip)
+    bool setRating(const string& team, double rating, string& error);
+    // Exact chances of team reaching each later upper-bracket round, given
+    // the results so far and the assumed ones: (winner, loser) pairs, or
+    // (winner, "") for "winner wins its next match". See WhatIfEngine.
+    // In double elimination, teams and assumptions outside the upper
+    // bracket (lower bracket, grand final) are an error.
+    bool whatIf(const string& team, const vector<pair<string, string> >& assumptions,
+                vector<RoundChance>& chances, string& error);
+    // Replay a finished tournament (log and champion) without playing it
+    bool restoreTournament(const vector<MatchLogEntry>& matches, const char* championName);
 };
 
 #endif
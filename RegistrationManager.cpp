@@ -1,20 +1,79 @@
 #include "RegistrationManager.hpp"
+#include "apuec_trace.hpp"
+
+// Rebuild queue without teamName; false if it is not queued
+static bool removeTeam(TeamQueue& queue, const char* teamName, string& status) {
+    TeamQueue kept;
+    bool found = false;
+    for (int i = 0; i < queue.size(); i++) {
+        Team t = queue.peek(i);
+        if (!found && strcmp(t.name, teamName) == 0) {
+            found = true;
+            status = t.status;
+            continue;
+        }
+        kept.enqueue(t);
+    }
+    if (found) {
+        queue = kept;
+    }
+    return found;
+}
+
+// Rebuild queue with oldName renamed; false if it is not queued
+static bool renameTeam(TeamQueue& queue, const char* oldName, const char* newName) {
+    TeamQueue renamed;
+    bool found = false;
+    for (int i = 0; i < queue.size(); i++) {
+        Team t = queue.peek(i);
+        if (!found && strcmp(t.name, oldName) == 0) {
+            found = true;
+            strncpy(t.name, newName, 99);
+            t.name[99] = '\0';
+        }
+        renamed.enqueue(t);
+    }
+    if (found) {
+        queue = renamed;
+    }
+    return found;
+}
 
 void RegistrationManager::registerTeam() {
-    Team newTeam;
+    char teamName[100];
     int choice;
 
-    cout << "Enter Team Name: ";
+    *out << "Enter Team Name: ";
     cin.ignore();
-    cin.getline(newTeam.name, 100);
+    cin.getline(teamName, 100);
 
-    cout << "Select Registration Type:\n";
-    cout << "1. Normal\n";
-    cout << "2. Wild Card\n";
-    cout << "Choice: ";
+    *out << "Select Registration Type:\n";
+    *out << "1. Normal\n";
+    *out << "2. Wild Card\n";
+    *out << "Choice: ";
     cin >> choice;
 
-    if (choice == 1) {
+    if (choice != 1 && choice != 2) {
+        *out << "Invalid option.\n";
+        // Save state after each registration
+        saveToCSV("registration.csv");
+        return;
+    }
+
+    if (!addTeam(teamName, choice == 2)) {
+        *out << "Registration full.\n";
+    }
+}
+
+bool RegistrationManager::addTeam(const char* teamName, bool wildCard) {
+    Team newTeam;
+    strncpy(newTeam.name, teamName, 99);
+    newTeam.name[99] = '\0';
+
+    if (!wildCard) {
+        if (normalQueue.isFull()) {
+            return false;
+        }
         int currentNormal = normalQueue.size();
         if (currentNormal < 20) {
             strcpy(newTeam.status, "early bird");
@@ -22,82 +81,105 @@ void RegistrationManager::registerTeam() {
             strcpy(newTeam.status, "normal");
         }
         normalQueue.enqueue(newTeam);
-    } else if (choice == 2) {
+    } else {
+        if (wildCardQueue.isFull()) {
+            return false;
+        }
         strcpy(newTeam.status, "wild card");
         wildCardQueue.enqueue(newTeam);
-    } else {
-        cout << "Invalid option.\n";
     }
 
     // Save state after each registration
     saveToCSV("registration.csv");
+    if (changes) changes->onChange(TEAM_REGISTERED, newTeam.name, newTeam.status);
+    return true;
 }
 
 void RegistrationManager::saveToCSV(const char* filename) {
+    APUEC_TRACE_SCOPE("RegistrationManager::saveToCSV");
     ofstream file(filename);
 
     if (!file.is_open()) {
-        cout << "Failed to open file.\n";
+        *out << "Failed to open file.\n";
         return;
     }
 
+    vector<Team> teams;
+    copyTeams(teams);
+    writeTeams(file, teams);
+    file.close();
+}
+
+void RegistrationManager::copyTeams(vector<Team>& teams) const {
+    teams.clear();
+    teams.reserve(normalQueue.size() + wildCardQueue.size());
     for (int i = 0; i < normalQueue.size(); i++) {
-        Team t = normalQueue.peek(i);
-        file << t.name << "," << t.status << endl;
+        teams.push_back(normalQueue.peek(i));
     }
-
     for (int i = 0; i < wildCardQueue.size(); i++) {
-        Team t = wildCardQueue.peek(i);
-        file << t.name << "," << t.status << endl;
+        teams.push_back(wildCardQueue.peek(i));
     }
+}
 
-    file.close();
+bool RegistrationManager::restoreTeams(const vector<Team>& teams) {
+    TeamQueue normal;
+    TeamQueue wildCard;
+    for (size_t i = 0; i < teams.size(); i++) {
+        TeamQueue& queue = (strcmp(teams[i].status, "wild card") == 0) ? wildCard : normal;
+        if (queue.isFull()) {
+            return false;
+        }
+        queue.enqueue(teams[i]);
+    }
+
+    normalQueue = normal;
+    wildCardQueue = wildCard;
+    saveToCSV("registration.csv");
+    if (changes) {
+        for (size_t i = 0; i < teams.size(); i++) {
+            changes->onChange(TEAM_REGISTERED, teams[i].name, teams[i].status);
+        }
+    }
+    return true;
 }
 
-void RegistrationManager::endRegistration(const char* outputFilename) {
-    ifstream file("registration.csv");
-    if (!file.is_open()) {
-        cout << "Cannot open registration.csv\n";
-        return;
+void RegistrationManager::writeTeams(ostream& file, const vector<Team>& teams) {
+    for (size_t i = 0; i < teams.size(); i++) {
+        file << teams[i].name << "," << teams[i].status << "\n";
     }
+}
 
+bool RegistrationManager::endRegistration(const char* outputFilename) {
+    APUEC_TRACE_SCOPE("RegistrationManager::endRegistration");
+    // Select from the queues, which withdrawals and replacements edit;
+    // registration.csv only mirrors them
     TeamQueue earlyBirdQueue;
     TeamQueue normalStatusQueue;
     TeamQueue wildCardStatusQueue;
 
-    string line;
-    while (getline(file, line)) {
-        size_t comma = line.find(',');
-        if (comma == string::npos) continue;
-
-        string name = line.substr(0, comma);
-        string status = line.substr(comma + 1);
-
-        Team t;
-        strcpy(t.name, name.c_str());
-        strcpy(t.status, status.c_str());
-
-        if (status == "early bird") {
+    vector<Team> teams;
+    copyTeams(teams);
+    for (size_t i = 0; i < teams.size(); i++) {
+        const Team& t = teams[i];
+        if (strcmp(t.status, "early bird") == 0) {
             earlyBirdQueue.enqueue(t);
-        } else if (status == "normal") {
+        } else if (strcmp(t.status, "normal") == 0) {
             normalStatusQueue.enqueue(t);
-        } else if (status == "wild card") {
+        } else if (strcmp(t.status, "wild card") == 0) {
             wildCardStatusQueue.enqueue(t);
         }
     }
 
-    file.close();
-
     int total = earlyBirdQueue.size() + normalStatusQueue.size() + wildCardStatusQueue.size();
     if (total < 96) {
-        cout << "Cannot end registration: only " << total << " teams registered (need 96)\n";
-        return;
+        *out << "Cannot end registration: only " << total << " teams registered (need 96)\n";
+        return false;
     }
 
     ofstream outFile(outputFilename);
     if (!outFile.is_open()) {
-        cout << "Failed to write to " << outputFilename << endl;
-        return;
+        *out << "Failed to write to " << outputFilename << endl;
+        return false;
     }
 
     int count = 0;
@@ -118,98 +200,34 @@ void RegistrationManager::endRegistration(const char* outputFilename) {
     }
 
     outFile.close();
-    cout << "Successfully selected top 96 teams into " << outputFilename << endl;
+    *out << "Successfully selected top 96 teams into " << outputFilename << endl;
+    if (changes) changes->onChange(TEAMS_SELECTED, outputFilename, "");
+    return true;
 }
 
-void RegistrationManager::withdrawTeam(const char* teamName) {
-    ifstream file("registration.csv");
-    if (!file.is_open()) {
-        cout << "Cannot open registration.csv\n";
-        return;
+bool RegistrationManager::withdrawTeam(const char* teamName) {
+    // The queues are the registration; registration.csv mirrors them
+    string withdrawnStatus;
+    if (!removeTeam(normalQueue, teamName, withdrawnStatus) &&
+        !removeTeam(wildCardQueue, teamName, withdrawnStatus)) {
+        *out << "Team \"" << teamName << "\" not found.\n";
+        return false;
     }
 
-    TeamQueue tempQueue;
-    string line;
-    bool found = false;
-
-    while (getline(file, line)) {
-        size_t comma = line.find(',');
-        if (comma == string::npos) continue;
-
-        string name = line.substr(0, comma);
-        string status = line.substr(comma + 1);
-
-        if (name == teamName) {
-            found = true;
-            continue; // Skip adding this team to the new queue
-        }
-
-        Team t;
-        strcpy(t.name, name.c_str());
-        strcpy(t.status, status.c_str());
-        tempQueue.enqueue(t);
-    }
-
-    file.close();
-
-    if (!found) {
-        cout << "Team \"" << teamName << "\" not found.\n";
-        return;
-    }
-
-    ofstream outFile("registration.csv");
-    while (!tempQueue.isEmpty()) {
-        Team t = tempQueue.dequeue();
-        outFile << t.name << "," << t.status << endl;
-    }
-    outFile.close();
-
-    cout << "Team \"" << teamName << "\" successfully withdrawn.\n";
+    saveToCSV("registration.csv");
+    *out << "Team \"" << teamName << "\" successfully withdrawn.\n";
+    if (changes) changes->onChange(TEAM_WITHDRAWN, teamName, withdrawnStatus);
+    return true;
 }
 
-void RegistrationManager::replaceTeam(const char* oldName, const char* newName) {
-    ifstream file("registration.csv");
-    if (!file.is_open()) {
-        cout << "Cannot open registration.csv\n";
-        return;
+bool RegistrationManager::replaceTeam(const char* oldName, const char* newName) {
+    if (!renameTeam(normalQueue, oldName, newName) && !renameTeam(wildCardQueue, oldName, newName)) {
+        *out << "Team \"" << oldName << "\" not found.\n";
+        return false;
     }
 
-    TeamQueue tempQueue;
-    string line;
-    bool found = false;
-
-    while (getline(file, line)) {
-        size_t comma = line.find(',');
-        if (comma == string::npos) continue;
-
-        string name = line.substr(0, comma);
-        string status = line.substr(comma + 1);
-
-        Team t;
-        if (name == oldName) {
-            found = true;
-            strcpy(t.name, newName); // Replacing name
-        } else {
-            strcpy(t.name, name.c_str());
-        }
-
-        strcpy(t.status, status.c_str());
-        tempQueue.enqueue(t);
-    }
-
-    file.close();
-
-    if (!found) {
-        cout << "Team \"" << oldName << "\" not found.\n";
-        return;
-    }
-
-    ofstream outFile("registration.csv");
-    while (!tempQueue.isEmpty()) {
-        Team t = tempQueue.dequeue();
-        outFile << t.name << "," << t.status << endl;
-    }
-    outFile.close();
-
-    cout << "Team \"" << oldName << "\" successfully replaced by \"" << newName << "\".\n";
+    saveToCSV("registration.csv");
+    *out << "Team \"" << oldName << "\" successfully replaced by \"" << newName << "\".\n";
+    if (changes) changes->onChange(TEAM_RENAMED, oldName, newName);
+    return true;
 }
@@ -4,6 +4,9 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <vector>
+#include "apuec_output.hpp"
+#include "apuec_events.hpp"
 
 #define MAX_SIZE 200
 
@@ -218,13 +221,25 @@ class RegistrationManager {
 private:
     TeamQueue normalQueue;
     TeamQueue wildCardQueue;
+    ostream* out;   // Progress messages (never null)
+    ChangeListener* changes;    // Team deltas (may be null)
 
 public:
+    RegistrationManager(ostream* output = &cout, ChangeListener* listener = nullptr)
+        : out(outputOrDiscard(output)), changes(listener) {}
+    void setOutput(ostream* output) { out = outputOrDiscard(output); }   // nullptr = silent
+    void setListener(ChangeListener* listener) { changes = listener; }
+
     void registerTeam();
+    bool addTeam(const char* teamName, bool wildCard);
     void saveToCSV(const char* filename);
-    void endRegistration(const char* outputFilename);
-    void withdrawTeam(const char* teamName);
-    void replaceTeam(const char* oldName, const char* newName);
+    void copyTeams(vector<Team>& teams) const;      // Registration order, wild cards last
+    static void writeTeams(ostream& file, const vector<Team>& teams);   // registration.csv rows
+    bool restoreTeams(const vector<Team>& teams);   // Inverse of copyTeams, false if they do not fit
+    bool endRegistration(const char* outputFilename);
+    bool withdrawTeam(const char* teamName);
+    bool replaceTeam(const char* oldName, const char* newName);
+    int getTeamCount() const { return normalQueue.size() + wildCardQueue.size(); }
 
 };
 
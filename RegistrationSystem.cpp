@@ -1,4 +1,5 @@
 #include "RegistrationSystem.hpp"
+#include "apuec_trace.hpp"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -6,7 +7,8 @@
 using namespace std;
 
 // Constructor
-RegistrationSystem::RegistrationSystem() {
+RegistrationSystem::RegistrationSystem(ostream* output, ChangeListener* listener)
+    : out(outputOrDiscard(output)), changes(listener) {
     earlyFront = 0;
     earlyRear = -1;
     earlyCount = 0;
@@ -27,29 +29,17 @@ RegistrationSystem::RegistrationSystem() {
 
 // Load players from CSV file
 bool RegistrationSystem::loadFromCSV(const string& filename) {
+    APUEC_TRACE_SCOPE("RegistrationSystem::loadFromCSV");
     ifstream file(filename);
     if (!file.is_open()) {
-        cout << "CSV file not found: " << filename << "\n";
+        *out << "CSV file not found: " << filename << "\n";
         
         return false;
     }
 
 
 
-    
-    earlyFront = 0;
-    earlyRear = -1;
-    earlyCount = 0;
-
-    normalFront = 0;
-    normalRear = -1;
-    normalCount = 0;
-
-    repFront = 0;
-    repRear = -1;
-    repCount = 0;
-
-    wildcardTop = -1;
+    clearPlayers(filename);
 
     string line;
     bool headerSkipped = false;
@@ -74,61 +64,117 @@ bool RegistrationSystem::loadFromCSV(const string& filename) {
         player.isEarlyBird = (isEarlyStr == "1");
         player.isWildcard = (isWildcardStr == "1");
         player.isCheckedIn = (isCheckedInStr == "1");
-
-        if (player.isWildcard) {
-            pushWildcard(player);
-        } else if (player.isEarlyBird) {
-            enqueue(earlyBirdQueue, earlyFront, earlyRear, earlyCount, player);
-        } else {
-            enqueue(normalQueue, normalFront, normalRear, normalCount, player);
-        }
+        restorePlayer(player);
     }
 
     file.close();
-    cout << "Loaded players from CSV: " << filename << "\n";
+    *out << "Loaded players from CSV: " << filename << "\n";
     return true;
 }
 
+// Replace the roster with players in copyPlayers() order and rewrite players.csv
+void RegistrationSystem::restorePlayers(const vector<Player>& players, const string& source) {
+    clearPlayers(source);
+    for (size_t i = 0; i < players.size(); i++) {
+        restorePlayer(players[i]);
+    }
+    saveToCSV("players.csv");
+}
+
+void RegistrationSystem::clearPlayers(const string& source) {
+    earlyFront = 0;
+    earlyRear = -1;
+    earlyCount = 0;
+
+    normalFront = 0;
+    normalRear = -1;
+    normalCount = 0;
+
+    repFront = 0;
+    repRear = -1;
+    repCount = 0;
+
+    wildcardTop = -1;
+    if (changes) changes->onChange(PLAYERS_CLEARED, source, "");
+}
+
+// Place a saved player by its flags, as the CSV load does
+void RegistrationSystem::restorePlayer(const Player& player) {
+    if (player.isWildcard) {
+        pushWildcard(player);
+        if (changes) changes->onChange(WILDCARD_ADDED, player.playerID, player.name);
+        return;
+    }
+    if (player.isEarlyBird) {
+        enqueue(earlyBirdQueue, earlyFront, earlyRear, earlyCount, player);
+    } else {
+        enqueue(normalQueue, normalFront, normalRear, normalCount, player);
+    }
+    if (changes) {
+        changes->onChange(PLAYER_REGISTERED, player.playerID, player.name);
+        if (player.isCheckedIn) changes->onChange(PLAYER_CHECKED_IN, player.playerID, "");
+    }
+}
+
 // Save all players to CSV file
 bool RegistrationSystem::saveToCSV(const string& filename) const {
+    APUEC_TRACE_SCOPE("RegistrationSystem::saveToCSV");
     ofstream file(filename);
     if (!file.is_open()) {
-        cout << "Could not open CSV file for writing: " << filename << "\n";
+        *out << "Could not open CSV file for writing: " << filename << "\n";
         return false;
     }
 
-    // Write header
-    file << "Name,PlayerID,IsEarlyBird,IsWildcard,IsCheckedIn\n";
+    vector<Player> players;
+    copyPlayers(players);
+    writeCSV(file, players);
+
+    file.close();
+    *out << "Saved players to CSV: " << filename << "\n";
+    return true;
+}
+
+// Flags follow the container a player is in, as saveToCSV has always written them
+void RegistrationSystem::copyPlayers(vector<Player>& players) const {
+    players.clear();
+    players.reserve(earlyCount + normalCount + wildcardTop + 1);
 
     // Early-bird queue
     for (int i = 0, idx = earlyFront; i < earlyCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
-        const Player& p = earlyBirdQueue[idx];
-        file << p.name << "," << p.playerID << ",1,0," << (p.isCheckedIn ? "1" : "0") << "\n";
+        players.push_back(earlyBirdQueue[idx]);
+        players.back().isEarlyBird = true;
+        players.back().isWildcard = false;
     }
 
     // Normal queue
     for (int i = 0, idx = normalFront; i < normalCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
-        const Player& p = normalQueue[idx];
-        file << p.name << "," << p.playerID << ",0,0," << (p.isCheckedIn ? "1" : "0") << "\n";
+        players.push_back(normalQueue[idx]);
+        players.back().isEarlyBird = false;
+        players.back().isWildcard = false;
     }
 
     // Wildcard stack
     for (int i = 0; i <= wildcardTop; ++i) {
-        const Player& p = wildcardStack[i];
-        file << p.name << "," << p.playerID << ",0,1,0\n"; 
+        players.push_back(wildcardStack[i]);
+        players.back().isEarlyBird = false;
+        players.back().isWildcard = true;
+        players.back().isCheckedIn = false;
     }
+}
 
-    
-
-    file.close();
-    cout << "Saved players to CSV: " << filename << "\n";
-    return true;
+void RegistrationSystem::writeCSV(ostream& file, const vector<Player>& players) {
+    file << "Name,PlayerID,IsEarlyBird,IsWildcard,IsCheckedIn\n";
+    for (size_t i = 0; i < players.size(); i++) {
+        const Player& p = players[i];
+        file << p.name << "," << p.playerID << "," << (p.isEarlyBird ? "1" : "0") << ","
+             << (p.isWildcard ? "1" : "0") << "," << (p.isCheckedIn ? "1" : "0") << "\n";
+    }
 }
 
 // Register a new player
 bool RegistrationSystem::registerPlayer(const string& name, const string& playerID, bool isEarlyBird) {
     if (name.empty() || playerID.empty()) {
-        cout << "Error: Name and ID cannot be empty.\n";
+        *out << "Error: Name and ID cannot be empty.\n";
         return false;
     }
 
@@ -141,22 +187,23 @@ bool RegistrationSystem::registerPlayer(const string& name, const string& player
 
     if (isEarlyBird) {
         if (earlyCount >= MAX_PLAYERS) {
-            cout << "Early-bird registration full.\n";
+            *out << "Early-bird registration full.\n";
             return false;
         }
         enqueue(earlyBirdQueue, earlyFront, earlyRear, earlyCount, newPlayer);
     } else {
         if (normalCount >= MAX_PLAYERS) {
-            cout << "Normal registration full.\n";
+            *out << "Normal registration full.\n";
             return false;
         }
         enqueue(normalQueue, normalFront, normalRear, normalCount, newPlayer);
     }
 
-    cout << "Registered: " << name << " (ID: " << playerID << ") as " 
+    *out << "Registered: " << name << " (ID: " << playerID << ") as " 
               << (isEarlyBird ? "Early-bird" : "Normal") << "\n";
 
     saveToCSV("players.csv");
+    if (changes) changes->onChange(PLAYER_REGISTERED, playerID, name);
 
     return true;
 }
@@ -164,7 +211,7 @@ bool RegistrationSystem::registerPlayer(const string& name, const string& player
 // Add a wildcard entry
 bool RegistrationSystem::addWildcardEntry(const string& name, const string& playerID) {
     if (wildcardTop + 1 >= MAX_PLAYERS) {
-        cout << "Wildcard stack full.\n";
+        *out << "Wildcard stack full.\n";
         return false;
     }
 
@@ -177,38 +224,54 @@ bool RegistrationSystem::addWildcardEntry(const string& name, const string& play
 
     pushWildcard(newPlayer);
 
-    cout << "Wildcard added: " << name << " (ID: " << playerID << ")\n";
+    *out << "Wildcard added: " << name << " (ID: " << playerID << ")\n";
 
     saveToCSV("players.csv");
+    if (changes) changes->onChange(WILDCARD_ADDED, playerID, name);
 
     return true;
 }
 
 // Check in a player
-void RegistrationSystem::checkInPlayer(const string& playerID) {
+bool RegistrationSystem::checkInPlayer(const string& playerID) {
     int index;
 
     // Early-bird
     index = findPlayerInQueue(earlyBirdQueue, earlyFront, earlyRear, earlyCount, playerID);
     if (index != -1) {
+        if (changes && !earlyBirdQueue[index].isCheckedIn) changes->onChange(PLAYER_CHECKED_IN, playerID, "");
         earlyBirdQueue[index].isCheckedIn = true;
-        cout << "Checked in (Early-bird): " << earlyBirdQueue[index].name << "\n";
+        *out << "Checked in (Early-bird): " << earlyBirdQueue[index].name << "\n";
 
         saveToCSV("players.csv");
-        return;
+        return true;
     }
 
     // Normal
     index = findPlayerInQueue(normalQueue, normalFront, normalRear, normalCount, playerID);
     if (index != -1) {
+        if (changes && !normalQueue[index].isCheckedIn) changes->onChange(PLAYER_CHECKED_IN, playerID, "");
         normalQueue[index].isCheckedIn = true;
-        cout << "Checked in (Normal): " << normalQueue[index].name << "\n";
+        *out << "Checked in (Normal): " << normalQueue[index].name << "\n";
 
         saveToCSV("players.csv");
-        return;
+        return true;
     }
 
-    cout << "Player not found for check-in.\n";
+    *out << "Player not found for check-in.\n";
+    return false;
+}
+
+// Count checked-in players in both queues
+int RegistrationSystem::getCheckedInCount() const {
+    int checkedIn = 0;
+    for (int i = 0, idx = earlyFront; i < earlyCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
+        if (earlyBirdQueue[idx].isCheckedIn) checkedIn++;
+    }
+    for (int i = 0, idx = normalFront; i < normalCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
+        if (normalQueue[idx].isCheckedIn) checkedIn++;
+    }
+    return checkedIn;
 }
 
 // Withdraw a player
@@ -219,13 +282,13 @@ bool RegistrationSystem::withdrawPlayer(const string& playerID) {
     removed |= removeFromQueue(normalQueue, normalFront, normalRear, normalCount, playerID);
 
     if (removed) {
-        cout << "Player withdrawn: " << playerID << "\n";
+        *out << "Player withdrawn: " << playerID << "\n";
 
         replacePlayer();
 
         saveToCSV("players.csv");
     } else {
-        cout << "Player not found: " << playerID << "\n";
+        *out << "Player not found: " << playerID << "\n";
     }
 
     return removed;
@@ -236,33 +299,34 @@ bool RegistrationSystem::replacePlayer() {
     Player replacement;
 
     if (popWildcard(replacement)) {
-        cout << "Replacement from wildcard: " << replacement.name << "\n";
+        if (changes) changes->onChange(WILDCARD_REMOVED, replacement.playerID, replacement.name);
+        *out << "Replacement from wildcard: " << replacement.name << "\n";
         registerPlayer(replacement.name, replacement.playerID, false);
         return true;
     }
 
-    cout << "No replacement available from wildcard.\n";
+    *out << "No replacement available from wildcard.\n";
     return false;
 }
 
 // Display all players in all queues
 void RegistrationSystem::displayAllQueues() const {
-    cout << "\n--- Early-bird Players ---\n";
+    *out << "\n--- Early-bird Players ---\n";
     for (int i = 0, idx = earlyFront; i < earlyCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
         const Player& p = earlyBirdQueue[idx];
-        cout << p.name << " (ID: " << p.playerID << ") " << (p.isCheckedIn ? "[Checked-in]" : "") << "\n";
+        *out << p.name << " (ID: " << p.playerID << ") " << (p.isCheckedIn ? "[Checked-in]" : "") << "\n";
     }
 
-    cout << "\n--- Normal Players ---\n";
+    *out << "\n--- Normal Players ---\n";
     for (int i = 0, idx = normalFront; i < normalCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
         const Player& p = normalQueue[idx];
-        cout << p.name << " (ID: " << p.playerID << ") " << (p.isCheckedIn ? "[Checked-in]" : "") << "\n";
+        *out << p.name << " (ID: " << p.playerID << ") " << (p.isCheckedIn ? "[Checked-in]" : "") << "\n";
     }
 
-    cout << "\n--- Wildcard Stack ---\n";
+    *out << "\n--- Wildcard Stack ---\n";
     for (int i = wildcardTop; i >= 0; --i) {
         const Player& p = wildcardStack[i];
-        cout << p.name << " (ID: " << p.playerID << ")\n";
+        *out << p.name << " (ID: " << p.playerID << ")\n";
     }
 
     
@@ -270,18 +334,18 @@ void RegistrationSystem::displayAllQueues() const {
 
 // Display only checked-in players
 void RegistrationSystem::displayCheckedInPlayers() const {
-    cout << "\n--- Checked-in Early-bird Players ---\n";
+    *out << "\n--- Checked-in Early-bird Players ---\n";
     for (int i = 0, idx = earlyFront; i < earlyCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
         const Player& p = earlyBirdQueue[idx];
         if (p.isCheckedIn)
-            cout << p.name << " (ID: " << p.playerID << ")\n";
+            *out << p.name << " (ID: " << p.playerID << ")\n";
     }
 
-    cout << "\n--- Checked-in Normal Players ---\n";
+    *out << "\n--- Checked-in Normal Players ---\n";
     for (int i = 0, idx = normalFront; i < normalCount; ++i, idx = (idx + 1) % MAX_PLAYERS) {
         const Player& p = normalQueue[idx];
         if (p.isCheckedIn)
-            cout << p.name << " (ID: " << p.playerID << ")\n";
+            *out << p.name << " (ID: " << p.playerID << ")\n";
     }
 }
 
@@ -323,6 +387,9 @@ bool RegistrationSystem::removeFromQueue(Player queue[], int& front, int& rear,
         idx = (idx + 1) % MAX_PLAYERS;
     }
     if (foundIndex == -1) return false;
+    if (changes) {
+        changes->onChange(PLAYER_WITHDRAWN, playerID, queue[foundIndex].isCheckedIn ? "checked-in" : "");
+    }
 
     // Shift elements to fill gap
     while (foundIndex != rear) {
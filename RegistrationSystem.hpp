@@ -2,6 +2,10 @@
 #define REGISTRATIONSYSTEM_HPP
 
 #include <string>
+#include <iostream>
+#include <vector>
+#include "apuec_output.hpp"
+#include "apuec_events.hpp"
 
 using namespace std;
 
@@ -26,6 +30,11 @@ private:
     int repFront, repRear, repCount;
     int wildcardTop;  
 
+    ostream* out;   // Progress messages (never null)
+    ChangeListener* changes;    // Player deltas (may be null)
+
+protected:
+    // Ring buffer helpers shared by the early-bird and normal queues
     void enqueue(Player queue[], int& front, int& rear, int& count, const Player& player);
     bool dequeue(Player queue[], int& front, int& rear, int& count, Player& player);
     int findPlayerInQueue(const Player queue[], int front, int rear, int count, const string& playerID) const;
@@ -34,20 +43,31 @@ private:
     void pushWildcard(const Player& player);
     bool popWildcard(Player& player);
 
+    void clearPlayers(const string& source);    // Empty every container (PLAYERS_CLEARED)
+    void restorePlayer(const Player& player);
+
 public:
     //Constructor
-    RegistrationSystem();
+    // The listener also receives the players loaded from players.csv here
+    RegistrationSystem(ostream* output = &cout, ChangeListener* listener = nullptr);
+
+    void setOutput(ostream* output) { out = outputOrDiscard(output); }   // nullptr = silent
+    void setListener(ChangeListener* listener) { changes = listener; }
 
    
     bool loadFromCSV(const string& filename);
 
     bool saveToCSV(const string& filename) const;
 
+    void copyPlayers(vector<Player>& players) const;    // Early-bird, normal, then wildcard
+    static void writeCSV(ostream& file, const vector<Player>& players);     // players.csv layout
+    void restorePlayers(const vector<Player>& players, const string& source);   // Inverse of copyPlayers
+
     bool registerPlayer(const string& name, const string& playerID, bool isEarlyBird);
 
     bool addWildcardEntry(const string& name, const string& playerID);
 
-    void checkInPlayer(const string& playerID);
+    bool checkInPlayer(const string& playerID);
 
     bool withdrawPlayer(const string& playerID);
 
@@ -56,6 +76,12 @@ public:
     void displayAllQueues() const;
 
     void displayCheckedInPlayers() const;
+
+    int getPlayerCount() const { return earlyCount + normalCount; }
+
+    int getWildcardCount() const { return wildcardTop + 1; }
+
+    int getCheckedInCount() const;
 };
 
 #endif 
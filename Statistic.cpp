@@ -1,116 +1,200 @@
 #include "Statistic.hpp"
+#include "apuec_trace.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace std;
 
-void displayAllMatches() {
-    ifstream file("result.csv");
+static void parseMatchRecord(const string& line, MatchRecord& record) {
+    stringstream ss(line);
+    getline(ss, record.teamA, ',');
+    getline(ss, record.teamB, ',');
+    getline(ss, record.winner, ',');
+}
+
+int loadMatchHistory(MatchRecord records[], int maxRecords, const string& filename) {
+    APUEC_TRACE_SCOPE("loadMatchHistory");
+    ifstream file(filename);
     if (!file.is_open()) {
-        cerr << "Failed to open result.csv" << endl;
-        return;
+        return -1;
+    }
+
+    if (maxRecords <= 0) {
+        return 0;
+    }
+
+    // Ring of the last maxRecords lines; the log can hold any number of rows
+    vector<string> latest(maxRecords);
+    long long rows = 0;
+    string line;
+    getline(file, line); // Skip header
+
+    while (getline(file, line)) {
+        latest[rows % maxRecords].swap(line);
+        rows++;
+    }
+
+    int count = rows < maxRecords ? (int)rows : maxRecords;
+    for (int i = 0; i < count; i++) {
+        parseMatchRecord(latest[(rows - 1 - i) % maxRecords], records[i]);
+    }
+
+    file.close();
+    return count;
+}
+
+int forEachMatch(const function<void(const MatchRecord&)>& visit, const string& filename) {
+    APUEC_TRACE_SCOPE("forEachMatch");
+    ifstream file(filename);
+    if (!file.is_open()) {
+        return -1;
     }
 
-    Stack<string> matchStack;
     string line;
     getline(file, line); // Skip header
 
+    int count = 0;
+    MatchRecord record;
     while (getline(file, line)) {
-        matchStack.push(line);
+        parseMatchRecord(line, record);
+        visit(record);
+        count++;
     }
+    return count;
+}
 
-    cout << "All Matches (latest first):\n";
-    cout << "Team A vs Team B -> Winner\n";
-    while (!matchStack.isEmpty()) {
-        string record = matchStack.peek();
-        matchStack.pop();
+int findTeamMatches(const string& teamName, MatchRecord records[], int maxRecords, const string& filename) {
+    APUEC_TRACE_SCOPE("findTeamMatches");
+    ifstream file(filename);
+    if (!file.is_open()) {
+        return -1;
+    }
 
-        stringstream ss(record);
-        string teamA, teamB, winner;
-        getline(ss, teamA, ',');
-        getline(ss, teamB, ',');
-        getline(ss, winner, ',');
+    string line;
+    getline(file, line); // Skip header
 
-        cout << teamA << " vs " << teamB << " -> " << winner << endl;
+    int count = 0;
+    MatchRecord record;
+    while (count < maxRecords && getline(file, line)) {
+        parseMatchRecord(line, record);
+        if (record.teamA == teamName || record.teamB == teamName) {
+            records[count++] = record;
+        }
     }
 
     file.close();
+    return count;
 }
 
-void displayTeamMatches(const string& teamName) {
+bool computeTeamStats(const string& teamName, TeamStats& stats, const string& filename) {
+    APUEC_TRACE_SCOPE("computeTeamStats");
+    ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    stats.totalMatches = 0;
+    stats.wins = 0;
+    stats.losses = 0;
+    string line;
+    getline(file, line); // Skip header
+
+    MatchRecord record;
+    while (getline(file, line)) {
+        parseMatchRecord(line, record);
+
+        if (record.teamA == teamName || record.teamB == teamName) {
+            stats.totalMatches++;
+            if (record.winner == teamName)
+                stats.wins++;
+            else
+                stats.losses++;
+        }
+    }
+
+    stats.winRate = stats.totalMatches > 0
+        ? (static_cast<double>(stats.wins) / stats.totalMatches) * 100.0
+        : 0.0;
+
+    file.close();
+    return true;
+}
+
+void displayAllMatches(ostream& out) {
     ifstream file("result.csv");
     if (!file.is_open()) {
         cerr << "Failed to open result.csv" << endl;
         return;
     }
 
+    vector<string> lines;
     string line;
     getline(file, line); // Skip header
-    cout << "Matches for " << teamName << ":\n";
-    bool found = false;
 
     while (getline(file, line)) {
-        stringstream ss(line);
-        string teamA, teamB, winner;
-        getline(ss, teamA, ',');
-        getline(ss, teamB, ',');
-        getline(ss, winner, ',');
-
-        if (teamA == teamName || teamB == teamName) {
-            cout << teamA << " vs " << teamB << " -> Winner: " << winner << endl;
-            found = true;
-        }
+        lines.push_back(line);
     }
 
-    if (!found) {
-        cout << "No matches found for team " << teamName << "." << endl;
+    out << "All Matches (latest first):\n";
+    out << "Team A vs Team B -> Winner\n";
+    MatchRecord record;
+    for (size_t i = lines.size(); i-- > 0;) {
+        parseMatchRecord(lines[i], record);
+        out << record.teamA << " vs " << record.teamB << " -> " << record.winner << "\n";
     }
 
     file.close();
 }
 
-void displayTeamStats(const string& teamName) {
+void displayTeamMatches(const string& teamName, ostream& out) {
     ifstream file("result.csv");
     if (!file.is_open()) {
         cerr << "Failed to open result.csv" << endl;
         return;
     }
 
-    int totalMatches = 0, wins = 0, losses = 0;
     string line;
     getline(file, line); // Skip header
+    out << "Matches for " << teamName << ":\n";
+    bool found = false;
 
+    MatchRecord record;
     while (getline(file, line)) {
-        stringstream ss(line);
-        string teamA, teamB, winner;
-        getline(ss, teamA, ',');
-        getline(ss, teamB, ',');
-        getline(ss, winner, ',');
-
-        if (teamA == teamName || teamB == teamName) {
-            totalMatches++;
-            if (winner == teamName)
-                wins++;
-            else
-                losses++;
+        parseMatchRecord(line, record);
+
+        if (record.teamA == teamName || record.teamB == teamName) {
+            out << record.teamA << " vs " << record.teamB << " -> Winner: " << record.winner << endl;
+            found = true;
         }
     }
 
-    cout << "Statistics for " << teamName << ":\n";
-    cout << "Total Matches: " << totalMatches << endl;
-    cout << "Wins: " << wins << endl;
-    cout << "Losses: " << losses << endl;
-
-    if (totalMatches > 0) {
-        double winRate = (static_cast<double>(wins) / totalMatches) * 100.0;
-        cout.setf(ios::fixed);
-        cout.precision(2);
-        cout << "Win Rate: " << winRate << "%" << endl;
-    } else {
-        cout << "Win Rate: N/A (no matches played)" << endl;
+    if (!found) {
+        out << "No matches found for team " << teamName << "." << endl;
     }
 
     file.close();
 }
+
+void displayTeamStats(const string& teamName, ostream& out) {
+    TeamStats stats;
+    if (!computeTeamStats(teamName, stats)) {
+        cerr << "Failed to open result.csv" << endl;
+        return;
+    }
+
+    out << "Statistics for " << teamName << ":\n";
+    out << "Total Matches: " << stats.totalMatches << endl;
+    out << "Wins: " << stats.wins << endl;
+    out << "Losses: " << stats.losses << endl;
+
+    if (stats.totalMatches > 0) {
+        out.setf(ios::fixed);
+        out.precision(2);
+        out << "Win Rate: " << stats.winRate << "%" << endl;
+    } else {
+        out << "Win Rate: N/A (no matches played)" << endl;
+    }
+}
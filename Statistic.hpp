@@ -1,7 +1,9 @@
 #ifndef STATISTIC_HPP
 #define STATISTIC_HPP
 
+#include <functional>
 #include <string>
+#include <iostream>
 
 template <typename T>
 class Stack {
@@ -32,8 +34,31 @@ public:
     int size() const { return top + 1; }
 };
 
-void displayAllMatches();
-void displayTeamMatches(const std::string& teamName);
-void displayTeamStats(const std::string& teamName);
+struct MatchRecord {
+    std::string teamA;
+    std::string teamB;
+    std::string winner;
+};
+
+struct TeamStats {
+    int totalMatches;
+    int wins;
+    int losses;
+    double winRate;     // Percent, 0 when no matches were played
+};
+
+// Queries over the match log; false / -1 when the file cannot be read
+int loadMatchHistory(MatchRecord records[], int maxRecords,
+                     const std::string& filename = "result.csv");      // Latest first
+int forEachMatch(const std::function<void(const MatchRecord&)>& visit,
+                 const std::string& filename = "result.csv");      // File order, no limit
+int findTeamMatches(const std::string& teamName, MatchRecord records[], int maxRecords,
+                    const std::string& filename = "result.csv");      // File order
+bool computeTeamStats(const std::string& teamName, TeamStats& stats,
+                      const std::string& filename = "result.csv");
+
+void displayAllMatches(std::ostream& out = std::cout);
+void displayTeamMatches(const std::string& teamName, std::ostream& out = std::cout);
+void displayTeamStats(const std::string& teamName, std::ostream& out = std::cout);
 
 #endif
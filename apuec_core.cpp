@@ -0,0 +1,646 @@
+#include "apuec_core.hpp"
+#include "apuec_trace.hpp"
+#include "binary_snapshot.hpp"
+#include "data_export.hpp"
+#include <cstdio>
+#include <ctime>
+#include <sys/stat.h>
+
+static const char* const TIER_NAMES[3] = { "VIP", "Influencer", "General" };
+static const int EXPORT_THREADS = 5;    // One per exported file
+
+// Times one core operation into SystemMetrics; finish() records the
+// outcome and passes the result through
+class OperationTimer {
+private:
+    SystemMetrics& metrics;
+    MetricOp op;
+    long long started;
+
+public:
+    OperationTimer(SystemMetrics& target, MetricOp timedOp)
+        : metrics(target), op(timedOp), started(SystemMetrics::nowNanos()) {}
+
+    void finish(bool ok) { metrics.recordOperation(op, SystemMetrics::nowNanos() - started, ok); }
+    CoreResult finish(const CoreResult& result) {
+        finish(result.ok);
+        return result;
+    }
+};
+
+APUECCore::APUECCore(ostream* output) {
+    // Modules publish into state from construction on (players.csv is loaded here)
+    spectatorSystem = new SpectatorManager(20, 30, 100, output, &state);  // VIP, Influencer, General seats
+    matchScheduler = new MatchScheduler(output, &state);
+    teamRegistration = new RegistrationManager(output, &state);
+    playerRegistration = new RegistrationSystem(output, &state);
+
+    registrationOpen = true;
+    tournamentComplete = false;
+    spectatorSystemActive = true;
+    exportPool = nullptr;
+
+    int capacity[3];
+    spectatorSystem->getSeatCapacity(capacity);
+    totalSeats = capacity[0] + capacity[1] + capacity[2];
+}
+
+APUECCore::~APUECCore() {
+    delete spectatorSystem;
+    delete matchScheduler;
+    delete teamRegistration;
+    delete playerRegistration;
+    delete exportPool;
+}
+
+void APUECCore::setOutput(ostream* output) {
+    spectatorSystem->setOutput(output);
+    matchScheduler->setOutput(output);
+    teamRegistration->setOutput(output);
+    playerRegistration->setOutput(output);
+}
+
+CoreResult APUECCore::success() {
+    CoreResult result;
+    result.ok = true;
+    return result;
+}
+
+CoreResult APUECCore::failure(const string& message) {
+    CoreResult result;
+    result.ok = false;
+    result.message = message;
+    return result;
+}
+
+void APUECCore::sampleSpectators() {
+    metrics.recordSpectators(state.getWaitingCount(), state.getSeatedCount(), totalSeats);
+}
+
+// ===== TEAM REGISTRATION =====
+
+CoreResult APUECCore::registerTeam(const string& name, bool wildCard) {
+    OperationTimer timer(metrics, OP_REGISTER_TEAM);
+    if (!registrationOpen) {
+        return timer.finish(failure("Team registration is closed"));
+    }
+    if (name.empty()) {
+        return timer.finish(failure("Team name cannot be empty"));
+    }
+    if (!teamRegistration->addTeam(name.c_str(), wildCard)) {
+        return timer.finish(failure("Registration full"));
+    }
+    metrics.recordRegistration(REG_TEAM);
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::withdrawTeam(const string& name) {
+    OperationTimer timer(metrics, OP_WITHDRAW_TEAM);
+    if (!teamRegistration->withdrawTeam(name.c_str())) {
+        return timer.finish(failure("Team \"" + name + "\" not found"));
+    }
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::replaceTeam(const string& oldName, const string& newName) {
+    if (newName.empty()) {
+        return failure("Team name cannot be empty");
+    }
+    if (!teamRegistration->replaceTeam(oldName.c_str(), newName.c_str())) {
+        return failure("Team \"" + oldName + "\" not found");
+    }
+    return success();
+}
+
+CoreResult APUECCore::closeRegistration() {
+    if (!teamRegistration->endRegistration("teams.csv")) {
+        return failure("Cannot select 96 teams from the registered teams");
+    }
+    registrationOpen = false;
+    return success();
+}
+
+// ===== PLAYER REGISTRATION =====
+
+CoreResult APUECCore::registerPlayer(const string& name, const string& playerID, bool earlyBird) {
+    OperationTimer timer(metrics, OP_REGISTER_PLAYER);
+    if (!playerRegistration->registerPlayer(name, playerID, earlyBird)) {
+        return timer.finish(failure(name.empty() || playerID.empty() ? "Name and ID cannot be empty"
+                                                                     : "Registration full"));
+    }
+    metrics.recordRegistration(REG_PLAYER);
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::addWildcardPlayer(const string& name, const string& playerID) {
+    OperationTimer timer(metrics, OP_REGISTER_PLAYER);
+    if (!playerRegistration->addWildcardEntry(name, playerID)) {
+        return timer.finish(failure("Wildcard stack full"));
+    }
+    metrics.recordRegistration(REG_PLAYER);
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::checkInPlayer(const string& playerID) {
+    OperationTimer timer(metrics, OP_CHECK_IN);
+    if (!playerRegistration->checkInPlayer(playerID)) {
+        return timer.finish(failure("Player " + playerID + " not found"));
+    }
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::withdrawPlayer(const string& playerID) {
+    OperationTimer timer(metrics, OP_WITHDRAW_PLAYER);
+    if (!playerRegistration->withdrawPlayer(playerID)) {
+        return timer.finish(failure("Player " + playerID + " not found"));
+    }
+    return timer.finish(success());
+}
+
+// ===== SPECTATORS =====
+
+CoreResult APUECCore::registerSpectator(const string& name, const string& email, const string& type) {
+    OperationTimer timer(metrics, OP_REGISTER_SPECTATOR);
+    if (!spectatorSystemActive) {
+        return timer.finish(failure("Spectator registration is closed"));
+    }
+    if (name.empty() || email.empty()) {
+        return timer.finish(failure("Name and email cannot be empty"));
+    }
+    Spectator spectator(name, email, type, static_cast<int>(time(nullptr)));
+    if (!spectatorSystem->addSpectator(spectator)) {
+        return timer.finish(failure("A spectator with email " + email + " is already registered"));
+    }
+    metrics.recordRegistration(REG_SPECTATOR);
+    sampleSpectators();
+    return timer.finish(success());
+}
+
+int APUECCore::allocateSeating() {
+    OperationTimer timer(metrics, OP_ALLOCATE_SEATING);
+    int seated = spectatorSystem->allocateSeating();
+    sampleSpectators();
+    timer.finish(true);
+    return seated;
+}
+
+CoreResult APUECCore::removeSpectator(const string& email) {
+    OperationTimer timer(metrics, OP_REMOVE_SPECTATOR);
+    if (!spectatorSystem->removeSpectatorByEmail(email)) {
+        return timer.finish(failure("No spectator found with email " + email));
+    }
+    sampleSpectators();
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::changeSpectatorType(const string& email, const string& newType) {
+    OperationTimer timer(metrics, OP_CHANGE_TICKET);
+    if (!spectatorSystem->changeSpectatorType(email, newType)) {
+        Spectator spectator;
+        if (spectatorSystem->findSpectatorByEmail(email, spectator)) {
+            return timer.finish(failure("Spectator is already seated; only waiting spectators can change tickets"));
+        }
+        return timer.finish(failure("No waiting spectator found with email " + email));
+    }
+    return timer.finish(success());
+}
+
+bool APUECCore::findSpectator(const string& email, Spectator& result) const {
+    return spectatorSystem->findSpectatorByEmail(email, result);
+}
+
+int APUECCore::findSpectatorsByName(const string& prefix, Spectator results[], int maxResults) const {
+    return spectatorSystem->findSpectatorsByName(prefix, results, maxResults);
+}
+
+CoreResult APUECCore::saveSpectators(const string& filename) {
+    if (!spectatorSystem->saveToFile(filename)) {
+        return failure("Unable to write file " + filename);
+    }
+    return success();
+}
+
+CoreResult APUECCore::loadSpectators(const string& filename) {
+    if (!spectatorSystem->loadFromFile(filename)) {
+        return failure("Unable to open file " + filename);
+    }
+    sampleSpectators();
+    return success();
+}
+
+// ===== TOURNAMENT =====
+
+TournamentResult APUECCore::runTournament(TournamentFormat format, bool bracketReset) {
+    OperationTimer timer(metrics, OP_RUN_TOURNAMENT);
+    TournamentResult result;
+    result.ok = false;
+    result.matchesPlayed = 0;
+
+    if (registrationOpen) {
+        result.message = "Please close team registration first";
+        timer.finish(false);
+        return result;
+    }
+    if (matchScheduler->isLive()) {
+        result.message = "A live tournament is in progress";
+        timer.finish(false);
+        return result;
+    }
+    long long rows = matchScheduler->getLogRows();
+    long long bytes = matchScheduler->getLogBytes();
+    long long nanos = matchScheduler->getLogNanos();
+    matchScheduler->setFormat(format, bracketReset);
+    if (!matchScheduler->startTournament("teams.csv")) {
+        result.message = "No teams available to start tournament";
+        timer.finish(false);
+        return result;
+    }
+    metrics.recordMatchLog(matchScheduler->getLogRows() - rows, matchScheduler->getLogBytes() - bytes,
+                           matchScheduler->getLogNanos() - nanos);
+    timer.finish(true);
+
+    tournamentComplete = true;
+    result.ok = true;
+    result.champion = matchScheduler->getChampion();
+    result.matchesPlayed = matchScheduler->getMatchesPlayed();
+    return result;
+}
+
+CoreResult APUECCore::startLiveTournament(BracketFormat format, bool bracketReset, vector<LiveMatch>& ready) {
+    ready.clear();
+    if (registrationOpen) {
+        return failure("Please close team registration first");
+    }
+    if (tournamentComplete) {
+        return failure("The tournament has already been played");
+    }
+    if (matchScheduler->isLive()) {
+        return failure("A live tournament is already in progress");
+    }
+    if (!matchScheduler->startLiveTournament("teams.csv", format, bracketReset, ready)) {
+        return failure("No teams available to start tournament");
+    }
+    return success();
+}
+
+CoreResult APUECCore::reportResult(const string& winner, const string& loser, vector<LiveMatch>& nowReady,
+                                   int minute) {
+    OperationTimer timer(metrics, OP_REPORT_RESULT);
+    long long rows = matchScheduler->getLogRows();
+    long long bytes = matchScheduler->getLogBytes();
+    long long nanos = matchScheduler->getLogNanos();
+    string error;
+    if (!matchScheduler->reportResult(winner, loser, nowReady, error, minute)) {
+        return timer.finish(failure(error));
+    }
+    metrics.recordMatchLog(matchScheduler->getLogRows() - rows, matchScheduler->getLogBytes() - bytes,
+                           matchScheduler->getLogNanos() - nanos);
+    if (!matchScheduler->isLive()) {
+        tournamentComplete = true;
+    }
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::setMatchDay(int stations, int matchMinutes, int restMinutes) {
+    if (!matchScheduler->setMatchDay(stations, matchMinutes, restMinutes)) {
+        return failure("Stations and match minutes must be at least 1, rest at least 0");
+    }
+    return success();
+}
+
+CoreResult APUECCore::beginMatch(int id, int station, int minute) {
+    string error;
+    if (!matchScheduler->beginMatch(id, station, minute, error)) {
+        return failure(error);
+    }
+    return success();
+}
+
+CoreResult APUECCore::planMatchDay(int now, vector<ScheduledMatch>& plan, int& finish) {
+    OperationTimer timer(metrics, OP_PLAN_MATCH_DAY);
+    if (now < 0) {
+        return timer.finish(failure("Minute must be at least 0"));
+    }
+    if (!matchScheduler->planMatchDay(now, plan, finish)) {
+        return timer.finish(failure("No live tournament is running"));
+    }
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::setRating(const string& team, double rating) {
+    string error;
+    if (!matchScheduler->setRating(team, rating, error)) {
+        return failure(error);
+    }
+    return success();
+}
+
+CoreResult APUECCore::whatIf(const string& team, const vector<pair<string, string> >& assumptions,
+                             vector<RoundChance>& chances) {
+    OperationTimer timer(metrics, OP_WHAT_IF);
+    string error;
+    if (!matchScheduler->whatIf(team, assumptions, chances, error)) {
+        return timer.finish(failure(error));
+    }
+    return timer.finish(success());
+}
+
+QualifierResult APUECCore::runSwissQualifier(const string& filename, int rounds, int qualifierCount) {
+    OperationTimer timer(metrics, OP_RUN_QUALIFIER);
+    QualifierResult result;
+    result.ok = false;
+    result.matchesPlayed = 0;
+
+    if (rounds < 1 || qualifierCount < 1) {
+        result.message = "Rounds and qualifiers must be at least 1";
+        timer.finish(false);
+        return result;
+    }
+    if (tournamentComplete) {
+        result.message = "The tournament has already been played";
+        timer.finish(false);
+        return result;
+    }
+    long long rows = matchScheduler->getLogRows();
+    long long bytes = matchScheduler->getLogBytes();
+    long long nanos = matchScheduler->getLogNanos();
+    if (!matchScheduler->runSwissQualifier(filename.c_str(), rounds, qualifierCount)) {
+        result.message = "Unable to run a Swiss qualifier from " + filename;
+        timer.finish(false);
+        return result;
+    }
+    metrics.recordMatchLog(matchScheduler->getLogRows() - rows, matchScheduler->getLogBytes() - bytes,
+                           matchScheduler->getLogNanos() - nanos);
+    timer.finish(true);
+
+    result.ok = true;
+    result.qualifiers = matchScheduler->getQualifiers();
+    result.matchesPlayed = matchScheduler->getMatchesPlayed();
+    return result;
+}
+
+CoreResult APUECCore::endTournament() {
+    if (!tournamentComplete) {
+        return failure("No tournament has been played yet");
+    }
+    spectatorSystemActive = false;
+    return success();
+}
+
+// ===== STATISTICS =====
+
+int APUECCore::getMatchHistory(MatchRecord records[], int maxRecords) const {
+    return loadMatchHistory(records, maxRecords);
+}
+
+int APUECCore::getTeamMatches(const string& teamName, MatchRecord records[], int maxRecords) const {
+    return findTeamMatches(teamName, records, maxRecords);
+}
+
+bool APUECCore::getTeamStats(const string& teamName, TeamStats& stats) const {
+    return computeTeamStats(teamName, stats);
+}
+
+// ===== SYSTEM STATE =====
+
+SystemSummary APUECCore::getSummary() const {
+    SystemSummary summary;
+    summary.registeredTeams = state.getTeamCount();
+    summary.registeredPlayers = state.getPlayerCount();
+    summary.checkedInPlayers = state.getCheckedInCount();
+    summary.wildcardPlayers = state.getWildcardPlayerCount();
+    summary.waitingSpectators = state.getWaitingCount();
+    summary.seatedSpectators = state.getSeatedCount();
+    summary.matchesPlayed = state.getMatchesPlayed();
+    summary.champion = state.getChampion();
+    summary.registrationOpen = registrationOpen;
+    summary.tournamentComplete = tournamentComplete;
+    summary.spectatorSystemActive = spectatorSystemActive;
+    return summary;
+}
+
+// Recount each module and compare with the event-driven counters
+void APUECCore::compareWithModules(vector<string>& findings, bool repair) {
+    int roster = playerRegistration->getPlayerCount();
+    int checkedIn = playerRegistration->getCheckedInCount();
+    int wildcards = playerRegistration->getWildcardCount();
+    if (roster != state.getPlayerCount() || checkedIn != state.getCheckedInCount() ||
+        wildcards != state.getWildcardPlayerCount()) {
+        findings.push_back("Players: tracked " + to_string(state.getPlayerCount()) + " (" +
+                           to_string(state.getCheckedInCount()) + " checked in, " +
+                           to_string(state.getWildcardPlayerCount()) + " wildcard), module has " +
+                           to_string(roster) + " (" + to_string(checkedIn) + " checked in, " +
+                           to_string(wildcards) + " wildcard)");
+        if (repair) state.resetPlayers(roster, checkedIn, wildcards);
+    }
+
+    int waiting[3];
+    int seated[3];
+    spectatorSystem->countByTier(waiting, seated);
+    bool drifted = false;
+    for (int i = 0; i < 3; i++) {
+        if (waiting[i] != state.getWaitingCount(i) || seated[i] != state.getSeatedCount(i)) {
+            findings.push_back(string(TIER_NAMES[i]) + " spectators: tracked " +
+                               to_string(state.getWaitingCount(i)) + " waiting / " +
+                               to_string(state.getSeatedCount(i)) + " seated, module has " +
+                               to_string(waiting[i]) + " / " + to_string(seated[i]));
+            drifted = true;
+        }
+    }
+    if (drifted && repair) state.resetSpectators(waiting, seated);
+}
+
+vector<string> APUECCore::synchronize() {
+    vector<string> corrections;
+    compareWithModules(corrections, true);
+    return corrections;
+}
+
+vector<string> APUECCore::validate() {
+    vector<string> problems;
+    compareWithModules(problems, false);
+
+    if (state.getCheckedInCount() > state.getPlayerCount()) {
+        problems.push_back("More players checked in than registered");
+    }
+    if (state.getWildcardTeamCount() > state.getTeamCount() || state.getTeamCount() < 0) {
+        problems.push_back("Team counters are inconsistent");
+    }
+    if (!registrationOpen && !state.areTeamsSelected()) {
+        problems.push_back("Registration is closed but no tournament teams were selected");
+    }
+    if (tournamentComplete && registrationOpen) {
+        problems.push_back("Tournament completed while registration is still open");
+    }
+    if (tournamentComplete && state.getChampion().empty()) {
+        problems.push_back("Tournament completed without a champion");
+    }
+
+    VenueStatus venue = spectatorSystem->getVenueStatus();
+    if (state.getSeatedCount() > venue.totalSeats) {
+        problems.push_back("More spectators seated than the venue holds");
+    }
+    return problems;
+}
+
+CoreResult APUECCore::exportAll(const string& directory) {
+    APUEC_TRACE_SCOPE("APUECCore::exportAll");
+    OperationTimer timer(metrics, OP_EXPORT);
+    // Snapshot: the only step that reads the modules
+    ExportSnapshot snapshot;
+    teamRegistration->copyTeams(snapshot.teams);
+    playerRegistration->copyPlayers(snapshot.players);
+    spectatorSystem->copySpectators(snapshot.spectators);
+    matchScheduler->flushLog();
+    snapshot.matchLog = "result.csv";
+    struct stat logInfo;
+    snapshot.matchLogBytes = (stat("result.csv", &logInfo) == 0) ? (long long)logInfo.st_size : -1;
+    snapshot.state = state;
+    snapshot.registrationOpen = registrationOpen;
+
+    if (exportPool == nullptr) {
+        exportPool = new TaskPool(EXPORT_THREADS);
+    }
+    string error;
+    if (exportSnapshot(snapshot, directory, *exportPool, error) < 0) {
+        return timer.finish(failure("Export failed: " + error));
+    }
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::saveSnapshot(const string& path) {
+    APUEC_TRACE_SCOPE("APUECCore::saveSnapshot");
+    OperationTimer timer(metrics, OP_SAVE_SNAPSHOT);
+    // The snapshot holds the match log of a finished tournament only; a
+    // live bracket or qualifier results would reload as not played
+    if (matchScheduler->isLive()) {
+        return timer.finish(failure("A live tournament is in progress; save a snapshot once it has finished"));
+    }
+    if (!tournamentComplete && matchScheduler->getLogRows() > 0) {
+        return timer.finish(failure("Qualifier results are not kept in a snapshot; save one once the tournament has been played"));
+    }
+    SnapshotBuilder builder;
+    builder.setFlags((registrationOpen ? SNAPSHOT_REGISTRATION_OPEN : 0) |
+                     (tournamentComplete ? SNAPSHOT_TOURNAMENT_COMPLETE : 0) |
+                     (spectatorSystemActive ? SNAPSHOT_SPECTATORS_ACTIVE : 0));
+    int capacity[3];
+    spectatorSystem->getSeatCapacity(capacity);
+    builder.setSeatCapacity(capacity);
+    builder.setChampion(state.getChampion());
+
+    vector<Team> teams;
+    teamRegistration->copyTeams(teams);
+    for (size_t i = 0; i < teams.size(); i++) {
+        builder.addTeam(teams[i].name, teams[i].status);
+    }
+
+    vector<Player> players;
+    playerRegistration->copyPlayers(players);
+    for (size_t i = 0; i < players.size(); i++) {
+        const Player& player = players[i];
+        builder.addPlayer(player.name, player.playerID, player.isEarlyBird, player.isWildcard, player.isCheckedIn);
+    }
+
+    vector<Spectator> spectators;
+    vector<int> seatIds;
+    spectatorSystem->copySpectators(spectators, &seatIds);
+    for (size_t i = 0; i < spectators.size(); i++) {
+        const Spectator& spectator = spectators[i];
+        builder.addSpectator(spectator.getName(), spectator.getEmail(), spectator.getPriority() - 1,
+                             spectator.getArrivalTime(), seatIds[i]);
+    }
+
+    // Every logged match, in file order
+    if (tournamentComplete) {
+        matchScheduler->flushLog();
+        forEachMatch([&builder](const MatchRecord& match) {
+            builder.addMatch(match.teamA, match.teamB, match.winner);
+        });
+    }
+
+    string error;
+    if (!builder.write(path, error)) {
+        return timer.finish(failure("Snapshot failed: " + error));
+    }
+    return timer.finish(success());
+}
+
+CoreResult APUECCore::loadSnapshot(const string& path) {
+    APUEC_TRACE_SCOPE("APUECCore::loadSnapshot");
+    OperationTimer timer(metrics, OP_LOAD_SNAPSHOT);
+    if (state.getTeamCount() > 0 || state.getWaitingCount() > 0 || state.getSeatedCount() > 0 ||
+        state.getMatchesPlayed() > 0 || !registrationOpen) {
+        return timer.finish(failure("A snapshot can only be loaded into a fresh system"));
+    }
+
+    SnapshotView view;
+    string error;
+    if (!view.open(path, error)) {
+        return timer.finish(failure("Cannot load snapshot: " + error));
+    }
+    int capacity[3];
+    spectatorSystem->getSeatCapacity(capacity);
+    for (int i = 0; i < 3; i++) {
+        if (view.getSeatCapacity()[i] != capacity[i]) {
+            return timer.finish(failure("Cannot load snapshot: it was taken with a different seat layout"));
+        }
+    }
+
+    vector<Team> teams(view.teamCount());
+    for (size_t i = 0; i < teams.size(); i++) {
+        const SnapshotTeam& record = view.teams()[i];
+        Team& team = teams[i];
+        snprintf(team.name, sizeof(team.name), "%s", view.text(record.name).c_str());
+        snprintf(team.status, sizeof(team.status), "%s", view.text(record.status).c_str());
+    }
+    if (!teamRegistration->restoreTeams(teams)) {
+        return timer.finish(failure("Cannot load snapshot: too many teams"));
+    }
+
+    vector<Player> players(view.playerCount());
+    for (size_t i = 0; i < players.size(); i++) {
+        const SnapshotPlayer& record = view.players()[i];
+        players[i].name = view.text(record.name);
+        players[i].playerID = view.text(record.playerID);
+        players[i].isEarlyBird = record.earlyBird != 0;
+        players[i].isWildcard = record.wildcard != 0;
+        players[i].isCheckedIn = record.checkedIn != 0;
+    }
+    playerRegistration->restorePlayers(players, path);
+
+    int rejected = 0;
+    spectatorSystem->reserveSpectators((int)view.spectatorCount());
+    for (size_t i = 0; i < view.spectatorCount(); i++) {
+        const SnapshotSpectator& record = view.spectators()[i];
+        Spectator spectator(view.text(record.name), view.text(record.email), TIER_NAMES[record.type],
+                            record.arrivalTime);
+        if (!spectatorSystem->restoreSpectator(spectator, record.seatId)) {
+            rejected++;
+        }
+    }
+
+    uint32_t flags = view.getFlags();
+    registrationOpen = (flags & SNAPSHOT_REGISTRATION_OPEN) != 0;
+    tournamentComplete = (flags & SNAPSHOT_TOURNAMENT_COMPLETE) != 0;
+    spectatorSystemActive = (flags & SNAPSHOT_SPECTATORS_ACTIVE) != 0;
+    if (!registrationOpen) {
+        state.onChange(TEAMS_SELECTED, "teams.csv", "");
+    }
+    if (tournamentComplete) {
+        vector<MatchLogEntry> matches(view.matchCount());
+        for (size_t i = 0; i < matches.size(); i++) {
+            const SnapshotMatch& record = view.matches()[i];
+            matches[i].teamA = view.text(record.teamA);
+            matches[i].teamB = view.text(record.teamB);
+            matches[i].winner = view.text(record.winner);
+        }
+        matchScheduler->restoreTournament(matches, view.getChampion().c_str());
+    }
+
+    sampleSpectators();
+    if (rejected > 0) {
+        return timer.finish(failure("Snapshot loaded, but " + to_string(rejected) +
+                                    " spectators conflicted with an earlier record and were skipped"));
+    }
+    return timer.finish(success());
+}
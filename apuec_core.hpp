@@ -0,0 +1,172 @@
+#ifndef APUEC_CORE_HPP
+#define APUEC_CORE_HPP
+
+#include "spectator_manager.hpp"
+#include "MatchScheduler.hpp"
+#include "RegistrationManager.hpp"
+#include "RegistrationSystem.hpp"
+#include "Statistic.hpp"
+#include "metrics.hpp"
+#include "system_state.hpp"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class TaskPool;
+
+// Outcome of a core operation; message explains failures
+struct CoreResult {
+    bool ok;
+    string message;
+};
+
+struct TournamentResult {
+    bool ok;
+    string champion;
+    int matchesPlayed;
+    string message;
+};
+
+struct QualifierResult {
+    bool ok;
+    vector<string> qualifiers;      // Best first
+    int matchesPlayed;
+    string message;
+};
+
+struct SystemSummary {
+    int registeredTeams;
+    int registeredPlayers;
+    int checkedInPlayers;
+    int wildcardPlayers;
+    int waitingSpectators;
+    int seatedSpectators;
+    int matchesPlayed;
+    string champion;                // Empty until a tournament has finished
+    bool registrationOpen;
+    bool tournamentComplete;
+    bool spectatorSystemActive;
+};
+
+// Tournament engine without terminal I/O.
+// Owns the scheduling, registration and spectator modules and exposes
+// their operations as plain calls that return results. Module progress
+// messages go to the stream passed in (nullptr = silent), so the same
+// engine backs the interactive shell, batch runs and embedding services.
+class APUECCore {
+private:
+    SystemState state;                      // Kept current by module change events
+    SpectatorManager* spectatorSystem;      // Task 3: Spectator Management
+    MatchScheduler* matchScheduler;         // Task 1: Match Scheduling
+    RegistrationManager* teamRegistration;  // Task 2: Team Registration
+    RegistrationSystem* playerRegistration; // Task 2: Player Registration
+
+    bool registrationOpen;
+    bool tournamentComplete;
+    bool spectatorSystemActive;
+    TaskPool* exportPool;                   // Created by the first exportAll
+    SystemMetrics metrics;                  // Latency, rates and occupancy measured by every call
+    int totalSeats;
+
+    static CoreResult success();
+    static CoreResult failure(const string& message);
+    void sampleSpectators();                // Queue depth and seat utilization into metrics
+    void compareWithModules(vector<string>& findings, bool repair);
+
+    // Disable copying (owns the modules)
+    APUECCore(const APUECCore&);
+    APUECCore& operator=(const APUECCore&);
+
+public:
+    APUECCore(ostream* output = nullptr);
+    ~APUECCore();
+
+    void setOutput(ostream* output);
+
+    // Team registration
+    CoreResult registerTeam(const string& name, bool wildCard);
+    CoreResult withdrawTeam(const string& name);
+    CoreResult replaceTeam(const string& oldName, const string& newName);
+    CoreResult closeRegistration();             // Writes the 96 selected teams to teams.csv
+
+    // Player registration
+    CoreResult registerPlayer(const string& name, const string& playerID, bool earlyBird);
+    CoreResult addWildcardPlayer(const string& name, const string& playerID);
+    CoreResult checkInPlayer(const string& playerID);
+    CoreResult withdrawPlayer(const string& playerID);
+
+    // Spectators
+    CoreResult registerSpectator(const string& name, const string& email, const string& type);
+    int allocateSeating();                      // Seats filled from the waiting queue
+    CoreResult removeSpectator(const string& email);
+    CoreResult changeSpectatorType(const string& email, const string& newType);
+    bool findSpectator(const string& email, Spectator& result) const;
+    int findSpectatorsByName(const string& prefix, Spectator results[], int maxResults) const;
+    CoreResult saveSpectators(const string& filename);
+    CoreResult loadSpectators(const string& filename);
+    VenueStatus getVenueStatus() const { return spectatorSystem->getVenueStatus(); }
+
+    // Tournament
+    // Plays teams.csv in the given format, logs to result.csv
+    TournamentResult runTournament(TournamentFormat format = FORMAT_GROUP_STAGE, bool bracketReset = true);
+    // Live tournament on teams.csv: results arrive one match at a time.
+    // ready / nowReady receive the matches that became playable.
+    CoreResult startLiveTournament(BracketFormat format, bool bracketReset, vector<LiveMatch>& ready);
+    // minute (if >= 0) is when the match ended, for the match-day plan
+    CoreResult reportResult(const string& winner, const string& loser, vector<LiveMatch>& nowReady,
+                            int minute = -1);
+    void getReadyMatches(vector<LiveMatch>& matches) const { matchScheduler->getReadyMatches(matches); }
+    // Match day: stations, match length and minimum rest between a team's
+    // matches, in minutes; the plan is re-projected from any minute, so
+    // an overrunning match only needs a new plan call
+    CoreResult setMatchDay(int stations, int matchMinutes, int restMinutes);
+    CoreResult beginMatch(int id, int station, int minute);
+    CoreResult planMatchDay(int now, vector<ScheduledMatch>& plan, int& finish);
+    // What-if queries on the live bracket: exact chances per round, given
+    // the played results and the assumed (winner, loser) pairs; an empty
+    // loser means "winner wins its next match"
+    CoreResult setRating(const string& team, double rating);
+    CoreResult whatIf(const string& team, const vector<pair<string, string> >& assumptions,
+                      vector<RoundChance>& chances);
+    // Swiss rounds over every team in filename (name,status lines), logged
+    // to result.csv; must run before the tournament closes the log
+    QualifierResult runSwissQualifier(const string& filename, int rounds, int qualifierCount);
+    CoreResult endTournament();                 // Closes spectator registration
+
+    // Statistics over result.csv
+    int getMatchHistory(MatchRecord records[], int maxRecords) const;
+    int getTeamMatches(const string& teamName, MatchRecord records[], int maxRecords) const;
+    bool getTeamStats(const string& teamName, TeamStats& stats) const;
+
+    // System state; summary and state queries never scan the modules
+    SystemSummary getSummary() const;
+    const SystemState& getState() const { return state; }
+    const SystemMetrics& getMetrics() const { return metrics; }
+    bool isRegistrationOpen() const { return registrationOpen; }
+    bool isTournamentComplete() const { return tournamentComplete; }
+
+    // Recount module state, correct drifted counters and describe each
+    // correction. Events keep the counters exact, so this normally
+    // returns nothing; it exists for recovery and auditing.
+    vector<string> synchronize();
+    // Cross-module consistency checks without changing anything
+    vector<string> validate();
+    // Consistent snapshot of all module data written in parallel to
+    // directory: registration.csv, players.csv, spectators.csv,
+    // result.csv and system_state.csv (see exportSnapshot)
+    CoreResult exportAll(const string& directory = "export");
+
+    // Binary image of teams, players, spectators with their seats, the
+    // match log and the engine flags (see binary_snapshot.hpp). Loading
+    // is only allowed into a fresh engine: no teams, spectators or
+    // matches yet (the roster read from players.csv is replaced).
+    CoreResult saveSnapshot(const string& path);
+    CoreResult loadSnapshot(const string& path);
+
+    // Module access for front ends that render module views
+    SpectatorManager& getSpectatorManager() { return *spectatorSystem; }
+    RegistrationSystem& getPlayerRegistration() { return *playerRegistration; }
+};
+
+#endif
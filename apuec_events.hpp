@@ -0,0 +1,46 @@
+#ifndef APUEC_EVENTS_HPP
+#define APUEC_EVENTS_HPP
+
+#include <string>
+using namespace std;
+
+// State changes a module reports to its listener. Each event is a delta;
+// a listener that has seen every event since the module was constructed
+// can keep counts without ever scanning the module.
+enum ChangeKind {
+    // RegistrationManager (teams); detail = status
+    TEAM_REGISTERED,            // subject = team, detail = "early bird", "normal" or "wild card"
+    TEAM_WITHDRAWN,             // subject = team, detail = status
+    TEAM_RENAMED,               // subject = old name, detail = new name
+    TEAMS_SELECTED,             // subject = file the tournament teams were written to
+
+    // RegistrationSystem (players)
+    PLAYERS_CLEARED,            // Roster reloaded; followed by one event per player
+    PLAYER_REGISTERED,          // subject = player ID, detail = name
+    PLAYER_WITHDRAWN,           // subject = player ID, detail = "checked-in" if they were
+    PLAYER_CHECKED_IN,          // subject = player ID
+    WILDCARD_ADDED,             // subject = player ID, detail = name
+    WILDCARD_REMOVED,           // subject = player ID (promoted into the roster)
+
+    // SpectatorManager; detail = spectator type, or seat tier for seats
+    SPECTATOR_QUEUED,           // subject = email
+    SPECTATOR_DEQUEUED,         // subject = email (seated, cancelled or retyped)
+    SPECTATOR_SEATED,           // subject = email, detail = tier of the seat
+    SPECTATOR_UNSEATED,         // subject = email, detail = tier of the seat
+
+    // MatchScheduler
+    TOURNAMENT_STARTED,         // subject = teams file
+    MATCH_READY,                // Live bracket: subject = team A, detail = team B
+    MATCH_PLAYED,               // subject = winner, detail = loser
+    TOURNAMENT_FINISHED         // subject = champion
+};
+
+// Receives module deltas. Modules call onChange synchronously after the
+// change is applied; a null listener disables publishing.
+class ChangeListener {
+public:
+    virtual ~ChangeListener() {}
+    virtual void onChange(ChangeKind kind, const string& subject, const string& detail) = 0;
+};
+
+#endif
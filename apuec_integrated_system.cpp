@@ -1,33 +1,38 @@
 #include "apuec_integrated_system.hpp"
 #include <iomanip>
 #include <fstream>
+#include <sstream>
+
+// Largest match log the statistics views read (Stack capacity in Statistic.hpp)
+static const int MAX_MATCH_RECORDS = 1000;
 
 // Constructor
 APUECIntegratedSystem::APUECIntegratedSystem() {
-    // Initialize all task systems
-    spectatorSystem = new SpectatorManager(20, 30, 100);  // VIP, Influencer, General seats
-    matchScheduler = new MatchScheduler();
-    teamRegistration = new RegistrationManager();
-    playerRegistration = new RegistrationSystem();
-    
-    // Initialize system state
-    isRegistrationActive = true;
-    isTournamentActive = false;
-    isSpectatorSystemActive = true;
-    
-    totalRegisteredTeams = 0;
-    totalRegisteredPlayers = 0;
-    totalSpectators = 0;
+    // Module progress messages are part of the interactive output
+    core = new APUECCore(&cout);
     
     cout << "APUEC Tournament Management System Initialized Successfully!\n";
 }
 
 // Destructor
 APUECIntegratedSystem::~APUECIntegratedSystem() {
-    delete spectatorSystem;
-    delete matchScheduler;
-    delete teamRegistration;
-    delete playerRegistration;
+    delete core;
+}
+
+// Print the reason of a failed core call the modules did not report themselves
+void APUECIntegratedSystem::reportFailure(const CoreResult& result) {
+    if (!result.ok) {
+        cout << "Error: " << result.message << "\n";
+    }
+}
+
+string APUECIntegratedSystem::spectatorTypeFromChoice(int choice) {
+    switch (choice) {
+        case 1: return "VIP";
+        case 2: return "Influencer";
+        case 3: return "General";
+        default: return "";
+    }
 }
 
 void APUECIntegratedSystem::displaySystemHeader() {
@@ -38,10 +43,11 @@ void APUECIntegratedSystem::displaySystemHeader() {
 }
 
 void APUECIntegratedSystem::displaySystemStatus() {
+    SystemSummary summary = core->getSummary();
     cout << "\n--- SYSTEM STATUS ---\n";
-    cout << "Registration: " << (isRegistrationActive ? "ACTIVE" : "CLOSED") << "\n";
-    cout << "Tournament: " << (isTournamentActive ? "IN PROGRESS" : "NOT STARTED") << "\n";
-    cout << "Spectator System: " << (isSpectatorSystemActive ? "ACTIVE" : "INACTIVE") << "\n";
+    cout << "Registration: " << (summary.registrationOpen ? "ACTIVE" : "CLOSED") << "\n";
+    cout << "Tournament: " << (summary.tournamentComplete ? "IN PROGRESS" : "NOT STARTED") << "\n";
+    cout << "Spectator System: " << (summary.spectatorSystemActive ? "ACTIVE" : "INACTIVE") << "\n";
     cout << string(50, '-') << "\n";
 }
 
@@ -90,16 +96,28 @@ void APUECIntegratedSystem::handleTeamRegistrationMenu() {
         cin.ignore();
         
         switch (choice) {
-            case 1:
-                teamRegistration->registerTeam();
-                totalRegisteredTeams++;
+            case 1: {
+                string teamName;
+                int type;
+                cout << "Enter Team Name: ";
+                getline(cin, teamName);
+                cout << "Select Registration Type:\n";
+                cout << "1. Normal\n";
+                cout << "2. Wild Card\n";
+                cout << "Choice: ";
+                cin >> type;
+                if (type == 1 || type == 2) {
+                    reportFailure(core->registerTeam(teamName, type == 2));
+                } else {
+                    cout << "Invalid option.\n";
+                }
                 break;
+            }
             case 2: {
                 string teamName;
                 cout << "Enter team name to withdraw: ";
                 getline(cin, teamName);
-                teamRegistration->withdrawTeam(teamName.c_str());
-                totalRegisteredTeams--;
+                core->withdrawTeam(teamName);
                 break;
             }
             case 3: {
@@ -108,18 +126,20 @@ void APUECIntegratedSystem::handleTeamRegistrationMenu() {
                 getline(cin, oldName);
                 cout << "Enter new team name: ";
                 getline(cin, newName);
-                teamRegistration->replaceTeam(oldName.c_str(), newName.c_str());
+                core->replaceTeam(oldName, newName);
                 break;
             }
             case 4:
-                teamRegistration->endRegistration("teams.csv");
-                isRegistrationActive = false;
-                cout << "Team registration closed. Ready for tournament!\n";
+                if (core->closeRegistration().ok) {
+                    cout << "Team registration closed. Ready for tournament!\n";
+                }
                 break;
-            case 5:
-                cout << "Total registered teams: " << totalRegisteredTeams << "\n";
-                cout << "Registration status: " << (isRegistrationActive ? "Open" : "Closed") << "\n";
+            case 5: {
+                SystemSummary summary = core->getSummary();
+                cout << "Total registered teams: " << summary.registeredTeams << "\n";
+                cout << "Registration status: " << (summary.registrationOpen ? "Open" : "Closed") << "\n";
                 break;
+            }
             case 6:
                 cout << "Returning to main menu...\n";
                 break;
@@ -161,34 +181,30 @@ void APUECIntegratedSystem::handlePlayerRegistrationMenu() {
                 cout << "Early-bird registration? (1=Yes, 0=No): ";
                 cin >> isEarly;
                 cin.ignore();
-                if (playerRegistration->registerPlayer(name, playerID, isEarly)) {
-                    totalRegisteredPlayers++;
-                }
+                core->registerPlayer(name, playerID, isEarly);
                 break;
             case 2:
                 cout << "Enter wildcard player name: ";
                 getline(cin, name);
                 cout << "Enter player ID: ";
                 getline(cin, playerID);
-                playerRegistration->addWildcardEntry(name, playerID);
+                core->addWildcardPlayer(name, playerID);
                 break;
             case 3:
                 cout << "Enter player ID to check in: ";
                 getline(cin, playerID);
-                playerRegistration->checkInPlayer(playerID);
+                core->checkInPlayer(playerID);
                 break;
             case 4:
                 cout << "Enter player ID to withdraw: ";
                 getline(cin, playerID);
-                if (playerRegistration->withdrawPlayer(playerID)) {
-                    totalRegisteredPlayers--;
-                }
+                core->withdrawPlayer(playerID);
                 break;
             case 5:
-                playerRegistration->displayAllQueues();
+                core->getPlayerRegistration().displayAllQueues();
                 break;
             case 6:
-                playerRegistration->displayCheckedInPlayers();
+                core->getPlayerRegistration().displayCheckedInPlayers();
                 break;
             case 7:
                 cout << "Returning to main menu...\n";
@@ -209,29 +225,32 @@ void APUECIntegratedSystem::handleMatchSchedulingMenu() {
         cout << "Data Structure Used: Stack, Queue, Priority Queue, Circular Queue\n";
         cout << string(65, '-') << "\n";
         cout << "1. Start Tournament (Process Teams)\n";
-        cout << "2. View Tournament Status\n";
-        cout << "3. Back to Main Menu\n";
+        cout << "2. Start Double-Elimination Tournament\n";
+        cout << "3. View Tournament Status\n";
+        cout << "4. Back to Main Menu\n";
         cout << "Choice: ";
         cin >> choice;
 
         switch (choice) {
             case 1:
-                if (!isRegistrationActive) {
+            case 2:
+                if (!core->isRegistrationOpen()) {
                     cout << "Starting tournament with registered teams...\n";
-                    matchScheduler->startTournament("teams.csv");
-                    isTournamentActive = true;
-                    cout << "Tournament completed! Check Statistics menu for results.\n";
+                    TournamentFormat format = (choice == 2) ? FORMAT_DOUBLE_ELIMINATION : FORMAT_GROUP_STAGE;
+                    if (core->runTournament(format).ok) {
+                        cout << "Tournament completed! Check Statistics menu for results.\n";
+                    }
                 } else {
                     cout << "Error: Please close team registration first!\n";
                 }
                 break;
 
-            case 2:
-                cout << "Tournament Status: " << (isTournamentActive ? "Completed" : "Not Started") << "\n";
-                cout << "Registration Status: " << (isRegistrationActive ? "Open" : "Closed") << "\n";
+            case 3:
+                cout << "Tournament Status: " << (core->isTournamentComplete() ? "Completed" : "Not Started") << "\n";
+                cout << "Registration Status: " << (core->isRegistrationOpen() ? "Open" : "Closed") << "\n";
                 break;
 
-            case 3:
+            case 4:
                 cout << "Returning to main menu...\n";
                 break;
 
@@ -240,9 +259,9 @@ void APUECIntegratedSystem::handleMatchSchedulingMenu() {
                 break;
         }
 
-        if (choice != 3) waitForUserInput();
+        if (choice != 4) waitForUserInput();
 
-    } while (choice != 3);
+    } while (choice != 4);
 }
 
 void APUECIntegratedSystem::handleSpectatorManagementMenu() {
@@ -260,54 +279,195 @@ void APUECIntegratedSystem::handleSpectatorManagementMenu() {
         cout << "6. Display System Statistics\n";
         cout << "7. Save Spectator Data\n";
         cout << "8. Load Spectator Data\n";  // NEW OPTION
-        cout << "9. Back to Main Menu\n";
+        cout << "9. Remove Spectator\n";
+        cout << "10. Search Spectator\n";
+        cout << "11. Upgrade Ticket\n";
+        cout << "12. Back to Main Menu\n";
         cout << "Choice: ";
         cin >> choice;
         
+        SpectatorManager& spectators = core->getSpectatorManager();
+        
         switch (choice) {
-            case 1:
-                spectatorSystem->registerSpectator();
-                totalSpectators++;
+            case 1: {
+                string name, email;
+                cout << "\n=== SPECTATOR REGISTRATION ===\n";
+                cout << "Enter name: ";
+                cin.ignore();
+                getline(cin, name);
+                cout << "Enter email: ";
+                getline(cin, email);
+                
+                Spectator existing;
+                if (core->findSpectator(email, existing)) {
+                    cout << "A spectator with email " << email << " is already registered.\n";
+                    break;
+                }
+                
+                int typeChoice;
+                cout << "Select spectator type:\n";
+                cout << "1. VIP\n2. Influencer\n3. General\n";
+                cout << "Enter choice (1-3): ";
+                cin >> typeChoice;
+                string type = spectatorTypeFromChoice(typeChoice);
+                if (type.empty()) {
+                    cout << "Invalid choice. Defaulting to General.\n";
+                    type = "General";
+                }
+                
+                CoreResult result = core->registerSpectator(name, email, type);
+                if (!result.ok) {
+                    reportFailure(result);
+                    break;
+                }
+                cout << "\nSpectator registered successfully!\n";
+                cout << "Name: " << name << "\n";
+                cout << "Type: " << type << "\n";
+                cout << "Position in queue: " << core->getVenueStatus().waiting << "\n";
                 break;
+            }
             case 2:
-                spectatorSystem->allocateSeating();
+                core->allocateSeating();
                 break;
             case 3:
-                spectatorSystem->displayWaitingQueue();
+                spectators.displayWaitingQueue();
                 break;
             case 4:
-                spectatorSystem->displaySeatedSpectators();
+                spectators.displaySeatedSpectators();
                 break;
             case 5:
-                spectatorSystem->displayVenueStatus();
+                spectators.displayVenueStatus();
                 break;
             case 6:
-                spectatorSystem->displayStatistics();
+                spectators.displayStatistics();
                 break;
             case 7: {
                 string filename;
                 cout << "Enter filename to save (e.g., spectators.csv): ";
                 cin >> filename;
-                spectatorSystem->saveToFile(filename);
+                core->saveSpectators(filename);
                 break;
             }
             case 8: {
                 string filename;
                 cout << "Enter filename to load (e.g., spectators.csv): ";
                 cin >> filename;
-                spectatorSystem->loadFromFile(filename);
+                core->loadSpectators(filename);
                 break;
             }
-            case 9:
+            case 9: {
+                string email;
+                cout << "\n=== REMOVE SPECTATOR ===\n";
+                cout << "Enter email of spectator to remove: ";
+                cin.ignore();
+                getline(cin, email);
+                
+                Spectator spectator;
+                if (!core->findSpectator(email, spectator)) {
+                    cout << "No spectator found with email " << email << ".\n";
+                    break;
+                }
+                core->removeSpectator(email);
+                
+                cout << "\nSpectator removed successfully!\n";
+                cout << "Name: " << spectator.getName() << "\n";
+                if (spectator.getIsSeated()) {
+                    cout << "Released seat: " << spectator.getSeatSection() << "\n";
+                } else {
+                    cout << "Removed from waiting queue.\n";
+                }
+                break;
+            }
+            case 10: {
+                const int MAX_RESULTS = 50;
+                int searchChoice;
+                cout << "\n=== SEARCH SPECTATOR ===\n";
+                cout << "1. Search by Email\n2. Search by Name\n";
+                cout << "Enter choice (1-2): ";
+                cin >> searchChoice;
+                cin.ignore();
+                
+                Spectator results[MAX_RESULTS];
+                int found = 0;
+                if (searchChoice == 1) {
+                    string email;
+                    cout << "Enter email: ";
+                    getline(cin, email);
+                    found = core->findSpectator(email, results[0]) ? 1 : 0;
+                } else if (searchChoice == 2) {
+                    string prefix;
+                    cout << "Enter name (or the beginning of it): ";
+                    getline(cin, prefix);
+                    found = core->findSpectatorsByName(prefix, results, MAX_RESULTS);
+                } else {
+                    cout << "Invalid choice!\n";
+                    break;
+                }
+                
+                if (found == 0) {
+                    cout << "No matching spectators found.\n";
+                    break;
+                }
+                cout << left << setw(15) << "Name" 
+                     << setw(25) << "Email" 
+                     << setw(12) << "Type"
+                     << setw(10) << "Priority"
+                     << setw(15) << "Seat Section"
+                     << setw(8) << "Seated" << endl;
+                cout << string(85, '-') << endl;
+                for (int i = 0; i < found; i++) {
+                    results[i].displaySpectator();
+                }
+                cout << "\n" << found << " spectator(s) found.\n";
+                break;
+            }
+            case 11: {
+                string email;
+                cout << "\n=== UPGRADE TICKET ===\n";
+                cout << "Enter email of waiting spectator: ";
+                cin.ignore();
+                getline(cin, email);
+                
+                Spectator spectator;
+                if (!core->findSpectator(email, spectator)) {
+                    cout << "No waiting spectator found with email " << email << ".\n";
+                    break;
+                }
+                if (spectator.getIsSeated()) {
+                    cout << "Spectator is already seated; only waiting spectators can change tickets.\n";
+                    break;
+                }
+                
+                int typeChoice;
+                cout << "Current type: " << spectator.getSpectatorType() << "\n";
+                cout << "Select new spectator type:\n";
+                cout << "1. VIP\n2. Influencer\n3. General\n";
+                cout << "Enter choice (1-3): ";
+                cin >> typeChoice;
+                string type = spectatorTypeFromChoice(typeChoice);
+                if (type.empty()) {
+                    cout << "Invalid choice. Ticket unchanged.\n";
+                    break;
+                }
+                
+                CoreResult result = core->changeSpectatorType(email, type);
+                if (result.ok) {
+                    cout << "Ticket for " << spectator.getName() << " changed to " << type << ".\n";
+                } else {
+                    reportFailure(result);
+                }
+                break;
+            }
+            case 12:
                 cout << "Returning to main menu...\n";
                 break;
             default:
                 cout << "Invalid option!\n";
         }
         
-        if (choice != 9) waitForUserInput();
+        if (choice != 12) waitForUserInput();
         
-    } while (choice != 9);
+    } while (choice != 12);
 }
 
 void APUECIntegratedSystem::handleStatisticsMenu() {
@@ -327,19 +487,59 @@ void APUECIntegratedSystem::handleStatisticsMenu() {
         cin.ignore();
         
         switch (choice) {
-            case 1:
-                displayAllMatches();
+            case 1: {
+                MatchRecord* records = new MatchRecord[MAX_MATCH_RECORDS];
+                int count = core->getMatchHistory(records, MAX_MATCH_RECORDS);
+                if (count < 0) {
+                    cerr << "Failed to open result.csv" << endl;
+                } else {
+                    cout << "All Matches (latest first):\n";
+                    cout << "Team A vs Team B -> Winner\n";
+                    for (int i = 0; i < count; i++) {
+                        cout << records[i].teamA << " vs " << records[i].teamB << " -> " << records[i].winner << endl;
+                    }
+                }
+                delete[] records;
                 break;
-            case 2:
+            }
+            case 2: {
                 cout << "Enter team name (e.g., Team01): ";
                 getline(cin, teamName);
-                displayTeamMatches(teamName);
+                MatchRecord* records = new MatchRecord[MAX_MATCH_RECORDS];
+                int count = core->getTeamMatches(teamName, records, MAX_MATCH_RECORDS);
+                if (count < 0) {
+                    cerr << "Failed to open result.csv" << endl;
+                } else {
+                    cout << "Matches for " << teamName << ":\n";
+                    for (int i = 0; i < count; i++) {
+                        cout << records[i].teamA << " vs " << records[i].teamB << " -> Winner: " << records[i].winner << endl;
+                    }
+                    if (count == 0) {
+                        cout << "No matches found for team " << teamName << "." << endl;
+                    }
+                }
+                delete[] records;
                 break;
-            case 3:
+            }
+            case 3: {
                 cout << "Enter team name (e.g., Team01): ";
                 getline(cin, teamName);
-                displayTeamStats(teamName);
+                TeamStats stats;
+                if (!core->getTeamStats(teamName, stats)) {
+                    cerr << "Failed to open result.csv" << endl;
+                    break;
+                }
+                cout << "Statistics for " << teamName << ":\n";
+                cout << "Total Matches: " << stats.totalMatches << endl;
+                cout << "Wins: " << stats.wins << endl;
+                cout << "Losses: " << stats.losses << endl;
+                if (stats.totalMatches > 0) {
+                    cout << fixed << setprecision(2) << "Win Rate: " << stats.winRate << "%" << endl;
+                } else {
+                    cout << "Win Rate: N/A (no matches played)" << endl;
+                }
                 break;
+            }
             case 4:
                 cout << "Returning to main menu...\n";
                 break;
@@ -352,64 +552,198 @@ void APUECIntegratedSystem::handleStatisticsMenu() {
     } while (choice != 4);
 }
 
+void APUECIntegratedSystem::handleTournamentControlMenu() {
+    int choice;
+    
+    do {
+        cout << "\n=== TOURNAMENT CONTROL CENTER ===\n";
+        cout << "Registration Active: " << (core->isRegistrationOpen() ? "YES" : "NO") << "\n";
+        cout << "Tournament Status: " << (core->isTournamentComplete() ? "COMPLETED" : "PENDING") << "\n";
+        cout << string(60, '-') << "\n";
+        cout << "1. Initialize Tournament (close registration)\n";
+        cout << "2. Start Tournament\n";
+        cout << "3. End Tournament\n";
+        cout << "4. Synchronize Data\n";
+        cout << "5. Validate System State\n";
+        cout << "6. Export All Data\n";
+        cout << "7. Back to Main Menu\n";
+        cout << "Choice: ";
+        cin >> choice;
+        cin.ignore();
+        
+        switch (choice) {
+            case 1: initializeTournament(); break;
+            case 2: startTournament(); break;
+            case 3: endTournament(); break;
+            case 4: synchronizeData(); break;
+            case 5: validateSystemState(); break;
+            case 6: exportAllData(); break;
+            case 7:
+                cout << "Returning to main menu...\n";
+                break;
+            default:
+                cout << "Invalid option!\n";
+        }
+        
+        if (choice != 7) waitForUserInput();
+        
+    } while (choice != 7);
+}
+
+void APUECIntegratedSystem::initializeTournament() {
+    cout << "\n=== INITIALIZE TOURNAMENT ===\n";
+    if (core->isRegistrationOpen()) {
+        CoreResult result = core->closeRegistration();
+        if (!result.ok) {
+            reportFailure(result);
+            return;
+        }
+    }
+    
+    const SystemState& state = core->getState();
+    cout << "Teams registered: " << state.getTeamCount()
+         << " (" << state.getWildcardTeamCount() << " wild card)\n";
+    cout << "Tournament teams: " << state.getSelectedTeamsFile() << "\n";
+    cout << "Players checked in: " << state.getCheckedInCount() << "/" << state.getPlayerCount() << "\n";
+    cout << "Tournament ready to start.\n";
+}
+
+void APUECIntegratedSystem::startTournament() {
+    TournamentResult result = core->runTournament();
+    if (!result.ok) {
+        cout << "Error: " << result.message << "\n";
+        return;
+    }
+    cout << "\nTournament complete: " << result.champion << " wins after "
+         << result.matchesPlayed << " matches.\n";
+}
+
+void APUECIntegratedSystem::endTournament() {
+    CoreResult result = core->endTournament();
+    if (!result.ok) {
+        reportFailure(result);
+        return;
+    }
+    
+    const SystemState& state = core->getState();
+    TeamRecord record;
+    cout << "\n=== TOURNAMENT CLOSED ===\n";
+    cout << "Champion: " << state.getChampion();
+    if (state.findTeam(state.getChampion(), record)) {
+        cout << " (" << record.wins << " wins, " << record.losses << " losses)";
+    }
+    cout << "\n";
+    cout << "Matches played: " << state.getMatchesPlayed() << "\n";
+    cout << "Spectators seated: " << state.getSeatedCount() << ", still waiting: " << state.getWaitingCount() << "\n";
+    cout << "Spectator registration is now closed.\n";
+}
+
+void APUECIntegratedSystem::synchronizeData() {
+    vector<string> corrections = core->synchronize();
+    
+    cout << "\n=== DATA SYNCHRONIZATION ===\n";
+    cout << "Module change events applied: " << core->getState().getEventsApplied() << "\n";
+    if (corrections.empty()) {
+        cout << "All counters match module state.\n";
+        return;
+    }
+    for (size_t i = 0; i < corrections.size(); i++) {
+        cout << "Corrected - " << corrections[i] << "\n";
+    }
+}
+
+void APUECIntegratedSystem::validateSystemState() {
+    vector<string> problems = core->validate();
+    
+    cout << "\n=== SYSTEM VALIDATION ===\n";
+    if (problems.empty()) {
+        cout << "All consistency checks passed.\n";
+        return;
+    }
+    for (size_t i = 0; i < problems.size(); i++) {
+        cout << "Problem: " << problems[i] << "\n";
+    }
+}
+
+void APUECIntegratedSystem::exportAllData() {
+    CoreResult result = core->exportAll();
+    if (!result.ok) {
+        reportFailure(result);
+        return;
+    }
+    cout << "Exported registration.csv, players.csv, spectators.csv, result.csv and\n"
+         << "system_state.csv to export/\n";
+}
+
 void APUECIntegratedSystem::generateSystemReport() {
-    cout << "\n" << string(70, '=') << "\n";
-    cout << "             APUEC SYSTEM COMPREHENSIVE REPORT\n";
-    cout << string(70, '=') << "\n";
+    // Built once, then shown and saved unchanged
+    ostringstream report;
+    report << "\n" << string(70, '=') << "\n";
+    report << "             APUEC SYSTEM COMPREHENSIVE REPORT\n";
+    report << string(70, '=') << "\n";
+    
+    SystemSummary summary = core->getSummary();
+    int totalSpectators = summary.waitingSpectators + summary.seatedSpectators;
     
     // Registration Statistics
-    cout << "\n--- REGISTRATION SUMMARY ---\n";
-    cout << "Total Teams Registered: " << totalRegisteredTeams << "\n";
-    cout << "Total Players Registered: " << totalRegisteredPlayers << "\n";
-    cout << "Total Spectators: " << totalSpectators << "\n";
+    report << "\n--- REGISTRATION SUMMARY ---\n";
+    report << "Total Teams Registered: " << summary.registeredTeams << "\n";
+    report << "Total Players Registered: " << summary.registeredPlayers
+           << " (" << summary.checkedInPlayers << " checked in, " << summary.wildcardPlayers << " wildcard)\n";
+    report << "Total Spectators: " << totalSpectators
+           << " (" << summary.seatedSpectators << " seated, " << summary.waitingSpectators << " waiting)\n";
+    if (!summary.champion.empty()) {
+        report << "Champion: " << summary.champion << " (" << summary.matchesPlayed << " matches)\n";
+    }
     
     // System Status
-    cout << "\n--- SYSTEM STATUS ---\n";
-    cout << "Team Registration: " << (isRegistrationActive ? "OPEN" : "CLOSED") << "\n";
-    cout << "Tournament: " << (isTournamentActive ? "COMPLETED" : "PENDING") << "\n";
-    cout << "Spectator System: " << (isSpectatorSystemActive ? "ACTIVE" : "INACTIVE") << "\n";
+    report << "\n--- SYSTEM STATUS ---\n";
+    report << "Team Registration: " << (summary.registrationOpen ? "OPEN" : "CLOSED") << "\n";
+    report << "Tournament: " << (summary.tournamentComplete ? "COMPLETED" : "PENDING") << "\n";
+    report << "Spectator System: " << (summary.spectatorSystemActive ? "ACTIVE" : "INACTIVE") << "\n";
     
     // Data Structures Used
-    cout << "\n--- DATA STRUCTURES IMPLEMENTATION ---\n";
-    cout << "Task 1 (Match Scheduling):\n";
-    cout << "  - Stack: Knockout round management\n";
-    cout << "  - Queue: Match progression\n";
-    cout << "  - Priority Queue: Team seeding\n";
-    cout << "  - Circular Queue: Group stage rotation\n";
+    report << "\n--- DATA STRUCTURES IMPLEMENTATION ---\n";
+    report << "Task 1 (Match Scheduling):\n";
+    report << "  - Stack: Knockout round management\n";
+    report << "  - Queue: Match progression\n";
+    report << "  - Priority Queue: Team seeding\n";
+    report << "  - Circular Queue: Group stage rotation\n";
     
-    cout << "\nTask 2 (Registration):\n";
-    cout << "  - Queue: Team/Player registration order\n";
-    cout << "  - Stack: Wildcard entries (LIFO)\n";
-    cout << "  - Priority Queue: Early bird prioritization\n";
-    cout << "  - Circular Queue: Check-in processing\n";
+    report << "\nTask 2 (Registration):\n";
+    report << "  - Queue: Team/Player registration order\n";
+    report << "  - Stack: Wildcard entries (LIFO)\n";
+    report << "  - Priority Queue: Early bird prioritization\n";
+    report << "  - Circular Queue: Check-in processing\n";
     
-    cout << "\nTask 3 (Spectator Management):\n";
-    cout << "  - Priority Queue: VIP/Influencer/General prioritization\n";
-    cout << "  - Max Heap Implementation: Efficient priority processing\n";
+    report << "\nTask 3 (Spectator Management):\n";
+    report << "  - Priority Queue: VIP/Influencer/General prioritization\n";
+    report << "  - Max Heap Implementation: Efficient priority processing\n";
     
-    cout << "\nTask 4 (Statistics):\n";
-    cout << "  - Stack: Recent match history (LIFO access)\n";
-    cout << "  - Template Stack: Generic match record storage\n";
+    report << "\nTask 4 (Statistics):\n";
+    report << "  - Stack: Recent match history (LIFO access)\n";
+    report << "  - Template Stack: Generic match record storage\n";
     
     // Performance Metrics
-    cout << "\n--- SYSTEM PERFORMANCE ---\n";
-    cout << "Priority Queue Operations: O(log n) efficiency\n";
-    cout << "Stack Operations: O(1) efficiency\n";
-    cout << "Queue Operations: O(1) efficiency\n";
-    cout << "Memory Management: Dynamic allocation used\n";
+    report << "\n--- SYSTEM PERFORMANCE (measured) ---\n";
+    core->getMetrics().writeReport(report);
     
-    cout << "\n" << string(70, '=') << "\n";
+    report << "\n" << string(70, '=') << "\n";
+    cout << report.str();
     
-    // Save report to file
+    // Save report and machine-readable metrics
     ofstream reportFile("APUEC_System_Report.txt");
     if (reportFile.is_open()) {
-        reportFile << "APUEC System Report Generated\n";
-        reportFile << "Teams: " << totalRegisteredTeams << "\n";
-        reportFile << "Players: " << totalRegisteredPlayers << "\n";
-        reportFile << "Spectators: " << totalSpectators << "\n";
+        reportFile << report.str();
         reportFile.close();
         cout << "Report saved to APUEC_System_Report.txt\n";
     }
+    ofstream metricsFile("APUEC_Metrics.json");
+    if (metricsFile.is_open()) {
+        core->getMetrics().writeJson(metricsFile);
+        metricsFile.close();
+        cout << "Metrics saved to APUEC_Metrics.json\n";
+    }
 }
 
 void APUECIntegratedSystem::waitForUserInput() {
@@ -445,11 +779,7 @@ void APUECIntegratedSystem::runSystem() {
                 handleStatisticsMenu();
                 break;
             case 6:
-                cout << "\n=== TOURNAMENT CONTROL CENTER ===\n";
-                cout << "Registration Active: " << (isRegistrationActive ? "YES" : "NO") << "\n";
-                cout << "Tournament Status: " << (isTournamentActive ? "COMPLETED" : "PENDING") << "\n";
-                cout << "Use individual menus to control each subsystem.\n";
-                waitForUserInput();
+                handleTournamentControlMenu();
                 break;
             case 7:
                 generateSystemReport();
@@ -1,41 +1,26 @@
 #ifndef APUEC_INTEGRATED_SYSTEM_HPP
 #define APUEC_INTEGRATED_SYSTEM_HPP
 
-// Include all individual task headers
-#include "spectator_manager.hpp"
-#include "MatchScheduler.hpp"
-#include "RegistrationManager.hpp"
-#include "RegistrationSystem.hpp"
-#include "Statistic.hpp"
+// Tournament engine (all task modules)
+#include "apuec_core.hpp"
 #include <iostream>
 #include <string>
 
 using namespace std;
 
-// Integrated System Class
+// Interactive front end: reads menu choices and input from cin, calls
+// APUECCore and prints the results.
 class APUECIntegratedSystem {
 private:
-    // Task managers
-    SpectatorManager* spectatorSystem;      // Task 3: Spectator Management
-    MatchScheduler* matchScheduler;         // Task 1: Match Scheduling
-    RegistrationManager* teamRegistration;  // Task 2: Team Registration
-    RegistrationSystem* playerRegistration; // Task 2: Player Registration
-    
-    // System state
-    bool isRegistrationActive;
-    bool isTournamentActive;
-    bool isSpectatorSystemActive;
-    
-    // System statistics
-    int totalRegisteredTeams;
-    int totalRegisteredPlayers;
-    int totalSpectators;
+    APUECCore* core;
     
     // Helper functions
     void displaySystemHeader();
     void displaySystemStatus();
     void displayTaskCredits();
     void waitForUserInput();
+    static void reportFailure(const CoreResult& result);
+    static string spectatorTypeFromChoice(int choice);     // "" if invalid
 
 public:
     // Constructor and Destructor
@@ -52,6 +37,7 @@ public:
     void handleSpectatorManagementMenu();   // Task 3: Spectator Management
     void handleMatchSchedulingMenu();       // Task 1: Match Scheduling
     void handleStatisticsMenu();           // Task 4: Statistics & History
+    void handleTournamentControlMenu();    // Lifecycle, sync and export
     
     // System management
     void initializeTournament();
@@ -0,0 +1,19 @@
+#ifndef APUEC_OUTPUT_HPP
+#define APUEC_OUTPUT_HPP
+
+#include <ostream>
+using namespace std;
+
+// Modules write their progress messages through an ostream pointer so the
+// engine can run without a terminal. A null pointer selects this sink,
+// which is always in a failed state and therefore skips formatting.
+inline ostream& discardOutput() {
+    static ostream sink(nullptr);
+    return sink;
+}
+
+inline ostream* outputOrDiscard(ostream* output) {
+    return output ? output : &discardOutput();
+}
+
+#endif
@@ -0,0 +1,423 @@
+#include "apuec_server.hpp"
+#include "apuec_trace.hpp"
+#include <sstream>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const int SERVER_READ_CHUNK = 65536;         // Bytes per read() call
+static const int SERVER_READS_PER_EVENT = 4;        // Bound work per wakeup
+static const size_t MAX_REQUEST_LINE = 65536;       // Longer lines close the connection
+static const size_t OUTPUT_HIGH_WATER = 1 << 20;    // Stop reading above this backlog
+static const int SERVER_MAX_EVENTS = 64;
+static const int SERVER_MAX_WORKERS = 256;          // Each worker owns an epoll fd and a thread
+
+struct ApuecServer::Connection {
+    int fd;
+    string input;               // Bytes not yet forming a complete line
+    string output;              // Responses not yet written
+    size_t outputSent;
+    bool peerClosed;            // Read side reached EOF
+    bool closeAfterFlush;       // "quit" or protocol error
+    unsigned int interest;      // Events currently registered with epoll
+    Connection* prev;
+    Connection* next;
+};
+
+// Tokenized request lines of one read, reused across reads
+struct ServerRequest {
+    vector<string> args;
+    bool valid;
+};
+
+ApuecServer::ApuecServer(APUECCore* engine, int workerThreads)
+    : core(engine), processor(engine), listenCount(0), requests(0) {
+    int count = workerThreads > 0 ? workerThreads : 1;
+    if (count > SERVER_MAX_WORKERS) count = SERVER_MAX_WORKERS;
+    workerCount = count;
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    workers = new Worker[count];
+    for (int i = 0; i < count; i++) {
+        Worker& worker = workers[i];
+        worker.server = this;
+        worker.connections = nullptr;
+        worker.epollFd = epoll_create1(EPOLL_CLOEXEC);
+        worker.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = &worker;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, worker.wakeFd, &event);
+        event.data.ptr = nullptr;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, stopFd, &event);
+    }
+}
+
+ApuecServer::~ApuecServer() {
+    for (int i = 0; i < listenCount; i++) {
+        close(listenFds[i]);
+    }
+    if (!socketPath.empty()) {
+        unlink(socketPath.c_str());
+    }
+    for (int i = 0; i < workerCount; i++) {
+        close(workers[i].epollFd);
+        close(workers[i].wakeFd);
+        for (size_t j = 0; j < workers[i].pending.size(); j++) {
+            close(workers[i].pending[j]);
+        }
+    }
+    delete[] workers;
+    close(stopFd);
+}
+
+bool ApuecServer::listenUnix(const string& path) {
+    if (listenCount >= 2) return false;
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+
+    unlink(path.c_str());   // Stale socket from an earlier run
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return false;
+    }
+
+    listenFds[listenCount++] = fd;
+    socketPath = path;
+    return true;
+}
+
+bool ApuecServer::listenTcp(int port) {
+    if (listenCount >= 2) return false;
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((unsigned short)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return false;
+    }
+
+    listenFds[listenCount++] = fd;
+    return true;
+}
+
+void ApuecServer::stop() {
+    uint64_t one = 1;
+    ssize_t ignored = write(stopFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void ApuecServer::run() {
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event;
+    event.events = EPOLLIN;
+    for (int i = 0; i < listenCount; i++) {
+        event.data.u32 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFds[i], &event);
+    }
+    event.data.u32 = 2;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event);
+
+    for (int i = 0; i < workerCount; i++) {
+        Worker* worker = &workers[i];
+        worker->loop = thread([this, worker, i]() {
+            Tracer::setThreadName("server worker " + to_string(i));
+            workerLoop(*worker);
+        });
+    }
+
+    int nextWorker = 0;
+    bool stopping = false;
+    epoll_event events[4];
+    while (!stopping) {
+        int count = epoll_wait(epollFd, events, 4, -1);
+        if (count < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.u32 == 2) {
+                stopping = true;
+            } else {
+                acceptConnections(listenFds[events[i].data.u32], nextWorker);
+            }
+        }
+    }
+
+    stop();     // Make sure workers see the stop event if epoll failed
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].loop.join();
+    }
+    close(epollFd);
+}
+
+void ApuecServer::acceptConnections(int listenFd, int& nextWorker) {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;     // EAGAIN, or out of descriptors until a client leaves
+
+        // Responses are small and pipelined; do not wait to coalesce them
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        Worker& worker = workers[nextWorker];
+        nextWorker = (nextWorker + 1) % workerCount;
+        {
+            lock_guard<mutex> guard(worker.pendingLock);
+            worker.pending.push_back(fd);
+        }
+        uint64_t one = 1;
+        ssize_t ignored = write(worker.wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void ApuecServer::registerPending(Worker& worker) {
+    uint64_t counter;
+    ssize_t ignored = read(worker.wakeFd, &counter, sizeof(counter));
+    (void)ignored;
+
+    vector<int> fds;
+    {
+        lock_guard<mutex> guard(worker.pendingLock);
+        fds.swap(worker.pending);
+    }
+
+    for (size_t i = 0; i < fds.size(); i++) {
+        Connection* conn = new Connection();
+        conn->fd = fds[i];
+        conn->outputSent = 0;
+        conn->peerClosed = false;
+        conn->closeAfterFlush = false;
+        conn->interest = EPOLLIN | EPOLLRDHUP;
+        conn->prev = nullptr;
+        conn->next = worker.connections;
+        if (worker.connections) worker.connections->prev = conn;
+        worker.connections = conn;
+
+        epoll_event event;
+        event.events = conn->interest;
+        event.data.ptr = conn;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, conn->fd, &event);
+    }
+}
+
+void ApuecServer::workerLoop(Worker& worker) {
+    epoll_event events[SERVER_MAX_EVENTS];
+    bool stopping = false;
+
+    while (!stopping) {
+        int count = epoll_wait(worker.epollFd, events, SERVER_MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            void* tag = events[i].data.ptr;
+            if (tag == nullptr) {
+                stopping = true;
+                continue;
+            }
+            if (tag == &worker) {
+                registerPending(worker);
+                continue;
+            }
+
+            Connection* conn = (Connection*)tag;
+            unsigned int ready = events[i].events;
+            if (ready & EPOLLERR) {
+                closeConnection(worker, conn);
+                continue;
+            }
+            if ((ready & (EPOLLIN | EPOLLHUP | EPOLLRDHUP)) && !conn->peerClosed) {
+                handleRead(worker, conn);
+            }
+            if (!flush(worker, conn)) {
+                closeConnection(worker, conn);
+                continue;
+            }
+
+            bool drained = conn->outputSent == conn->output.size();
+            if ((conn->peerClosed || conn->closeAfterFlush) && drained) {
+                closeConnection(worker, conn);
+            } else {
+                updateInterest(worker, conn);
+            }
+        }
+    }
+
+    while (worker.connections) {
+        closeConnection(worker, worker.connections);
+    }
+}
+
+void ApuecServer::handleRead(Worker& worker, Connection* conn) {
+    char buffer[SERVER_READ_CHUNK];
+    for (int reads = 0; reads < SERVER_READS_PER_EVENT; reads++) {
+        ssize_t received = read(conn->fd, buffer, sizeof(buffer));
+        if (received > 0) {
+            conn->input.append(buffer, received);
+            if (received < (ssize_t)sizeof(buffer)) break;
+        } else if (received == 0) {
+            conn->peerClosed = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                conn->peerClosed = true;
+            }
+            break;
+        }
+    }
+    processInput(conn);
+}
+
+void ApuecServer::processInput(Connection* conn) {
+    if (conn->closeAfterFlush) {
+        conn->input.clear();
+        return;
+    }
+
+    // Tokenize every complete line outside the engine lock
+    static thread_local vector<ServerRequest> batch;
+    size_t count = 0;
+    size_t start = 0;
+    size_t newline;
+    string line;
+    while ((newline = conn->input.find('\n', start)) != string::npos) {
+        if (count == batch.size()) {
+            batch.push_back(ServerRequest());
+        }
+        line.assign(conn->input, start, newline - start);
+        batch[count].valid = CommandProcessor::tokenize(line, batch[count].args);
+        count++;
+        start = newline + 1;
+    }
+    conn->input.erase(0, start);
+
+    if (conn->input.size() > MAX_REQUEST_LINE) {
+        conn->output += "ERR request line too long\n";
+        conn->closeAfterFlush = true;
+        conn->input.clear();
+    }
+    if (count == 0) {
+        return;
+    }
+
+    static thread_local ostringstream commandOutput;
+    string error;
+    {
+        APUEC_TRACE_SCOPE("ApuecServer::commandBatch");    // Includes waiting for coreLock
+        lock_guard<mutex> guard(coreLock);
+        for (size_t i = 0; i < count && !conn->closeAfterFlush; i++) {
+            const vector<string>& args = batch[i].args;
+            if (!batch[i].valid) {
+                conn->output += "ERR unterminated quote\n";
+                continue;
+            }
+            if (args.empty() || args[0] == "ping") {
+                conn->output += "OK 0\n";
+                continue;
+            }
+            if (args[0] == "quit") {
+                conn->output += "OK 0\n";
+                conn->closeAfterFlush = true;
+                continue;
+            }
+
+            commandOutput.str("");
+            if (processor.execute(args, commandOutput, error)) {
+                string text = commandOutput.str();
+                int lines = 0;
+                for (size_t j = 0; j < text.size(); j++) {
+                    if (text[j] == '\n') lines++;
+                }
+                conn->output += "OK " + to_string(lines) + "\n";
+                conn->output += text;
+            } else {
+                conn->output += "ERR " + error + "\n";
+            }
+        }
+    }
+    requests += count;
+}
+
+bool ApuecServer::flush(Worker& worker, Connection* conn) {
+    while (conn->outputSent < conn->output.size()) {
+        ssize_t sent = send(conn->fd, conn->output.data() + conn->outputSent,
+                            conn->output.size() - conn->outputSent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            conn->outputSent += sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+    conn->output.clear();
+    conn->outputSent = 0;
+    return true;
+}
+
+void ApuecServer::updateInterest(Worker& worker, Connection* conn) {
+    size_t backlog = conn->output.size() - conn->outputSent;
+    unsigned int wanted = 0;
+    if (!conn->peerClosed && !conn->closeAfterFlush && backlog < OUTPUT_HIGH_WATER) {
+        wanted |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (backlog > 0) {
+        wanted |= EPOLLOUT;
+    }
+    if (wanted == conn->interest) return;
+
+    epoll_event event;
+    event.events = wanted;
+    event.data.ptr = conn;
+    epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, conn->fd, &event);
+    conn->interest = wanted;
+}
+
+void ApuecServer::closeConnection(Worker& worker, Connection* conn) {
+    epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, conn->fd, nullptr);
+    close(conn->fd);
+
+    if (conn->prev) conn->prev->next = conn->next;
+    else worker.connections = conn->next;
+    if (conn->next) conn->next->prev = conn->prev;
+
+    delete conn;
+}
@@ -0,0 +1,74 @@
+#ifndef APUEC_SERVER_HPP
+#define APUEC_SERVER_HPP
+
+#include "command_processor.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Local RPC front end for APUECCore.
+// Speaks the CommandProcessor line protocol over a Unix domain socket
+// and/or a TCP port bound to 127.0.0.1. Every request line gets exactly
+// one response: "OK <n>" followed by n output lines, or "ERR <reason>".
+// Clients may pipeline requests; responses come back in request order.
+//
+// The accepting thread hands connections round-robin to a pool of
+// workers, each running its own epoll loop. A worker executes all
+// complete lines of a read under one acquisition of the engine lock, so
+// pipelined requests share the locking cost.
+class ApuecServer {
+private:
+    struct Connection;
+
+    struct Worker {
+        ApuecServer* server;
+        int epollFd;
+        int wakeFd;                 // eventfd signalled when pending has fds
+        mutex pendingLock;
+        vector<int> pending;        // Accepted sockets not yet registered
+        Connection* connections;    // Open connections (intrusive list)
+        thread loop;
+    };
+
+    APUECCore* core;
+    CommandProcessor processor;
+    mutex coreLock;                 // Serializes all engine access
+    int listenFds[2];
+    int listenCount;
+    string socketPath;              // Unlinked on shutdown
+    int stopFd;                     // eventfd, readable once stop() is called
+    Worker* workers;
+    int workerCount;
+    atomic<long long> requests;
+
+    void workerLoop(Worker& worker);
+    void acceptConnections(int listenFd, int& nextWorker);
+    void registerPending(Worker& worker);
+    void handleRead(Worker& worker, Connection* conn);
+    void processInput(Connection* conn);
+    bool flush(Worker& worker, Connection* conn);
+    void updateInterest(Worker& worker, Connection* conn);
+    void closeConnection(Worker& worker, Connection* conn);
+
+    // Disable copying (owns sockets and threads)
+    ApuecServer(const ApuecServer&);
+    ApuecServer& operator=(const ApuecServer&);
+
+public:
+    ApuecServer(APUECCore* engine, int workerThreads = 4);
+    ~ApuecServer();
+
+    bool listenUnix(const string& path);
+    bool listenTcp(int port);               // Loopback only
+
+    void run();                             // Serve until stop()
+    void stop();                            // Async-signal-safe
+
+    long long getRequestCount() const { return requests.load(); }
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "apuec_trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+// One finished span
+struct TraceEvent {
+    const char* name;
+    long long startNanos;
+    long long durationNanos;
+};
+
+// Spans of one thread. Only the owning thread appends; count is
+// published with release so an exporter sees complete events only.
+struct TraceBuffer {
+    int threadId;
+    string threadName;              // Guarded by registryLock
+    atomic<int> count;
+    atomic<long long> dropped;
+    TraceEvent events[TRACE_BUFFER_EVENTS];
+
+    TraceBuffer(int id) : threadId(id), count(0), dropped(0) {}
+};
+
+static atomic<bool> tracingEnabled(false);
+static mutex registryLock;
+static vector<TraceBuffer*> registry;     // Kept for the process lifetime, so exports see exited threads
+static thread_local TraceBuffer* localBuffer = nullptr;    // Created by the thread's first span
+static thread_local string localThreadName;
+static const chrono::steady_clock::time_point traceOrigin = chrono::steady_clock::now();
+
+#ifdef APUEC_TRACING
+static long long traceNow() {
+    // +1 keeps 0 free as the "not recording" marker in TraceSpan
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - traceOrigin).count() + 1;
+}
+
+static TraceBuffer* threadBuffer() {
+    if (localBuffer == nullptr) {
+        lock_guard<mutex> guard(registryLock);
+        localBuffer = new TraceBuffer((int)registry.size() + 1);
+        localBuffer->threadName = localThreadName;
+        registry.push_back(localBuffer);
+    }
+    return localBuffer;
+}
+#endif
+
+static void writeJsonString(ostream& os, const string& text) {
+    os << '"';
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if ((unsigned char)c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+            os << escaped;
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+// Nanoseconds as the microseconds Chrome expects, without float rounding
+static void writeMicros(ostream& os, long long nanos) {
+    char text[32];
+    snprintf(text, sizeof(text), "%lld.%03lld", nanos / 1000, nanos % 1000);
+    os << text;
+}
+
+// ===== Tracer =====
+
+bool Tracer::isCompiledIn() {
+#ifdef APUEC_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Tracer::enable(bool on) {
+    tracingEnabled.store(on && isCompiledIn(), memory_order_relaxed);
+}
+
+bool Tracer::isEnabled() {
+    return tracingEnabled.load(memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const string& name) {
+    localThreadName = name;
+    if (localBuffer != nullptr) {
+        lock_guard<mutex> guard(registryLock);
+        localBuffer->threadName = name;
+    }
+}
+
+void Tracer::writeChromeTrace(ostream& os) {
+    lock_guard<mutex> guard(registryLock);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (size_t b = 0; b < registry.size(); b++) {
+        const TraceBuffer* buffer = registry[b];
+        int count = buffer->count.load(memory_order_acquire);
+
+        string threadName = buffer->threadName.empty() ? "thread " + to_string(buffer->threadId)
+                                                       : buffer->threadName;
+        os << (first ? "\n" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+           << buffer->threadId << ",\"args\":{\"name\":";
+        writeJsonString(os, threadName);
+        os << "}}";
+        first = false;
+
+        for (int i = 0; i < count; i++) {
+            const TraceEvent& event = buffer->events[i];
+            os << ",\n{\"ph\":\"X\",\"name\":";
+            writeJsonString(os, event.name);
+            os << ",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            writeMicros(os, event.startNanos);
+            os << ",\"dur\":";
+            writeMicros(os, event.durationNanos);
+            os << "}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+bool Tracer::writeChromeTrace(const string& path) {
+    ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    writeChromeTrace(file);
+    file.close();
+    return !file.fail();
+}
+
+long long Tracer::getEventCount() {
+    lock_guard<mutex> guard(registryLock);
+    long long total = 0;
+    for (size_t i = 0; i < registry.size(); i++) {
+        total += registry[i]->count.load(memory_order_acquire);
+    }
+    return total;
+}
+
+long long Tracer::getDroppedCount() {
+    lock_guard<mutex> guard(registryLock);
+    long long total = 0;
+    for (size_t i = 0; i < registry.size(); i++) {
+        total += registry[i]->dropped.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+void Tracer::reset() {
+    lock_guard<mutex> guard(registryLock);
+    for (size_t i = 0; i < registry.size(); i++) {
+        registry[i]->count.store(0, memory_order_release);
+        registry[i]->dropped.store(0, memory_order_relaxed);
+    }
+}
+
+// ===== TraceSpan =====
+
+#ifdef APUEC_TRACING
+
+TraceSpan::TraceSpan(const char* spanName) : name(spanName), startNanos(0) {
+    if (tracingEnabled.load(memory_order_relaxed)) {
+        startNanos = traceNow();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (startNanos == 0) return;
+
+    long long endNanos = traceNow();
+    TraceBuffer* buffer = threadBuffer();
+    int count = buffer->count.load(memory_order_relaxed);
+    if (count >= TRACE_BUFFER_EVENTS) {
+        buffer->dropped.store(buffer->dropped.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        return;
+    }
+    TraceEvent& event = buffer->events[count];
+    event.name = name;
+    event.startNanos = startNanos;
+    event.durationNanos = endNanos - startNanos;
+    buffer->count.store(count + 1, memory_order_release);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef APUEC_TRACE_HPP
+#define APUEC_TRACE_HPP
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// Scoped trace spans for hot paths, exported as Chrome trace JSON
+// (chrome://tracing, Perfetto).
+//
+// Spans are compiled in only when APUEC_TRACING is defined (CMake option
+// APUEC_TRACING); otherwise APUEC_TRACE_SCOPE expands to nothing. When
+// compiled in, a span costs one relaxed load while tracing is switched
+// off, and two clock reads plus a store into the calling thread's own
+// buffer while it is on. Buffers are fixed size and never locked; events
+// past TRACE_BUFFER_EVENTS per thread are counted as dropped.
+//
+//   void MatchScheduler::knockoutRound(int& numTeams) {
+//       APUEC_TRACE_SCOPE("MatchScheduler::knockoutRound");
+//       ...
+
+const int TRACE_BUFFER_EVENTS = 1 << 16;
+
+// Process-wide trace control. Available in every build; without
+// APUEC_TRACING nothing is ever recorded and the exported trace is empty.
+class Tracer {
+public:
+    static bool isCompiledIn();
+    static void enable(bool on);
+    static bool isEnabled();
+
+    // Name shown for the calling thread in the trace viewer
+    static void setThreadName(const string& name);
+
+    // Write every recorded span as {"traceEvents":[...]}. Safe while
+    // other threads keep tracing; their newest spans may be left out.
+    static void writeChromeTrace(ostream& os);
+    static bool writeChromeTrace(const string& path);
+
+    static long long getEventCount();
+    static long long getDroppedCount();
+
+    // Forget recorded spans; only call while no spans are being recorded
+    static void reset();
+};
+
+#ifdef APUEC_TRACING
+
+// Records one complete event from construction to destruction. name
+// must outlive the trace (a string literal).
+class TraceSpan {
+private:
+    const char* name;
+    long long startNanos;   // 0 = tracing was off when the span opened
+
+    TraceSpan(const TraceSpan&);
+    TraceSpan& operator=(const TraceSpan&);
+
+public:
+    explicit TraceSpan(const char* spanName);
+    ~TraceSpan();
+};
+
+#define APUEC_TRACE_CONCAT_(a, b) a##b
+#define APUEC_TRACE_CONCAT(a, b) APUEC_TRACE_CONCAT_(a, b)
+#define APUEC_TRACE_SCOPE(name) TraceSpan APUEC_TRACE_CONCAT(traceSpan_, __LINE__)(name)
+
+#else
+
+#define APUEC_TRACE_SCOPE(name) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+#include "batch_runner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+typedef chrono::steady_clock Clock;
+
+BatchRunner::BatchRunner(APUECCore* engine, bool reportTiming, ostream& output, ostream& errors)
+    : processor(engine), out(output), err(errors), timing(reportTiming), executed(0), failed(0) {}
+
+void BatchRunner::fail(int lineNumber, const string& message) {
+    err << "line " << lineNumber << ": " << message << "\n";
+}
+
+int BatchRunner::runFile(const string& filename) {
+    ifstream script(filename);
+    if (!script.is_open()) {
+        err << "Cannot open batch file " << filename << "\n";
+        return -1;
+    }
+    return run(script);
+}
+
+int BatchRunner::run(istream& script) {
+    string line;
+    string error;
+    vector<string> args;
+    int lineNumber = 0;
+
+    Clock::time_point start = Clock::now();
+    while (getline(script, line)) {
+        lineNumber++;
+        if (!CommandProcessor::tokenize(line, args)) {
+            fail(lineNumber, "unterminated quote");
+            failed++;
+            continue;
+        }
+        if (args.empty()) continue;
+
+        Clock::time_point begin = Clock::now();
+        bool ok = processor.execute(args, out, error);
+        long long nanos = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - begin).count();
+
+        executed++;
+        if (!ok) {
+            fail(lineNumber, error);
+            failed++;
+        }
+        if (timing) {
+            recordTiming(CommandProcessor::commandKey(args), nanos);
+        }
+    }
+    double seconds = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count() / 1e9;
+
+    out << "Batch complete: " << executed << " command(s), " << failed << " failed, "
+        << fixed << setprecision(3) << seconds << " s\n";
+    if (timing) {
+        printTimings();
+    }
+    return failed;
+}
+
+void BatchRunner::recordTiming(const string& command, long long nanos) {
+    for (size_t i = 0; i < timings.size(); i++) {
+        if (timings[i].command == command) {
+            timings[i].samples.push_back(nanos);
+            return;
+        }
+    }
+    CommandTiming entry;
+    entry.command = command;
+    entry.samples.push_back(nanos);
+    timings.push_back(entry);
+}
+
+void BatchRunner::printTimings() const {
+    out << "\n" << left << setw(22) << "Command"
+        << right << setw(8) << "Count"
+        << setw(12) << "mean (us)"
+        << setw(12) << "p50 (us)"
+        << setw(12) << "p99 (us)"
+        << setw(12) << "max (us)" << "\n";
+    out << string(78, '-') << "\n";
+
+    for (size_t i = 0; i < timings.size(); i++) {
+        vector<long long> samples = timings[i].samples;
+        sort(samples.begin(), samples.end());
+
+        long long total = 0;
+        for (size_t j = 0; j < samples.size(); j++) total += samples[j];
+        size_t p99 = (size_t)ceil(0.99 * samples.size());
+        if (p99 > 0) p99--;
+
+        out << left << setw(22) << timings[i].command
+            << right << setw(8) << samples.size()
+            << fixed << setprecision(2)
+            << setw(12) << total / 1000.0 / samples.size()
+            << setw(12) << samples[(samples.size() - 1) / 2] / 1000.0
+            << setw(12) << samples[p99] / 1000.0
+            << setw(12) << samples.back() / 1000.0 << "\n";
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include "command_processor.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Runs a command script (see CommandProcessor for the syntax) against
+// APUECCore without prompts. Failures are reported with their line
+// number on the error stream and do not stop the run.
+class BatchRunner {
+private:
+    // Latency samples of one command kind, in nanoseconds
+    struct CommandTiming {
+        string command;
+        vector<long long> samples;
+    };
+
+    CommandProcessor processor;
+    ostream& out;
+    ostream& err;
+    bool timing;
+    vector<CommandTiming> timings;
+    int executed;
+    int failed;
+
+    void fail(int lineNumber, const string& message);
+    void recordTiming(const string& command, long long nanos);
+    void printTimings() const;
+
+    // Disable copying
+    BatchRunner(const BatchRunner&);
+    BatchRunner& operator=(const BatchRunner&);
+
+public:
+    BatchRunner(APUECCore* engine, bool reportTiming = false,
+                ostream& output = cout, ostream& errors = cerr);
+
+    int run(istream& script);                   // Returns the number of failed commands
+    int runFile(const string& filename);        // -1 if the file cannot be opened
+
+    int getExecuted() const { return executed; }
+    int getFailed() const { return failed; }
+};
+
+#endif
@@ -0,0 +1,268 @@
+#include "binary_snapshot.hpp"
+#include "data_export.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The file layout is the in-memory layout, so it must not drift silently
+static_assert(sizeof(SnapshotString) == 8, "snapshot layout changed");
+static_assert(sizeof(SnapshotSection) == 24, "snapshot layout changed");
+static_assert(sizeof(SnapshotHeader) == 176, "snapshot layout changed");
+static_assert(sizeof(SnapshotTeam) == 16, "snapshot layout changed");
+static_assert(sizeof(SnapshotPlayer) == 24, "snapshot layout changed");
+static_assert(sizeof(SnapshotSpectator) == 32, "snapshot layout changed");
+static_assert(sizeof(SnapshotMatch) == 24, "snapshot layout changed");
+
+static const char SNAPSHOT_MAGIC[8] = { 'A', 'P', 'U', 'E', 'C', 'S', 'N', 'P' };
+static const size_t SNAPSHOT_ALIGN = 8;
+
+static const uint32_t RECORD_SIZES[SECTION_COUNT] = {
+    1,
+    sizeof(SnapshotTeam),
+    sizeof(SnapshotPlayer),
+    sizeof(SnapshotSpectator),
+    sizeof(SnapshotMatch)
+};
+
+// FNV-1a, 64 bit
+static uint64_t checksum(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// ===== SnapshotBuilder =====
+
+SnapshotBuilder::SnapshotBuilder() {
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+}
+
+SnapshotString SnapshotBuilder::addString(const string& text) {
+    SnapshotString ref;
+    ref.offset = (uint32_t)strings.size();
+    ref.length = (uint32_t)text.size();
+    strings += text;
+    return ref;
+}
+
+void SnapshotBuilder::setSeatCapacity(const int capacity[3]) {
+    for (int i = 0; i < 3; i++) {
+        header.seatCapacity[i] = capacity[i];
+    }
+}
+
+void SnapshotBuilder::addTeam(const string& name, const string& status) {
+    SnapshotTeam team;
+    team.name = addString(name);
+    team.status = addString(status);
+    teams.push_back(team);
+}
+
+void SnapshotBuilder::addPlayer(const string& name, const string& playerID, bool earlyBird, bool wildcard,
+                                bool checkedIn) {
+    SnapshotPlayer player;
+    memset(&player, 0, sizeof(player));
+    player.name = addString(name);
+    player.playerID = addString(playerID);
+    player.earlyBird = earlyBird;
+    player.wildcard = wildcard;
+    player.checkedIn = checkedIn;
+    players.push_back(player);
+}
+
+void SnapshotBuilder::addSpectator(const string& name, const string& email, int type, int arrivalTime,
+                                   int seatId) {
+    SnapshotSpectator spectator;
+    memset(&spectator, 0, sizeof(spectator));
+    spectator.name = addString(name);
+    spectator.email = addString(email);
+    spectator.arrivalTime = arrivalTime;
+    spectator.seatId = seatId;
+    spectator.type = (uint8_t)type;
+    spectators.push_back(spectator);
+}
+
+void SnapshotBuilder::addMatch(const string& teamA, const string& teamB, const string& winner) {
+    SnapshotMatch match;
+    match.teamA = addString(teamA);
+    match.teamB = addString(teamB);
+    match.winner = addString(winner);
+    matches.push_back(match);
+}
+
+// Append one section to the image and record where it went
+static void appendSection(string& image, SnapshotSection& section, const void* data, size_t count,
+                          uint32_t recordSize) {
+    image.resize((image.size() + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN, '\0');
+    section.offset = image.size();
+    section.count = count;
+    section.recordSize = recordSize;
+    section.reserved = 0;
+    image.append((const char*)data, count * recordSize);
+}
+
+bool SnapshotBuilder::write(const string& path, string& error) {
+    if (strings.size() > UINT32_MAX) {
+        error = "Snapshot string pool exceeds 4 GB";
+        return false;
+    }
+
+    string image(sizeof(SnapshotHeader), '\0');
+    appendSection(image, header.sections[SECTION_TEAMS], teams.data(), teams.size(), sizeof(SnapshotTeam));
+    appendSection(image, header.sections[SECTION_PLAYERS], players.data(), players.size(),
+                  sizeof(SnapshotPlayer));
+    appendSection(image, header.sections[SECTION_SPECTATORS], spectators.data(), spectators.size(),
+                  sizeof(SnapshotSpectator));
+    appendSection(image, header.sections[SECTION_MATCHES], matches.data(), matches.size(), sizeof(SnapshotMatch));
+    appendSection(image, header.sections[SECTION_STRINGS], strings.data(), strings.size(), 1);
+
+    header.fileSize = image.size();
+    header.checksum = checksum(image.data() + sizeof(SnapshotHeader), image.size() - sizeof(SnapshotHeader));
+    memcpy(&image[0], &header, sizeof(header));
+
+    string tempPath = path + ".tmp";
+    if (!writeFileDurably(tempPath, image, error)) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    if (rename(tempPath.c_str(), path.c_str()) != 0) {
+        error = path + ": " + strerror(errno);
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ===== SnapshotView =====
+
+SnapshotView::SnapshotView() : base(nullptr), size(0), header(nullptr) {}
+
+SnapshotView::~SnapshotView() {
+    close();
+}
+
+void SnapshotView::close() {
+    if (base != nullptr) {
+        munmap((void*)base, size);
+    }
+    base = nullptr;
+    size = 0;
+    header = nullptr;
+}
+
+bool SnapshotView::open(const string& path, string& error) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = path + ": " + strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = path + ": " + strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    if ((size_t)info.st_size < sizeof(SnapshotHeader)) {
+        error = path + ": too short for a snapshot";
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        error = path + ": " + strerror(errno);
+        return false;
+    }
+    base = (const char*)mapping;
+    size = (size_t)info.st_size;
+    header = (const SnapshotHeader*)base;
+
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        error = path + ": not a snapshot file";
+    } else if (header->byteOrder != SNAPSHOT_BYTE_ORDER) {
+        error = path + ": written with a different byte order";
+    } else if (header->version != SNAPSHOT_VERSION) {
+        error = path + ": snapshot version " + to_string(header->version) + " is not supported (expected " +
+                to_string(SNAPSHOT_VERSION) + ")";
+    } else if (header->fileSize != size) {
+        error = path + ": truncated (" + to_string(size) + " of " + to_string(header->fileSize) + " bytes)";
+    } else if (header->checksum != checksum(base + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader))) {
+        error = path + ": checksum mismatch";
+    } else if (checkRecords(error)) {
+        return true;
+    } else {
+        error = path + ": " + error;
+    }
+    close();
+    return false;
+}
+
+bool SnapshotView::checkString(const SnapshotString& text) const {
+    return (uint64_t)text.offset + text.length <= header->sections[SECTION_STRINGS].count;
+}
+
+// Section bounds and record sizes, then every reference into the string pool
+bool SnapshotView::checkRecords(string& error) const {
+    for (int kind = 0; kind < SECTION_COUNT; kind++) {
+        const SnapshotSection& entry = header->sections[kind];
+        if (entry.recordSize != RECORD_SIZES[kind]) {
+            error = "section " + to_string(kind) + " has unexpected record size";
+            return false;
+        }
+        if (entry.offset < sizeof(SnapshotHeader) || entry.offset % SNAPSHOT_ALIGN != 0 || entry.offset > size ||
+            entry.count > (size - entry.offset) / entry.recordSize) {
+            error = "section " + to_string(kind) + " lies outside the file";
+            return false;
+        }
+    }
+
+    if (!checkString(header->champion)) {
+        error = "bad champion name";
+        return false;
+    }
+    for (size_t i = 0; i < teamCount(); i++) {
+        if (!checkString(teams()[i].name) || !checkString(teams()[i].status)) {
+            error = "bad team record " + to_string(i);
+            return false;
+        }
+    }
+    for (size_t i = 0; i < playerCount(); i++) {
+        if (!checkString(players()[i].name) || !checkString(players()[i].playerID)) {
+            error = "bad player record " + to_string(i);
+            return false;
+        }
+    }
+    for (size_t i = 0; i < spectatorCount(); i++) {
+        const SnapshotSpectator& spectator = spectators()[i];
+        if (!checkString(spectator.name) || !checkString(spectator.email) || spectator.type > 2 ||
+            spectator.seatId < -1) {
+            error = "bad spectator record " + to_string(i);
+            return false;
+        }
+    }
+    for (size_t i = 0; i < matchCount(); i++) {
+        const SnapshotMatch& match = matches()[i];
+        if (!checkString(match.teamA) || !checkString(match.teamB) || !checkString(match.winner)) {
+            error = "bad match record " + to_string(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+string SnapshotView::text(const SnapshotString& ref) const {
+    return string(base + header->sections[SECTION_STRINGS].offset + ref.offset, ref.length);
+}
@@ -0,0 +1,163 @@
+#ifndef BINARY_SNAPSHOT_HPP
+#define BINARY_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Versioned binary image of all module state, read through mmap.
+//
+// Layout (native byte order, every section 8-byte aligned):
+//   SnapshotHeader
+//   section payloads, located by header.sections[kind]
+//
+// Records are fixed size and refer to text through SnapshotString
+// (offset and length into the STRINGS section), so a reader uses the
+// mapped records in place; the only copying is building the module
+// objects themselves. Spectators are stored seated first, then waiting
+// in heap order, so reinserting them rebuilds the heap without swaps.
+//
+// Version history:
+//   1  teams, players, spectators with seat ids, match log
+
+const uint32_t SNAPSHOT_VERSION = 1;
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+enum SnapshotSectionKind {
+    SECTION_STRINGS,
+    SECTION_TEAMS,
+    SECTION_PLAYERS,
+    SECTION_SPECTATORS,
+    SECTION_MATCHES,
+    SECTION_COUNT
+};
+
+// Engine flags (SnapshotHeader::flags)
+const uint32_t SNAPSHOT_REGISTRATION_OPEN = 1;
+const uint32_t SNAPSHOT_TOURNAMENT_COMPLETE = 2;
+const uint32_t SNAPSHOT_SPECTATORS_ACTIVE = 4;
+
+struct SnapshotString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotSection {
+    uint64_t offset;
+    uint64_t count;
+    uint32_t recordSize;        // Checked on load; 1 for STRINGS
+    uint32_t reserved;
+};
+
+struct SnapshotHeader {
+    char magic[8];              // "APUECSNP"
+    uint32_t version;
+    uint32_t byteOrder;         // SNAPSHOT_BYTE_ORDER as written
+    uint64_t fileSize;
+    uint64_t checksum;          // FNV-1a over every byte after the header
+    uint32_t flags;
+    int32_t seatCapacity[3];    // VIP, Influencer, General; seat ids depend on them
+    SnapshotString champion;
+    SnapshotSection sections[SECTION_COUNT];
+};
+
+struct SnapshotTeam {
+    SnapshotString name;
+    SnapshotString status;
+};
+
+struct SnapshotPlayer {
+    SnapshotString name;
+    SnapshotString playerID;
+    uint8_t earlyBird;
+    uint8_t wildcard;
+    uint8_t checkedIn;
+    uint8_t reserved[5];
+};
+
+struct SnapshotSpectator {
+    SnapshotString name;
+    SnapshotString email;
+    int32_t arrivalTime;
+    int32_t seatId;             // -1 = waiting
+    uint8_t type;               // 0 VIP, 1 Influencer, 2 General
+    uint8_t reserved[7];
+};
+
+struct SnapshotMatch {
+    SnapshotString teamA;
+    SnapshotString teamB;
+    SnapshotString winner;
+};
+
+// Collects records in memory and writes the file (temp file, fsync,
+// rename), so a crash never leaves a partial snapshot under path.
+class SnapshotBuilder {
+private:
+    string strings;
+    vector<SnapshotTeam> teams;
+    vector<SnapshotPlayer> players;
+    vector<SnapshotSpectator> spectators;
+    vector<SnapshotMatch> matches;
+    SnapshotHeader header;
+
+public:
+    SnapshotBuilder();
+
+    SnapshotString addString(const string& text);
+    void setFlags(uint32_t flags) { header.flags = flags; }
+    void setSeatCapacity(const int capacity[3]);
+    void setChampion(const string& name) { header.champion = addString(name); }
+
+    void addTeam(const string& name, const string& status);
+    void addPlayer(const string& name, const string& playerID, bool earlyBird, bool wildcard, bool checkedIn);
+    void addSpectator(const string& name, const string& email, int type, int arrivalTime, int seatId);
+    void addMatch(const string& teamA, const string& teamB, const string& winner);
+
+    bool write(const string& path, string& error);
+};
+
+// Read-only mapping of a snapshot file. open() validates the header,
+// checksum, section bounds and every string reference, so accessors
+// need no further checks.
+class SnapshotView {
+private:
+    const char* base;
+    size_t size;
+    const SnapshotHeader* header;
+
+    const void* section(SnapshotSectionKind kind) const { return base + header->sections[kind].offset; }
+    bool checkString(const SnapshotString& text) const;
+    bool checkRecords(string& error) const;
+
+    // Disable copying (owns the mapping)
+    SnapshotView(const SnapshotView&);
+    SnapshotView& operator=(const SnapshotView&);
+
+public:
+    SnapshotView();
+    ~SnapshotView();
+
+    bool open(const string& path, string& error);
+    void close();
+
+    string text(const SnapshotString& ref) const;
+    uint32_t getFlags() const { return header->flags; }
+    const int32_t* getSeatCapacity() const { return header->seatCapacity; }
+    string getChampion() const { return text(header->champion); }
+
+    size_t teamCount() const { return (size_t)header->sections[SECTION_TEAMS].count; }
+    size_t playerCount() const { return (size_t)header->sections[SECTION_PLAYERS].count; }
+    size_t spectatorCount() const { return (size_t)header->sections[SECTION_SPECTATORS].count; }
+    size_t matchCount() const { return (size_t)header->sections[SECTION_MATCHES].count; }
+
+    const SnapshotTeam* teams() const { return (const SnapshotTeam*)section(SECTION_TEAMS); }
+    const SnapshotPlayer* players() const { return (const SnapshotPlayer*)section(SECTION_PLAYERS); }
+    const SnapshotSpectator* spectators() const { return (const SnapshotSpectator*)section(SECTION_SPECTATORS); }
+    const SnapshotMatch* matches() const { return (const SnapshotMatch*)section(SECTION_MATCHES); }
+};
+
+#endif
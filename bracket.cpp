@@ -0,0 +1,222 @@
+#include "bracket.hpp"
+
+Bracket::Bracket(int entrants, BracketFormat bracketFormat, bool bracketReset)
+    : format(bracketFormat), entrantCount(entrants < 0 ? 0 : entrants), grandFinal(-1), resetNode(-1),
+      seeding(entrants) {
+    size = 2;
+    upperRounds = 1;
+    while (size < entrantCount) {
+        size *= 2;
+        upperRounds++;
+    }
+    lowerRounds = (format == BRACKET_DOUBLE_ELIMINATION) ? 2 * (upperRounds - 1) : 0;
+
+    // Lower round 0 pairs the first-round losers; odd rounds take the
+    // drop-downs (same count), even rounds halve the field.
+    vector<int> lowerCount(lowerRounds);
+    for (int j = 0; j < lowerRounds; j++) {
+        lowerCount[j] = (j == 0) ? size / 4 : (j % 2 == 1) ? lowerCount[j - 1] : lowerCount[j - 1] / 2;
+    }
+
+    // First node of every round, in playing order
+    vector<int> upperStart(upperRounds);
+    vector<int> lowerStart(lowerRounds);
+    int next = 0;
+    upperStart[0] = next;
+    next += size / 2;
+    if (lowerRounds > 0) {
+        lowerStart[0] = next;
+        next += lowerCount[0];
+    }
+    for (int r = 1; r < upperRounds; r++) {
+        upperStart[r] = next;
+        next += size >> (r + 1);
+        for (int j = 2 * r - 1; j <= 2 * r && j < lowerRounds; j++) {
+            lowerStart[j] = next;
+            next += lowerCount[j];
+        }
+    }
+    if (format == BRACKET_DOUBLE_ELIMINATION) {
+        grandFinal = next++;
+        if (bracketReset) {
+            resetNode = next++;
+        }
+    }
+    nodes.resize(next);
+
+    for (int r = 0; r < upperRounds; r++) {
+        int count = size >> (r + 1);
+        for (int m = 0; m < count; m++) {
+            BracketNode& node = nodes[upperStart[r] + m];
+            node.side = SIDE_UPPER;
+            node.round = (unsigned char)r;
+            if (r + 1 < upperRounds) {
+                node.winnerTo = (upperStart[r + 1] + m / 2) * 2 + m % 2;
+            } else {
+                node.winnerTo = (grandFinal >= 0) ? grandFinal * 2 : -1;
+            }
+
+            if (format == BRACKET_SINGLE_ELIMINATION) {
+                node.loserTo = -1;
+            } else if (lowerRounds == 0) {
+                node.loserTo = grandFinal * 2 + 1;      // Two entrants: the loser gets the second life directly
+            } else if (r == 0) {
+                node.loserTo = (lowerStart[0] + m / 2) * 2 + m % 2;
+            } else {
+                int target = (r % 2 == 1) ? count - 1 - m : m;
+                node.loserTo = (lowerStart[2 * r - 1] + target) * 2 + 1;
+            }
+        }
+    }
+
+    for (int j = 0; j < lowerRounds; j++) {
+        for (int m = 0; m < lowerCount[j]; m++) {
+            BracketNode& node = nodes[lowerStart[j] + m];
+            node.side = SIDE_LOWER;
+            node.round = (unsigned char)j;
+            node.loserTo = -1;
+            if (j == lowerRounds - 1) {
+                node.winnerTo = grandFinal * 2 + 1;
+            } else if ((j + 1) % 2 == 1) {
+                node.winnerTo = (lowerStart[j + 1] + m) * 2;   // Meets a drop-down
+            } else {
+                node.winnerTo = (lowerStart[j + 1] + m / 2) * 2 + m % 2;
+            }
+        }
+    }
+
+    if (grandFinal >= 0) {
+        nodes[grandFinal].side = SIDE_GRAND_FINAL;
+        nodes[grandFinal].round = 0;
+        nodes[grandFinal].winnerTo = -1;
+        nodes[grandFinal].loserTo = -1;
+    }
+    if (resetNode >= 0) {
+        nodes[resetNode].side = SIDE_RESET;
+        nodes[resetNode].round = 0;
+        nodes[resetNode].winnerTo = -1;
+        nodes[resetNode].loserTo = -1;
+    }
+
+    slots.assign(nodes.size() * 2, SLOT_PENDING);
+    winners.assign(nodes.size(), -1);
+}
+
+void Bracket::start(const int* placement, vector<int>* ready) {
+    for (size_t i = 0; i < slots.size(); i++) {
+        slots[i] = SLOT_PENDING;
+    }
+    for (size_t i = 0; i < winners.size(); i++) {
+        winners[i] = -1;
+    }
+
+    // First upper round nodes are 0..size/2-1, so position p is slot p
+    for (int p = 0; p < size; p++) {
+        int entrant = (placement != nullptr) ? placement[p] : seeding.getSeedAt(p);
+        place(p, (entrant >= 0 && entrant < entrantCount) ? entrant : SLOT_EMPTY, ready);
+    }
+}
+
+void Bracket::place(int target, int entrant, vector<int>* ready) {
+    slots[target] = entrant;
+    int node = target / 2;
+    if (isReady(node)) {
+        if (ready != nullptr) ready->push_back(node);
+    } else {
+        resolveIfBye(node, ready);
+    }
+}
+
+void Bracket::resolveIfBye(int node, vector<int>* ready) {
+    if (winners[node] >= 0) {
+        return;
+    }
+    int a = slots[node * 2];
+    int b = slots[node * 2 + 1];
+    if (a == SLOT_PENDING || b == SLOT_PENDING) {
+        return;
+    }
+    if (a == SLOT_EMPTY) {
+        resolve(node, 1, ready);    // Also covers two empty slots: nobody moves on
+    } else if (b == SLOT_EMPTY) {
+        resolve(node, 0, ready);
+    }
+}
+
+void Bracket::resolve(int node, int winnerSlot, vector<int>* ready) {
+    winners[node] = winnerSlot;
+    int winner = slots[node * 2 + winnerSlot];
+    int loser = slots[node * 2 + 1 - winnerSlot];
+
+    if (node == grandFinal && resetNode >= 0) {
+        // The upper champion (slot 0) has not lost yet: a lower champion
+        // win means a second final, otherwise the reset is never played
+        bool reset = (winnerSlot == 1 && loser >= 0);
+        place(resetNode * 2, reset ? loser : SLOT_EMPTY, ready);
+        place(resetNode * 2 + 1, reset ? winner : SLOT_EMPTY, ready);
+        return;
+    }
+
+    const BracketNode& info = nodes[node];
+    if (info.winnerTo >= 0) {
+        place(info.winnerTo, winner, ready);
+    }
+    if (info.loserTo >= 0) {
+        place(info.loserTo, loser, ready);
+    }
+}
+
+string Bracket::getRoundName(int node) const {
+    const BracketNode& info = nodes[node];
+    switch (info.side) {
+        case SIDE_UPPER:
+            return (format == BRACKET_SINGLE_ELIMINATION ? "Round " : "Upper Bracket Round ") + to_string(info.round + 1);
+        case SIDE_LOWER:
+            return "Lower Bracket Round " + to_string(info.round + 1);
+        case SIDE_GRAND_FINAL:
+            return "Grand Final";
+        default:
+            return "Grand Final Reset";
+    }
+}
+
+bool Bracket::isReady(int node) const {
+    return winners[node] < 0 && slots[node * 2] >= 0 && slots[node * 2 + 1] >= 0;
+}
+
+bool Bracket::isBye(int node) const {
+    return winners[node] >= 0 && (slots[node * 2] == SLOT_EMPTY || slots[node * 2 + 1] == SLOT_EMPTY);
+}
+
+int Bracket::getWinner(int node) const {
+    return winners[node] < 0 ? SLOT_PENDING : slots[node * 2 + winners[node]];
+}
+
+int Bracket::getLoser(int node) const {
+    return winners[node] < 0 ? SLOT_PENDING : slots[node * 2 + 1 - winners[node]];
+}
+
+bool Bracket::setWinner(int node, int winnerSlot, vector<int>* ready) {
+    if (node < 0 || node >= getNodeCount() || !isReady(node) || (winnerSlot != 0 && winnerSlot != 1)) {
+        return false;
+    }
+    resolve(node, winnerSlot, ready);
+    return true;
+}
+
+int Bracket::getChampion() const {
+    if (grandFinal < 0) {
+        return getWinner(getNodeCount() - 1);
+    }
+    if (resetNode >= 0) {
+        int resetWinner = getWinner(resetNode);
+        if (resetWinner != SLOT_EMPTY) {
+            return resetWinner;     // Still pending, or the reset decided it
+        }
+    }
+    return getWinner(grandFinal);
+}
+
+bool Bracket::isFinished() const {
+    return getChampion() != SLOT_PENDING;
+}
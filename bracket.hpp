@@ -0,0 +1,111 @@
+#ifndef BRACKET_HPP
+#define BRACKET_HPP
+
+#include "seeding.hpp"
+#include <string>
+#include <vector>
+using namespace std;
+
+enum BracketFormat {
+    BRACKET_SINGLE_ELIMINATION = 0,
+    BRACKET_DOUBLE_ELIMINATION = 1
+};
+
+enum BracketSide {
+    SIDE_UPPER = 0,
+    SIDE_LOWER = 1,
+    SIDE_GRAND_FINAL = 2,
+    SIDE_RESET = 3          // Second grand final, only if the lower bracket champion wins the first
+};
+
+// Slot contents besides an entrant index
+const int SLOT_PENDING = -1;    // Team not decided yet
+const int SLOT_EMPTY = -2;      // No team will arrive (bye)
+
+// One match of the bracket. Destinations are node * 2 + slot, -1 = none
+// (the winner is champion, or the loser is eliminated).
+struct BracketNode {
+    unsigned char side;         // BracketSide
+    unsigned char round;        // Round within its side, from 0
+    int winnerTo;
+    int loserTo;
+};
+
+// Elimination bracket precomputed once as a flat node array.
+// Entrants are padded with byes to a power of two. Nodes are stored in
+// playing order (upper round 0, lower round 0, upper round 1, lower
+// rounds 1-2, upper round 2, ...), so every node comes after the nodes
+// that feed it and one pass in index order plays the whole bracket.
+//
+// Double elimination: first-round losers pair up in lower round 0; every
+// later upper-round loser drops into an odd lower round against a lower
+// bracket survivor, in reversed order every other round so teams that
+// just met do not meet again at once. The upper and lower champions meet
+// in the grand final; with bracketReset, a lower champion win forces a
+// second, deciding final.
+//
+// Results live in fixed arrays sized at construction, so starting over
+// and playing matches never allocates. A bye (SLOT_EMPTY opponent) is
+// resolved as soon as it is known, and the absence of a team propagates
+// the same way (a bye's "loser" drops nobody into the lower bracket).
+class Bracket {
+private:
+    BracketFormat format;
+    int entrantCount;
+    int size;                   // Power of two >= entrantCount, at least 2
+    int upperRounds;
+    int lowerRounds;
+    int grandFinal;             // Node index, -1 for single elimination
+    int resetNode;              // Node index, -1 if there is no bracket reset
+    BracketSeeding seeding;     // Default placement
+    vector<BracketNode> nodes;
+    vector<int> slots;          // node * 2 + slot -> entrant or SLOT_*
+    vector<int> winners;        // node -> winning slot (0/1), -1 = undecided
+
+    // ready (may be null) collects nodes that become playable
+    void place(int target, int entrant, vector<int>* ready);
+    void resolve(int node, int winnerSlot, vector<int>* ready);
+    void resolveIfBye(int node, vector<int>* ready);
+
+public:
+    Bracket(int entrants, BracketFormat bracketFormat, bool bracketReset = true);
+
+    BracketFormat getFormat() const { return format; }
+    int getEntrantCount() const { return entrantCount; }
+    int getSize() const { return size; }
+    int getUpperRounds() const { return upperRounds; }
+    int getLowerRounds() const { return lowerRounds; }
+    int getNodeCount() const { return (int)nodes.size(); }
+    const BracketNode& getNode(int node) const { return nodes[node]; }
+    int getGrandFinal() const { return grandFinal; }
+    int getResetNode() const { return resetNode; }
+
+    // Clear all results and fill the first upper round. placement[p] is
+    // the entrant at first-round position p (match p / 2, slot p % 2), or
+    // SLOT_EMPTY; it must hold getSize() entries. Without a placement,
+    // entrant i is seed i in the standard seeding (see BracketSeeding):
+    // top seeds meet as late as possible and the byes go to them.
+    // Playable first matches are appended to ready if given.
+    void start(const int* placement = nullptr, vector<int>* ready = nullptr);
+
+    string getRoundName(int node) const;    // "Upper Bracket Round 2", "Grand Final", ...
+    int getTeam(int node, int slot) const { return slots[node * 2 + slot]; }
+    bool isDecided(int node) const { return winners[node] >= 0; }
+    // Both teams known and no result yet
+    bool isReady(int node) const;
+    bool isBye(int node) const;             // Decided without being played
+    int getWinner(int node) const;          // Entrant, SLOT_PENDING or SLOT_EMPTY
+    int getLoser(int node) const;
+
+    // Report the winning slot of a ready match; its teams move on at once.
+    // Only the nodes the two teams move into are touched (plus any byes
+    // they pass through, at most one per round), and those that become
+    // playable are appended to ready if given. False if the match is not
+    // ready or winnerSlot is not 0 or 1.
+    bool setWinner(int node, int winnerSlot, vector<int>* ready = nullptr);
+
+    bool isFinished() const;
+    int getChampion() const;                // Entrant, SLOT_PENDING while running, SLOT_EMPTY if nobody entered
+};
+
+#endif
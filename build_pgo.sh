@@ -0,0 +1,41 @@
+#!/bin/sh
+# Profile-guided optimized build of the APUEC binaries.
+#
+#   1. build instrumented binaries (APUEC_PGO=GENERATE)
+#   2. run the training workloads (container_bench, spectator_loadgen)
+#   3. rebuild with the collected profile (APUEC_PGO=USE) and LTO
+#
+# Usage: ./build_pgo.sh [build-dir]   (default: build-pgo)
+# Final binaries end up in <build-dir>/release.
+set -e
+
+SRC_DIR=$(cd "$(dirname "$0")" && pwd)
+BUILD_DIR=${1:-build-pgo}
+mkdir -p "$BUILD_DIR"
+BUILD_DIR=$(cd "$BUILD_DIR" && pwd)
+PROFILE_DIR="$BUILD_DIR/profiles"
+JOBS=$(nproc 2>/dev/null || echo 4)
+
+rm -rf "$PROFILE_DIR"
+mkdir -p "$PROFILE_DIR"
+
+echo "== [1/3] Instrumented build =="
+cmake -S "$SRC_DIR" -B "$BUILD_DIR/instrumented" -DCMAKE_BUILD_TYPE=Release \
+      -DAPUEC_PGO=GENERATE -DAPUEC_PGO_DIR="$PROFILE_DIR"
+cmake --build "$BUILD_DIR/instrumented" -j"$JOBS"
+
+echo "== [2/3] Training run =="
+cmake --build "$BUILD_DIR/instrumented" --target pgo-train
+
+# Clang writes raw profiles that must be merged first
+if ls "$PROFILE_DIR"/*.profraw >/dev/null 2>&1; then
+    PROFDATA=$(command -v llvm-profdata || xcrun -f llvm-profdata)
+    "$PROFDATA" merge -output="$PROFILE_DIR/apuec.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+echo "== [3/3] Optimized build with profile =="
+cmake -S "$SRC_DIR" -B "$BUILD_DIR/release" -DCMAKE_BUILD_TYPE=Release \
+      -DAPUEC_PGO=USE -DAPUEC_PGO_DIR="$PROFILE_DIR" -DAPUEC_ENABLE_LTO=ON
+cmake --build "$BUILD_DIR/release" -j"$JOBS"
+
+echo "PGO build ready in $BUILD_DIR/release"
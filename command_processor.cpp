@@ -0,0 +1,268 @@
+#include "command_processor.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+bool CommandProcessor::tokenize(const string& line, vector<string>& args) {
+    args.clear();
+    size_t i = 0;
+    while (i < line.size()) {
+        char c = line[i];
+        if (c == '#') break;
+        if (c == ' ' || c == '\t' || c == '\r') {
+            i++;
+            continue;
+        }
+
+        string token;
+        if (c == '"') {
+            size_t close = line.find('"', i + 1);
+            if (close == string::npos) return false;
+            token = line.substr(i + 1, close - i - 1);
+            i = close + 1;
+        } else {
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r') {
+                token += line[i++];
+            }
+        }
+        args.push_back(token);
+    }
+    return true;
+}
+
+string CommandProcessor::commandKey(const vector<string>& args) {
+    if (args.empty()) return "";
+    string key = args[0];
+    if (args.size() > 1 && (key == "register" || key == "withdraw" || key == "replace")) {
+        key += " " + args[1];
+    }
+    return key;
+}
+
+bool CommandProcessor::report(const CoreResult& result, string& error) {
+    if (!result.ok) {
+        error = result.message;
+    }
+    return result.ok;
+}
+
+void CommandProcessor::printReady(const vector<LiveMatch>& matches, ostream& out) {
+    for (size_t i = 0; i < matches.size(); i++) {
+        const LiveMatch& match = matches[i];
+        out << "Ready #" << match.id << " " << match.round << ": " << match.teamA << " vs " << match.teamB << "\n";
+    }
+}
+
+bool CommandProcessor::execute(const vector<string>& args, ostream& out, string& error) {
+    if (args.empty()) {
+        error = "empty command";
+        return false;
+    }
+
+    const string& command = args[0];
+    size_t argc = args.size();
+
+    if (command == "register" && argc >= 3) {
+        const string& subject = args[1];
+        if (subject == "team") {
+            bool wildCard = (argc > 3 && args[3] == "wildcard");
+            return report(core->registerTeam(args[2], wildCard), error);
+        }
+        if (subject == "player" && argc >= 4) {
+            string kind = argc > 4 ? args[4] : "normal";
+            if (kind == "wildcard") {
+                return report(core->addWildcardPlayer(args[3], args[2]), error);
+            }
+            return report(core->registerPlayer(args[3], args[2], kind == "early"), error);
+        }
+        if (subject == "spectator" && argc >= 5) {
+            return report(core->registerSpectator(args[4], args[2], args[3]), error);
+        }
+    } else if (command == "check-in" && argc == 2) {
+        return report(core->checkInPlayer(args[1]), error);
+    } else if (command == "withdraw" && argc == 3) {
+        if (args[1] == "team") return report(core->withdrawTeam(args[2]), error);
+        if (args[1] == "player") return report(core->withdrawPlayer(args[2]), error);
+        if (args[1] == "spectator") return report(core->removeSpectator(args[2]), error);
+    } else if (command == "replace" && argc == 4 && args[1] == "team") {
+        return report(core->replaceTeam(args[2], args[3]), error);
+    } else if (command == "upgrade" && argc == 3) {
+        return report(core->changeSpectatorType(args[1], args[2]), error);
+    } else if (command == "close-registration" && argc == 1) {
+        return report(core->closeRegistration(), error);
+    } else if (command == "allocate" && argc == 1) {
+        int seated = core->allocateSeating();
+        out << "Allocated " << seated << " seat(s)\n";
+        return true;
+    } else if (command == "run-tournament" && argc <= 2) {
+        string mode = argc == 2 ? args[1] : "groups";
+        if (mode != "groups" && mode != "double" && mode != "double-no-reset") {
+            error = "unknown tournament format: " + mode;
+            return false;
+        }
+        TournamentResult result = core->runTournament(mode == "groups" ? FORMAT_GROUP_STAGE : FORMAT_DOUBLE_ELIMINATION,
+                                                      mode != "double-no-reset");
+        if (!result.ok) {
+            error = result.message;
+            return false;
+        }
+        out << "Champion: " << result.champion << " (" << result.matchesPlayed << " matches)\n";
+        return true;
+    } else if (command == "run-swiss" && (argc == 3 || argc == 4)) {
+        int qualifierCount = argc == 4 ? atoi(args[3].c_str()) : 8;
+        QualifierResult result = core->runSwissQualifier(args[1], atoi(args[2].c_str()), qualifierCount);
+        if (!result.ok) {
+            error = result.message;
+            return false;
+        }
+        out << "Qualified (" << result.matchesPlayed << " matches):";
+        for (size_t i = 0; i < result.qualifiers.size(); i++) {
+            out << (i ? ", " : " ") << result.qualifiers[i];
+        }
+        out << "\n";
+        return true;
+    } else if (command == "live-start" && argc <= 2) {
+        string mode = argc == 2 ? args[1] : "double";
+        if (mode != "single" && mode != "double" && mode != "double-no-reset") {
+            error = "unknown bracket format: " + mode;
+            return false;
+        }
+        vector<LiveMatch> ready;
+        BracketFormat format = (mode == "single") ? BRACKET_SINGLE_ELIMINATION : BRACKET_DOUBLE_ELIMINATION;
+        if (!report(core->startLiveTournament(format, mode != "double-no-reset", ready), error)) {
+            return false;
+        }
+        printReady(ready, out);
+        return true;
+    } else if (command == "report" && (argc == 3 || argc == 4)) {
+        vector<LiveMatch> nowReady;
+        int minute = argc == 4 ? atoi(args[3].c_str()) : -1;
+        if (!report(core->reportResult(args[1], args[2], nowReady, minute), error)) {
+            return false;
+        }
+        printReady(nowReady, out);
+        if (core->isTournamentComplete()) {
+            out << "Champion: " << core->getState().getChampion() << "\n";
+        }
+        return true;
+    } else if (command == "ready" && argc == 1) {
+        vector<LiveMatch> matches;
+        core->getReadyMatches(matches);
+        printReady(matches, out);
+        return true;
+    } else if (command == "stations" && argc == 4) {
+        return report(core->setMatchDay(atoi(args[1].c_str()), atoi(args[2].c_str()), atoi(args[3].c_str())), error);
+    } else if (command == "begin" && argc == 4) {
+        return report(core->beginMatch(atoi(args[1].c_str()), atoi(args[2].c_str()), atoi(args[3].c_str())), error);
+    } else if (command == "plan" && argc == 2) {
+        vector<ScheduledMatch> plan;
+        int finish;
+        if (!report(core->planMatchDay(atoi(args[1].c_str()), plan, finish), error)) {
+            return false;
+        }
+        for (size_t i = 0; i < plan.size(); i++) {
+            const ScheduledMatch& match = plan[i];
+            out << "#" << match.match.id << " station " << match.station << " " << match.start << "-" << match.end
+                << (match.started ? " (playing) " : " ") << match.match.round << ": " << match.match.teamA << " vs "
+                << match.match.teamB << "\n";
+        }
+        out << "Projected finish: minute " << finish << "\n";
+        return true;
+    } else if (command == "rate" && argc == 3) {
+        return report(core->setRating(args[1], atof(args[2].c_str())), error);
+    } else if (command == "what-if" && argc >= 2 && argc % 2 == 0) {
+        vector<pair<string, string> > assumptions;
+        for (size_t i = 2; i + 1 < argc; i += 2) {
+            assumptions.push_back(make_pair(args[i], args[i + 1] == "next" ? string() : args[i + 1]));
+        }
+        vector<RoundChance> chances;
+        if (!report(core->whatIf(args[1], assumptions, chances), error)) {
+            return false;
+        }
+        out << args[1] << ":";
+        for (size_t i = 0; i < chances.size(); i++) {
+            out << (i ? ", " : " ") << chances[i].round << " " << fixed << setprecision(1)
+                << chances[i].probability * 100.0 << "%";
+        }
+        out << "\n";
+        return true;
+    } else if (command == "end-tournament" && argc == 1) {
+        return report(core->endTournament(), error);
+    } else if (command == "sync" && argc == 1) {
+        vector<string> corrections = core->synchronize();
+        for (size_t i = 0; i < corrections.size(); i++) {
+            out << "Corrected: " << corrections[i] << "\n";
+        }
+        return true;
+    } else if (command == "validate" && argc == 1) {
+        vector<string> problems = core->validate();
+        for (size_t i = 0; i < problems.size(); i++) {
+            out << "Problem: " << problems[i] << "\n";
+        }
+        if (!problems.empty()) {
+            error = to_string(problems.size()) + " consistency problem(s)";
+            return false;
+        }
+        return true;
+    } else if (command == "export" && argc <= 2) {
+        return report(argc == 2 ? core->exportAll(args[1]) : core->exportAll(), error);
+    } else if (command == "stats") {
+        printStats(args, out);
+        return true;
+    } else if (command == "save-spectators" && argc == 2) {
+        return report(core->saveSpectators(args[1]), error);
+    } else if (command == "load-spectators" && argc == 2) {
+        return report(core->loadSpectators(args[1]), error);
+    } else if (command == "metrics" && argc <= 2) {
+        if (argc == 1) {
+            core->getMetrics().writeJson(out);
+            return true;
+        }
+        ofstream file(args[1]);
+        if (!file.is_open()) {
+            error = "Unable to write file " + args[1];
+            return false;
+        }
+        core->getMetrics().writeJson(file);
+        return true;
+    } else if (command == "save-snapshot" && argc == 2) {
+        return report(core->saveSnapshot(args[1]), error);
+    } else if (command == "load-snapshot" && argc == 2) {
+        return report(core->loadSnapshot(args[1]), error);
+    }
+
+    error = "unknown command or wrong arguments: " + command;
+    return false;
+}
+
+void CommandProcessor::printStats(const vector<string>& args, ostream& out) {
+    if (args.size() >= 3 && args[1] == "team") {
+        TeamStats stats;
+        if (!core->getTeamStats(args[2], stats)) {
+            out << "No match log (result.csv)\n";
+            return;
+        }
+        out << args[2] << ": " << stats.totalMatches << " matches, " << stats.wins << " wins, "
+            << stats.losses << " losses, win rate " << fixed << setprecision(2) << stats.winRate << "%\n";
+        return;
+    }
+
+    if (args.size() >= 2 && args[1] == "history") {
+        int limit = args.size() >= 3 ? atoi(args[2].c_str()) : 10;
+        if (limit <= 0) return;
+        MatchRecord* records = new MatchRecord[limit];
+        int count = core->getMatchHistory(records, limit);
+        for (int i = 0; i < count; i++) {
+            out << records[i].teamA << " vs " << records[i].teamB << " -> " << records[i].winner << "\n";
+        }
+        delete[] records;
+        return;
+    }
+
+    SystemSummary summary = core->getSummary();
+    out << "Teams: " << summary.registeredTeams
+        << ", Players: " << summary.registeredPlayers << " (" << summary.checkedInPlayers << " checked in)"
+        << ", Spectators: " << summary.seatedSpectators << " seated, " << summary.waitingSpectators << " waiting"
+        << ", Registration: " << (summary.registrationOpen ? "open" : "closed")
+        << ", Tournament: " << (summary.tournamentComplete ? "completed" : "pending") << "\n";
+}
@@ -0,0 +1,57 @@
+#ifndef COMMAND_PROCESSOR_HPP
+#define COMMAND_PROCESSOR_HPP
+
+#include "apuec_core.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Text command interface to APUECCore shared by the batch runner and the
+// server. One command per line; '#' starts a comment and arguments
+// containing spaces are written in double quotes:
+//
+//   register team "Team Alpha" [normal|wildcard]
+//   register player ID "Name" [early|normal|wildcard]
+//   register spectator EMAIL VIP|Influencer|General "Name"
+//   check-in ID
+//   withdraw team "Name" | withdraw player ID | withdraw spectator EMAIL
+//   replace team "Old" "New"
+//   upgrade EMAIL VIP|Influencer|General
+//   close-registration
+//   allocate
+//   run-tournament [groups|double|double-no-reset] | end-tournament
+//   run-swiss FILE ROUNDS [QUALIFIERS]   (open qualifier, default 8 qualify)
+//   live-start [single|double|double-no-reset] | report "Winner" "Loser" [MINUTE] | ready
+//   stations N MATCH_MINUTES REST_MINUTES | begin ID STATION MINUTE | plan MINUTE   (match day)
+//   rate "Team" ELO | what-if "Team" ["Winner" "Loser"|"Winner" next]...   (exact chances per round)
+//   stats [team "Name" | history [N]]
+//   save-spectators FILE | load-spectators FILE
+//   save-snapshot FILE | load-snapshot FILE
+//   sync | validate | export [DIR]
+//   metrics [FILE]        (JSON; to out unless FILE is given)
+class CommandProcessor {
+private:
+    APUECCore* core;
+
+    bool report(const CoreResult& result, string& error);
+    void printReady(const vector<LiveMatch>& matches, ostream& out);
+    void printStats(const vector<string>& args, ostream& out);
+
+public:
+    CommandProcessor(APUECCore* engine) : core(engine) {}
+
+    // Split a line into arguments; false on an unterminated quote
+    static bool tokenize(const string& line, vector<string>& args);
+
+    // Name used to group timings: the command plus its subject for
+    // register/withdraw/replace
+    static string commandKey(const vector<string>& args);
+
+    // Run one tokenized command. Output lines go to out; on failure the
+    // reason is stored in error and false is returned.
+    bool execute(const vector<string>& args, ostream& out, string& error);
+};
+
+#endif
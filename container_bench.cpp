@@ -0,0 +1,539 @@
+/**
+ * APUEC Container Microbenchmarks
+ *
+ * Measures push/pop (insert/extract) cost and memory per element for
+ * every hand-rolled container in the project, next to the std::
+ * container that would replace it, across several sizes. The knockout
+ * kernel is timed with and without a task pool, and both must play every
+ * round identically.
+ *
+ * Usage: container_bench [--quick] [--filter TEXT] [--csv FILE]
+ *                        [--compare BASELINE.csv] [--threshold PCT]
+ *   --quick       fewer repetitions (for smoke runs and PGO training)
+ *   --filter      only run containers whose name contains TEXT
+ *   --csv         write results as CSV (container,op,size,ns_per_op,bytes_per_element)
+ *   --compare     compare against an earlier --csv run; exits with 1 if any
+ *                 result is slower than the baseline by more than --threshold
+ *                 percent (default 20)
+ * Exits with 1 if the pooled knockout kernel disagrees with the serial one.
+ */
+
+#include "MatchScheduler.hpp"
+#include "RegistrationManager.hpp"
+#include "RegistrationSystem.hpp"
+#include "Statistic.hpp"
+#include "knockout_kernel.hpp"
+#include "spectator_manager.hpp"
+#include "task_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <queue>
+#include <sstream>
+#include <stack>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// ===== MEASUREMENT HELPERS =====
+
+struct BenchResult {
+    string container;
+    string op;
+    int size;
+    double nsPerOp;
+    double bytesPerElement;
+};
+
+static vector<BenchResult> results;
+static long long workBudget = 2000000;      // Element operations per measurement
+static string filterText;
+static volatile long long sink;             // Keeps popped values observable
+static int kernelMismatches = 0;            // Pooled knockout rounds that differ from serial ones
+
+// Live heap bytes of std:: containers using CountingAllocator
+static long long countedBytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    typedef T value_type;
+    CountingAllocator() {}
+    template <typename U> CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        countedBytes += (long long)(n * sizeof(T));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) {
+        countedBytes -= (long long)(n * sizeof(T));
+        ::operator delete(p);
+    }
+    template <typename U> bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+// Runs reset() untimed, then times fill() and drain() separately over
+// enough repetitions to cover workBudget element operations.
+static void runBench(const string& container, const string& pushOp, const string& popOp, int size,
+                     double bytesPerElement, function<void()> reset,
+                     function<void(int)> fill, function<void(int)> drain) {
+    if (!filterText.empty() && container.find(filterText) == string::npos) return;
+
+    long long reps = workBudget / size;
+    if (reps < 3) reps = 3;
+
+    long long fillNanos = 0, drainNanos = 0;
+    for (long long r = 0; r < reps; r++) {
+        reset();
+        Clock::time_point t0 = Clock::now();
+        fill(size);
+        Clock::time_point t1 = Clock::now();
+        drain(size);
+        Clock::time_point t2 = Clock::now();
+        fillNanos += chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
+        drainNanos += chrono::duration_cast<chrono::nanoseconds>(t2 - t1).count();
+    }
+
+    BenchResult push = { container, pushOp, size, (double)fillNanos / (reps * size), bytesPerElement };
+    BenchResult pop = { container, popOp, size, (double)drainNanos / (reps * size), bytesPerElement };
+    results.push_back(push);
+    results.push_back(pop);
+}
+
+// ===== ELEMENT FACTORIES =====
+
+static const char* const TEAM_STATUSES[3] = { "early bird", "normal", "wild card" };
+static const char* const SPECTATOR_TYPES[3] = { "VIP", "Influencer", "General" };
+
+static MatchTeam makeMatchTeam(int i) {
+    MatchTeam t;
+    snprintf(t.name, sizeof(t.name), "Team%03d", i);
+    strcpy(t.status, TEAM_STATUSES[(i * 7) % 3]);
+    t.points = i;
+    return t;
+}
+
+static Team makeTeam(int i) {
+    Team t;
+    snprintf(t.name, sizeof(t.name), "Team%03d", i);
+    strcpy(t.status, TEAM_STATUSES[(i * 7) % 3]);
+    return t;
+}
+
+static Player makePlayer(int i) {
+    Player p;
+    p.name = "Player" + to_string(i);
+    p.playerID = "TP" + to_string(100000 + i);
+    p.isEarlyBird = (i % 2 == 0);
+    p.isWildcard = false;
+    p.isCheckedIn = false;
+    return p;
+}
+
+static Spectator makeSpectator(int i) {
+    return Spectator("Spectator" + to_string(i), "spec" + to_string(i) + "@bench.test",
+                     SPECTATOR_TYPES[(i * 7) % 3], (i * 7919) % 100000);
+}
+
+static int teamPriority(const char* status) {
+    if (strcmp(status, "early bird") == 0) return 3;
+    if (strcmp(status, "normal") == 0) return 2;
+    return 1;
+}
+
+struct MatchTeamLess {
+    bool operator()(const MatchTeam& a, const MatchTeam& b) const {
+        return teamPriority(a.status) < teamPriority(b.status);
+    }
+};
+
+struct SpectatorLess {
+    bool operator()(const Spectator& a, const Spectator& b) const { return a < b; }
+};
+
+// Exposes RegistrationSystem's ring buffer helpers
+class RingHarness : public RegistrationSystem {
+public:
+    Player ring[MAX_PLAYERS];
+    int front, rear, count;
+
+    RingHarness() : RegistrationSystem(nullptr), front(0), rear(-1), count(0) {}
+
+    void reset() { front = 0; rear = -1; count = 0; }
+    void push(const Player& p) { enqueue(ring, front, rear, count, p); }
+    bool pop(Player& p) { return dequeue(ring, front, rear, count, p); }
+    int find(const string& id) const { return findPlayerInQueue(ring, front, rear, count, id); }
+    bool remove(const string& id) { return removeFromQueue(ring, front, rear, count, id); }
+};
+
+// ===== BENCHMARKS =====
+
+static void benchMatchContainers(int size) {
+    static MatchTeam pool[MAX_TEAMS];
+    for (int i = 0; i < MAX_TEAMS; i++) pool[i] = makeMatchTeam(i);
+
+    // QueueMatch holds at most MAX_TEAMS - 1 elements
+    int qsize = size < MAX_TEAMS ? size : MAX_TEAMS - 1;
+    QueueMatch* matchQueue = new QueueMatch();
+    runBench("QueueMatch", "enqueue", "dequeue", qsize, (double)sizeof(QueueMatch) / qsize,
+        [&]() { *matchQueue = QueueMatch(); },
+        [&](int n) { for (int i = 0; i < n; i++) matchQueue->enqueue(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += matchQueue->dequeue().points; });
+    delete matchQueue;
+
+    StackMatch* stackMatch = new StackMatch();
+    runBench("StackMatch", "push", "pop", size, (double)sizeof(StackMatch) / size,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stackMatch->push(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += stackMatch->pop().points; });
+    delete stackMatch;
+
+    PriorityQueueMatch* pq = new PriorityQueueMatch();
+    runBench("PriorityQueueMatch", "insert", "remove", size, (double)sizeof(PriorityQueueMatch) / size,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) pq->insert(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += pq->remove().points; });
+    delete pq;
+
+    CircularQueueMatch* cq = new CircularQueueMatch();
+    runBench("CircularQueueMatch", "enqueue", "dequeue", size, (double)sizeof(CircularQueueMatch) / size,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) cq->enqueue(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += cq->dequeue().points; });
+    delete cq;
+
+    // std:: equivalents
+    queue<MatchTeam, deque<MatchTeam, CountingAllocator<MatchTeam> > > stdQueue;
+    long long before = countedBytes;
+    for (int i = 0; i < size; i++) stdQueue.push(pool[i]);
+    double queueBytes = (double)(countedBytes - before + sizeof(stdQueue)) / size;
+    while (!stdQueue.empty()) stdQueue.pop();
+    runBench("std::queue<MatchTeam>", "push", "pop", size, queueBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stdQueue.push(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stdQueue.front().points; stdQueue.pop(); } });
+
+    vector<MatchTeam, CountingAllocator<MatchTeam> > stackStorage;
+    stackStorage.reserve(size);
+    double stackBytes = (double)(stackStorage.capacity() * sizeof(MatchTeam) + sizeof(stackStorage)) / size;
+    runBench("std::stack<MatchTeam>", "push", "pop", size, stackBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stackStorage.push_back(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stackStorage.back().points; stackStorage.pop_back(); } });
+
+    vector<MatchTeam, CountingAllocator<MatchTeam> > heapStorage;
+    heapStorage.reserve(size);
+    double heapBytes = (double)(heapStorage.capacity() * sizeof(MatchTeam) + sizeof(heapStorage)) / size;
+    priority_queue<MatchTeam, vector<MatchTeam, CountingAllocator<MatchTeam> >, MatchTeamLess>
+        stdPq(MatchTeamLess(), std::move(heapStorage));
+    runBench("std::priority_queue<MatchTeam>", "push", "pop", size, heapBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stdPq.push(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stdPq.top().points; stdPq.pop(); } });
+}
+
+static void benchTeamContainers(int size) {
+    static Team pool[MAX_SIZE];
+    for (int i = 0; i < MAX_SIZE; i++) pool[i] = makeTeam(i);
+
+    // TeamQueue never wraps, so it starts from a fresh object each repetition
+    TeamQueue* teamQueue = new TeamQueue();
+    runBench("TeamQueue", "enqueue", "dequeue", size, (double)sizeof(TeamQueue) / size,
+        [&]() { *teamQueue = TeamQueue(); },
+        [&](int n) { for (int i = 0; i < n; i++) teamQueue->enqueue(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += teamQueue->dequeue().name[4]; });
+    delete teamQueue;
+
+    TeamStack* stackTeam = new TeamStack();
+    runBench("TeamStack", "push", "pop", size, (double)sizeof(TeamStack) / size,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stackTeam->push(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += stackTeam->pop().name[4]; });
+    delete stackTeam;
+
+    TeamCircularQueue* cq = new TeamCircularQueue();
+    runBench("TeamCircularQueue", "enqueue", "dequeue", size, (double)sizeof(TeamCircularQueue) / size,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) cq->enqueue(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += cq->dequeue().name[4]; });
+    delete cq;
+
+    TeamPriorityQueue* pq = new TeamPriorityQueue();
+    runBench("TeamPriorityQueue", "enqueue", "dequeue", size, (double)sizeof(TeamPriorityQueue) / size,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) pq->enqueue(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += pq->dequeue().name[4]; });
+    delete pq;
+
+    queue<Team, deque<Team, CountingAllocator<Team> > > stdQueue;
+    long long before = countedBytes;
+    for (int i = 0; i < size; i++) stdQueue.push(pool[i]);
+    double queueBytes = (double)(countedBytes - before + sizeof(stdQueue)) / size;
+    while (!stdQueue.empty()) stdQueue.pop();
+    runBench("std::queue<Team>", "push", "pop", size, queueBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stdQueue.push(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stdQueue.front().name[4]; stdQueue.pop(); } });
+}
+
+static void benchPlayerRing(int size) {
+    static Player pool[MAX_PLAYERS];
+    for (int i = 0; i < MAX_PLAYERS; i++) pool[i] = makePlayer(i);
+
+    RingHarness* ring = new RingHarness();
+    double ringBytes = (double)sizeof(ring->ring) / size;
+    runBench("RegistrationSystem ring", "enqueue", "dequeue", size, ringBytes,
+        [&]() { ring->reset(); },
+        [&](int n) { for (int i = 0; i < n; i++) ring->push(pool[i]); },
+        [&](int n) { Player p; for (int i = 0; i < n; i++) { ring->pop(p); sink += p.name.size(); } });
+
+    // find + remove in scattered order (the withdraw path)
+    runBench("RegistrationSystem ring/withdraw", "enqueue", "find+remove", size, ringBytes,
+        [&]() { ring->reset(); },
+        [&](int n) { for (int i = 0; i < n; i++) ring->push(pool[i]); },
+        [&](int n) {
+            for (int i = 0; i < n; i++) {
+                const string& id = pool[(i * 7) % n].playerID;
+                sink += ring->find(id);
+                ring->remove(id);
+            }
+        });
+    delete ring;
+
+    deque<Player, CountingAllocator<Player> > stdRing;
+    long long before = countedBytes;
+    for (int i = 0; i < size; i++) stdRing.push_back(pool[i]);
+    double dequeBytes = (double)(countedBytes - before + sizeof(stdRing)) / size;
+    stdRing.clear();
+    runBench("std::deque<Player>", "push_back", "pop_front", size, dequeBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stdRing.push_back(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stdRing.front().name.size(); stdRing.pop_front(); } });
+}
+
+static void benchStatisticStack(int size) {
+    static string pool[1000];
+    for (int i = 0; i < 1000; i++) pool[i] = "Team" + to_string(i) + ",Team" + to_string(i + 1) + ",Team" + to_string(i);
+
+    Stack<string>* stackStat = new Stack<string>();
+    runBench("Stack<string>", "push", "peek+pop", size, (double)sizeof(Stack<string>) / size,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stackStat->push(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stackStat->peek().size(); stackStat->pop(); } });
+    delete stackStat;
+
+    vector<string, CountingAllocator<string> > stdStack;
+    stdStack.reserve(size);
+    double stackBytes = (double)(stdStack.capacity() * sizeof(string) + sizeof(stdStack)) / size;
+    runBench("std::stack<string>", "push", "top+pop", size, stackBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stdStack.push_back(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stdStack.back().size(); stdStack.pop_back(); } });
+}
+
+static void benchSpectatorQueue(int size) {
+    vector<Spectator> pool;
+    pool.reserve(size);
+    for (int i = 0; i < size; i++) pool.push_back(makeSpectator(i));
+
+    SpectatorPriorityQueue* pq = new SpectatorPriorityQueue(size);
+    double pqBytes = (double)(sizeof(SpectatorPriorityQueue) +
+                              (long long)pq->getCapacity() * (sizeof(Spectator) + 3 * sizeof(int))) / size;
+    runBench("SpectatorPriorityQueue", "insert", "extractMax", size, pqBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) pq->insert(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += pq->extractMax().getArrivalTime(); });
+
+    int* handles = new int[size];
+    runBench("SpectatorPriorityQueue/handles", "insert", "erase(handle)", size, pqBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) handles[i] = pq->insert(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) sink += pq->erase(handles[(i * 7) % n]).getPriority(); });
+    delete[] handles;
+    delete pq;
+
+    vector<Spectator, CountingAllocator<Spectator> > heapStorage;
+    heapStorage.reserve(size);
+    double heapBytes = (double)(heapStorage.capacity() * sizeof(Spectator) + sizeof(heapStorage)) / size;
+    priority_queue<Spectator, vector<Spectator, CountingAllocator<Spectator> >, SpectatorLess>
+        stdPq(SpectatorLess(), std::move(heapStorage));
+    runBench("std::priority_queue<Spectator>", "push", "pop", size, heapBytes,
+        [&]() {},
+        [&](int n) { for (int i = 0; i < n; i++) stdPq.push(pool[i]); },
+        [&](int n) { for (int i = 0; i < n; i++) { sink += stdPq.top().getArrivalTime(); stdPq.pop(); } });
+}
+
+// Plays size teams out round by round with both kernels and counts the
+// rounds whose survivors differ, then times a first round and the rest
+static void benchKnockoutKernel(int size, TaskPool& workers) {
+    const unsigned int seed = 2024;
+    KnockoutKernel serial;
+    KnockoutKernel pooled(&workers);
+
+    vector<int> serialIds(size), pooledIds(size);
+    for (int i = 0; i < size; i++) serialIds[i] = pooledIds[i] = i;
+    int round = 0;
+    for (int count = size; count > 1; round++) {
+        int serialCount = serial.playRound(serialIds.data(), count, seed + round);
+        int pooledCount = pooled.playRound(pooledIds.data(), count, seed + round);
+        if (serialCount != pooledCount || !equal(serialIds.begin(), serialIds.begin() + serialCount,
+                                                 pooledIds.begin())) {
+            cout << "MISMATCH KnockoutKernel n=" << size << " round " << round << ": pooled survivors differ\n";
+            kernelMismatches++;
+            break;
+        }
+        count = serialCount;
+    }
+    for (int i = 0; i < size; i++) serialIds[i] = pooledIds[i] = i;
+    if (serial.playOut(serialIds.data(), size, seed) != pooled.playOut(pooledIds.data(), size, seed)) {
+        cout << "MISMATCH KnockoutKernel n=" << size << ": pooled champion differs\n";
+        kernelMismatches++;
+    }
+
+    vector<int> ids(size);
+    const KnockoutKernel* kernels[2] = { &serial, &pooled };
+    const char* names[2] = { "KnockoutKernel", "KnockoutKernel/pool" };
+    for (int k = 0; k < 2; k++) {
+        const KnockoutKernel& kernel = *kernels[k];
+        int left = 0;
+        runBench(names[k], "playRound", "playOut", size, (double)sizeof(int),
+            [&]() { for (int i = 0; i < size; i++) ids[i] = i; },
+            [&](int n) { left = kernel.playRound(ids.data(), n, seed); },
+            [&](int) { sink += kernel.playOut(ids.data(), left, seed + 1); });
+    }
+}
+
+// ===== REPORTING =====
+
+static void printResults() {
+    cout << left << setw(34) << "Container" << setw(16) << "Operation"
+         << right << setw(8) << "Size" << setw(12) << "ns/op" << setw(14) << "bytes/elem" << "\n";
+    cout << string(84, '-') << "\n";
+    cout << fixed;
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        cout << left << setw(34) << r.container << setw(16) << r.op
+             << right << setw(8) << r.size << setw(12) << setprecision(2) << r.nsPerOp
+             << setw(14) << setprecision(1) << r.bytesPerElement << "\n";
+    }
+}
+
+static bool writeCsv(const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) return false;
+    file << "container,op,size,ns_per_op,bytes_per_element\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        file << r.container << "," << r.op << "," << r.size << "," << r.nsPerOp << "," << r.bytesPerElement << "\n";
+    }
+    return true;
+}
+
+// Returns the number of regressions beyond thresholdPct
+static int compareWithBaseline(const string& filename, double thresholdPct) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Cannot open baseline " << filename << "\n";
+        return -1;
+    }
+
+    string line;
+    getline(file, line);    // Skip header
+    int regressions = 0;
+
+    cout << "\n=== COMPARISON WITH " << filename << " (threshold " << thresholdPct << "%) ===\n";
+    while (getline(file, line)) {
+        stringstream ss(line);
+        string container, op, sizeStr, nsStr;
+        getline(ss, container, ',');
+        getline(ss, op, ',');
+        getline(ss, sizeStr, ',');
+        getline(ss, nsStr, ',');
+        int size = atoi(sizeStr.c_str());
+        double baseline = atof(nsStr.c_str());
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            if (r.container != container || r.op != op || r.size != size) continue;
+
+            double change = (baseline > 0) ? (r.nsPerOp - baseline) / baseline * 100.0 : 0;
+            if (change > thresholdPct) {
+                cout << "REGRESSION " << container << " " << op << " n=" << size << ": "
+                     << setprecision(2) << baseline << " -> " << r.nsPerOp << " ns/op (+"
+                     << setprecision(1) << change << "%)\n";
+                regressions++;
+            }
+        }
+    }
+
+    if (regressions == 0) {
+        cout << "No regressions.\n";
+    }
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    string csvFile, baselineFile;
+    double thresholdPct = 20.0;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--quick") {
+            workBudget = 200000;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filterText = argv[++i];
+        } else if (arg == "--csv" && i + 1 < argc) {
+            csvFile = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            baselineFile = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            thresholdPct = atof(argv[++i]);
+        } else {
+            cout << "Usage: container_bench [--quick] [--filter TEXT] [--csv FILE]\n"
+                 << "                       [--compare BASELINE.csv] [--threshold PCT]\n";
+            return 1;
+        }
+    }
+
+    const int matchSizes[] = { 16, 64, MAX_TEAMS };
+    const int teamSizes[] = { 16, 64, MAX_SIZE };
+    const int playerSizes[] = { 16, 50, MAX_PLAYERS };
+    const int statSizes[] = { 16, 128, 1000 };
+    const int spectatorSizes[] = { 64, 1024, 16384, 262144 };
+    const int knockoutSizes[] = { 4 * KNOCKOUT_PARALLEL_MATCHES, 262144, 1 << 22 };
+
+    for (int i = 0; i < 3; i++) benchMatchContainers(matchSizes[i]);
+    for (int i = 0; i < 3; i++) benchTeamContainers(teamSizes[i]);
+    for (int i = 0; i < 3; i++) benchPlayerRing(playerSizes[i]);
+    for (int i = 0; i < 3; i++) benchStatisticStack(statSizes[i]);
+    for (int i = 0; i < 4; i++) benchSpectatorQueue(spectatorSizes[i]);
+    int hardwareThreads = (int)thread::hardware_concurrency();
+    TaskPool workers(hardwareThreads > 1 ? hardwareThreads : 2);
+    for (int i = 0; i < 3; i++) benchKnockoutKernel(knockoutSizes[i], workers);
+
+    printResults();
+
+    if (!csvFile.empty()) {
+        if (writeCsv(csvFile)) {
+            cout << "\nResults written to " << csvFile << "\n";
+        } else {
+            cout << "\nCannot write " << csvFile << "\n";
+        }
+    }
+
+    if (kernelMismatches > 0) {
+        cout << "\n" << kernelMismatches << " pooled knockout run(s) differ from the serial kernel.\n";
+    }
+    if (!baselineFile.empty() && compareWithBaseline(baselineFile, thresholdPct) > 0) {
+        return 1;
+    }
+    return kernelMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+#include "data_export.hpp"
+#include "apuec_trace.hpp"
+#include "spectator_store.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char* const TIER_NAMES[3] = { "VIP", "Influencer", "General" };
+static const int EXPORT_COPY_CHUNK = 64 * 1024;
+
+// Outcome of one file task
+struct ExportFile {
+    string name;
+    string tempPath;
+    string finalPath;
+    bool ok;
+    string error;
+};
+
+static string describeErrno(const string& path) {
+    return path + ": " + strerror(errno);
+}
+
+bool writeFileDurably(const string& path, const string& content, string& error) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        error = describeErrno(path);
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t n = write(fd, content.data() + written, content.size() - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            error = describeErrno(path);
+            close(fd);
+            return false;
+        }
+        written += n;
+    }
+
+    if (fsync(fd) != 0 || close(fd) != 0) {
+        error = describeErrno(path);
+        return false;
+    }
+    return true;
+}
+
+static bool writeTeams(const ExportSnapshot& snapshot, const string& path, string& error) {
+    APUEC_TRACE_SCOPE("export registration.csv");
+    ostringstream text;
+    RegistrationManager::writeTeams(text, snapshot.teams);
+    return writeFileDurably(path, text.str(), error);
+}
+
+static bool writePlayers(const ExportSnapshot& snapshot, const string& path, string& error) {
+    APUEC_TRACE_SCOPE("export players.csv");
+    ostringstream text;
+    RegistrationSystem::writeCSV(text, snapshot.players);
+    return writeFileDurably(path, text.str(), error);
+}
+
+static bool writeSpectators(const ExportSnapshot& snapshot, const string& path, string& error) {
+    APUEC_TRACE_SCOPE("export spectators.csv");
+    SpectatorCsvWriter writer;
+    if (!writer.open(path, false)) {
+        error = describeErrno(path);
+        return false;
+    }
+    writer.writeHeader();
+    for (size_t i = 0; i < snapshot.spectators.size(); i++) {
+        writer.writeSpectator(snapshot.spectators[i]);
+    }
+    if (!writer.close(true)) {
+        error = describeErrno(path);
+        return false;
+    }
+    return true;
+}
+
+// Copy the first matchLogBytes of the match log; later appends are not
+// part of the snapshot
+static bool writeMatchLog(const ExportSnapshot& snapshot, const string& path, string& error) {
+    APUEC_TRACE_SCOPE("export result.csv");
+    string content;
+    if (snapshot.matchLogBytes > 0) {
+        FILE* source = fopen(snapshot.matchLog.c_str(), "rb");
+        if (source == nullptr) {
+            error = describeErrno(snapshot.matchLog);
+            return false;
+        }
+        content.resize((size_t)snapshot.matchLogBytes);
+        size_t copied = 0;
+        while (copied < content.size()) {
+            size_t chunk = content.size() - copied;
+            if (chunk > (size_t)EXPORT_COPY_CHUNK) chunk = EXPORT_COPY_CHUNK;
+            size_t n = fread(&content[copied], 1, chunk, source);
+            if (n == 0) break;
+            copied += n;
+        }
+        fclose(source);
+        content.resize(copied);
+    }
+    return writeFileDurably(path, content, error);
+}
+
+static bool writeState(const ExportSnapshot& snapshot, const string& path, string& error) {
+    APUEC_TRACE_SCOPE("export system_state.csv");
+    const SystemState& state = snapshot.state;
+    ostringstream file;
+    file << "Key,Value\n";
+    file << "teams," << state.getTeamCount() << "\n";
+    file << "wildcard_teams," << state.getWildcardTeamCount() << "\n";
+    file << "players," << state.getPlayerCount() << "\n";
+    file << "checked_in_players," << state.getCheckedInCount() << "\n";
+    file << "wildcard_players," << state.getWildcardPlayerCount() << "\n";
+    for (int i = 0; i < 3; i++) {
+        file << "waiting_" << TIER_NAMES[i] << "," << state.getWaitingCount(i) << "\n";
+        file << "seated_" << TIER_NAMES[i] << "," << state.getSeatedCount(i) << "\n";
+    }
+    file << "registration_open," << (snapshot.registrationOpen ? 1 : 0) << "\n";
+    file << "matches_played," << state.getMatchesPlayed() << "\n";
+    file << "champion," << state.getChampion() << "\n";
+
+    file << "\nTeam,Status,Wins,Losses\n";
+    const unordered_map<string, TeamRecord>& teams = state.getTeamRecords();
+    for (unordered_map<string, TeamRecord>::const_iterator it = teams.begin(); it != teams.end(); ++it) {
+        file << it->first << "," << it->second.status << "," << it->second.wins << ","
+             << it->second.losses << "\n";
+    }
+    return writeFileDurably(path, file.str(), error);
+}
+
+typedef bool (*ExportWriter)(const ExportSnapshot&, const string&, string&);
+
+int exportSnapshot(const ExportSnapshot& snapshot, const string& directory, TaskPool& pool, string& error) {
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        error = describeErrno(directory);
+        return -1;
+    }
+
+    static const char* const names[] = {
+        "registration.csv", "players.csv", "spectators.csv", "result.csv", "system_state.csv"
+    };
+    static const ExportWriter writers[] = {
+        writeTeams, writePlayers, writeSpectators, writeMatchLog, writeState
+    };
+    const int fileCount = sizeof(names) / sizeof(names[0]);
+
+    vector<ExportFile> files(fileCount);
+    for (int i = 0; i < fileCount; i++) {
+        ExportFile& file = files[i];
+        file.name = names[i];
+        file.finalPath = directory + "/" + names[i];
+        file.tempPath = file.finalPath + ".tmp";
+        file.ok = false;
+
+        ExportWriter writer = writers[i];
+        pool.submit([&snapshot, &file, writer]() {
+            file.ok = writer(snapshot, file.tempPath, file.error);
+        });
+    }
+    pool.wait();
+
+    // All or nothing: a failed file leaves the previous export untouched
+    for (int i = 0; i < fileCount; i++) {
+        if (!files[i].ok) {
+            error = files[i].error;
+            for (int j = 0; j < fileCount; j++) {
+                unlink(files[j].tempPath.c_str());
+            }
+            return -1;
+        }
+    }
+    for (int i = 0; i < fileCount; i++) {
+        if (rename(files[i].tempPath.c_str(), files[i].finalPath.c_str()) != 0) {
+            error = describeErrno(files[i].finalPath);
+            return -1;
+        }
+    }
+
+    // Make the renames themselves durable
+    int dirFd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+    return fileCount;
+}
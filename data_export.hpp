@@ -0,0 +1,38 @@
+#ifndef DATA_EXPORT_HPP
+#define DATA_EXPORT_HPP
+
+#include "RegistrationManager.hpp"
+#include "RegistrationSystem.hpp"
+#include "spectator_manager.hpp"
+#include "system_state.hpp"
+#include "task_pool.hpp"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Point-in-time copy of everything a full export writes. Taking it is
+// the only part of an export that reads the modules; the files are then
+// formatted and written from this copy.
+struct ExportSnapshot {
+    vector<Team> teams;
+    vector<Player> players;
+    vector<Spectator> spectators;   // Seated, then waiting
+    string matchLog;                // Source of result.csv
+    long long matchLogBytes;        // Length of matchLog when taken (-1 = no log)
+    SystemState state;
+    bool registrationOpen;
+};
+
+// Write registration.csv, players.csv, spectators.csv, result.csv and
+// system_state.csv for the snapshot into directory, one pool task per
+// file. Each file is written to "<name>.tmp" and fsynced; only when all
+// of them succeeded are they renamed into place, so the directory
+// always holds one complete export. Returns the files written, or -1
+// with error set.
+int exportSnapshot(const ExportSnapshot& snapshot, const string& directory, TaskPool& pool, string& error);
+
+// Write content to path and fsync it; false with error set on failure
+bool writeFileDurably(const string& path, const string& content, string& error);
+
+#endif
@@ -0,0 +1,588 @@
+/**
+ * APUEC Engine Checks
+ *
+ * Deterministic self-checks for the tournament engines, run by ctest.
+ * Every check plays fixed-seed events and compares the engine against an
+ * invariant or a slow reference:
+ *   - Bracket: size, node order, feeds, bye placement and loss counts
+ *     over a full play-out, for 1..40 entrants in every format
+ *   - LiveBracket: reported results and the ready set against a Bracket
+ *     given the same results, and rejection of invalid reports
+ *   - MatchDayPlanner: station overlap, rest and bracket order in every
+ *     re-plan of a simulated match day with an overrunning match
+ *   - GroupStage: round robin pairs meet exactly once, Swiss rounds pair
+ *     every entrant once with at most one bye each and no rematches
+ *   - WhatIfEngine: reach probabilities against exhaustive enumeration
+ *     of every upper bracket outcome
+ *
+ * Usage: engine_check
+ * Prints one line per check and every failure; exits with 1 on any failure.
+ */
+
+#include "bracket.hpp"
+#include "group_stage.hpp"
+#include "live_bracket.hpp"
+#include "match_day.hpp"
+#include "what_if.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+static int failures = 0;
+
+static bool expect(bool ok, const string& what) {
+    if (!ok) {
+        cout << "FAIL " << what << "\n";
+        failures++;
+    }
+    return ok;
+}
+
+static string describeBracket(int entrants, BracketFormat format, bool bracketReset) {
+    ostringstream text;
+    text << entrants << (format == BRACKET_SINGLE_ELIMINATION ? " SE" : (bracketReset ? " DE" : " DE no-reset"));
+    return text.str();
+}
+
+// ===== BRACKET LAYOUT =====
+
+static void checkBracket(int entrants, BracketFormat format, bool bracketReset, mt19937& rng) {
+    string name = "Bracket " + describeBracket(entrants, format, bracketReset);
+    Bracket bracket(entrants, format, bracketReset);
+    int size = bracket.getSize();
+    expect(size >= 2 && (size & (size - 1)) == 0 && size >= entrants && (size == 2 || size / 2 < entrants),
+           name + ": size " + to_string(size));
+
+    // Node counts per side, and every destination comes later in playing order
+    int counts[4] = { 0, 0, 0, 0 };
+    vector<int> feeds(bracket.getNodeCount() * 2, 0);
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        const BracketNode& info = bracket.getNode(node);
+        counts[info.side]++;
+        int targets[2] = { info.winnerTo, info.loserTo };
+        for (int t = 0; t < 2; t++) {
+            if (targets[t] < 0) continue;
+            expect(targets[t] / 2 > node, name + ": node " + to_string(node) + " feeds an earlier node");
+            feeds[targets[t]]++;
+        }
+    }
+    bool doubleElimination = format == BRACKET_DOUBLE_ELIMINATION;
+    expect(counts[SIDE_UPPER] == size - 1, name + ": upper node count");
+    expect(counts[SIDE_LOWER] == (doubleElimination ? size - 2 : 0), name + ": lower node count");
+    expect(counts[SIDE_GRAND_FINAL] == (doubleElimination ? 1 : 0), name + ": grand final count");
+    expect(counts[SIDE_RESET] == (doubleElimination && bracketReset ? 1 : 0), name + ": reset count");
+
+    // Each slot past the first upper round is filled by exactly one match;
+    // the reset is filled by the grand final itself
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        const BracketNode& info = bracket.getNode(node);
+        bool firstRound = info.side == SIDE_UPPER && info.round == 0;
+        int expected = (firstRound || node == bracket.getResetNode()) ? 0 : 1;
+        for (int slot = 0; slot < 2; slot++) {
+            expect(feeds[node * 2 + slot] == expected,
+                   name + ": node " + to_string(node) + " slot " + to_string(slot) + " fed "
+                   + to_string(feeds[node * 2 + slot]) + " times");
+        }
+    }
+
+    // Byes: one per first-round match at most, all to the top seeds
+    bracket.start();
+    int byes = 0;
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        const BracketNode& info = bracket.getNode(node);
+        if (info.side != SIDE_UPPER || info.round != 0) continue;
+        int empty = (bracket.getTeam(node, 0) == SLOT_EMPTY) + (bracket.getTeam(node, 1) == SLOT_EMPTY);
+        expect(empty < 2, name + ": first-round match " + to_string(node) + " has no team");
+        if (empty == 1) {
+            byes++;
+            int team = bracket.getTeam(node, bracket.getTeam(node, 0) == SLOT_EMPTY ? 1 : 0);
+            expect(bracket.isBye(node) && team < size - entrants,
+                   name + ": bye in match " + to_string(node) + " goes to seed " + to_string(team));
+        }
+    }
+    expect(byes == size - entrants, name + ": " + to_string(byes) + " byes");
+
+    // One pass in index order plays the whole bracket
+    vector<int> losses(entrants, 0);
+    int played = 0;
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        if (!bracket.isReady(node)) continue;
+        expect(bracket.setWinner(node, (int)(rng() & 1)), name + ": setWinner on a ready match");
+        losses[bracket.getLoser(node)]++;
+        played++;
+    }
+    if (!expect(bracket.isFinished(), name + ": not finished after one pass")) return;
+    int champion = bracket.getChampion();
+    if (!expect(champion >= 0 && champion < entrants, name + ": champion " + to_string(champion))) return;
+
+    int totalLosses = 0;
+    int eliminatedOnce = 0;
+    for (int team = 0; team < entrants; team++) {
+        totalLosses += losses[team];
+        if (team == champion) {
+            expect(losses[team] <= (doubleElimination ? 1 : 0), name + ": champion lost " + to_string(losses[team]));
+        } else if (!doubleElimination) {
+            expect(losses[team] == 1, name + ": team " + to_string(team) + " lost " + to_string(losses[team]));
+        } else {
+            expect(losses[team] == 1 || losses[team] == 2,
+                   name + ": team " + to_string(team) + " lost " + to_string(losses[team]));
+            if (losses[team] == 1) eliminatedOnce++;
+        }
+    }
+    // Without a reset, only the grand final loser goes out after one loss
+    expect(eliminatedOnce <= (doubleElimination && !bracketReset ? 1 : 0), name + ": teams out after one loss");
+    expect(played == totalLosses, name + ": played matches");
+    expect(!bracket.setWinner(bracket.getNodeCount() - 1, 0), name + ": result accepted after the final");
+}
+
+static void checkBracketLayout() {
+    mt19937 rng(1);
+    int brackets = 0;
+    for (int entrants = 1; entrants <= 40; entrants++) {
+        checkBracket(entrants, BRACKET_SINGLE_ELIMINATION, false, rng);
+        checkBracket(entrants, BRACKET_DOUBLE_ELIMINATION, true, rng);
+        checkBracket(entrants, BRACKET_DOUBLE_ELIMINATION, false, rng);
+        brackets += 3;
+    }
+    cout << "Bracket layout:      " << brackets << " brackets played\n";
+}
+
+// ===== LIVE BRACKET =====
+
+// Ready nodes of the shadow bracket, in playing order
+static vector<int> readyNodes(const Bracket& bracket) {
+    vector<int> nodes;
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        if (bracket.isReady(node)) nodes.push_back(node);
+    }
+    return nodes;
+}
+
+static vector<int> liveIds(const vector<LiveMatch>& matches) {
+    vector<int> ids;
+    for (size_t i = 0; i < matches.size(); i++) ids.push_back(matches[i].id);
+    return ids;
+}
+
+static void checkLive(int entrants, BracketFormat format, mt19937& rng, int& reports) {
+    string name = "LiveBracket " + describeBracket(entrants, format, true);
+    vector<string> teamNames;
+    for (int i = 0; i < entrants; i++) teamNames.push_back("Team" + to_string(i + 1));
+    LiveBracket live(teamNames, format);
+    Bracket shadow(entrants, format);
+    shadow.start();
+
+    vector<LiveMatch> ready;
+    vector<LiveMatch> nowReady;
+    live.start(nowReady);
+    LiveMatch played;
+    string error;
+
+    while (!live.isFinished()) {
+        live.getReadyMatches(ready);
+        if (!expect(liveIds(ready) == readyNodes(shadow), name + ": ready set differs from the bracket")) return;
+        if (!expect(!ready.empty(), name + ": nothing ready before the end")) return;
+        expect(live.getReadyCount() == (int)ready.size(), name + ": ready count");
+
+        const LiveMatch& match = ready[rng() % ready.size()];
+        expect(!live.report(match.teamA, "Nobody", played, nowReady, error) && !error.empty(),
+               name + ": report against an unknown team accepted");
+        if (ready.size() > 1) {
+            const LiveMatch& other = ready[(&match - &ready[0] + 1) % ready.size()];
+            expect(!live.report(match.teamA, other.teamB, played, nowReady, error),
+                   name + ": report across two matches accepted");
+        }
+
+        int winnerSlot = (int)(rng() & 1);
+        const string& winner = winnerSlot == 0 ? match.teamA : match.teamB;
+        const string& loser = winnerSlot == 0 ? match.teamB : match.teamA;
+        int node = match.id;
+        if (!expect(live.report(winner, loser, played, nowReady, error), name + ": report refused: " + error)) return;
+        expect(played.id == node, name + ": report decided another match");
+        shadow.setWinner(node, winnerSlot);
+        reports++;
+
+        // The same two teams can meet again (grand final, bracket reset)
+        vector<int> expectedNow = readyNodes(shadow);
+        bool rematch = false;
+        for (size_t i = 0; i < nowReady.size(); i++) {
+            expect(binary_search(expectedNow.begin(), expectedNow.end(), nowReady[i].id),
+                   name + ": match " + to_string(nowReady[i].id) + " handed back but not ready");
+            if ((nowReady[i].teamA == winner || nowReady[i].teamB == winner)
+                && (nowReady[i].teamA == loser || nowReady[i].teamB == loser)) rematch = true;
+        }
+        if (!rematch) {
+            expect(!live.report(winner, loser, played, nowReady, error), name + ": same result reported twice");
+        }
+    }
+
+    expect(shadow.isFinished(), name + ": bracket still running");
+    expect(live.getChampion() == teamNames[shadow.getChampion()], name + ": champion differs");
+    expect(live.getReadyCount() == 0, name + ": matches still ready at the end");
+    expect(!live.report(teamNames[0], teamNames[entrants - 1], played, nowReady, error),
+           name + ": report accepted after the final");
+}
+
+static void checkLiveBracket() {
+    mt19937 rng(2);
+    int reports = 0;
+    int sizes[] = { 2, 3, 5, 13, 32, 37 };
+    for (int i = 0; i < 6; i++) {
+        checkLive(sizes[i], BRACKET_SINGLE_ELIMINATION, rng, reports);
+        checkLive(sizes[i], BRACKET_DOUBLE_ELIMINATION, rng, reports);
+    }
+    cout << "LiveBracket:         " << reports << " reports\n";
+}
+
+// ===== MATCH DAY PLANNER =====
+
+// Violations of the planner's guarantees in its last plan from minute now
+static int checkPlan(const Bracket& bracket, const MatchDayPlanner& planner, int now, const string& name) {
+    const vector<PlannedMatch>& plan = planner.getPlan();
+    int violations = 0;
+
+    map<int, vector<pair<int, int> > > byStation;
+    map<int, const PlannedMatch*> byNode;
+    for (size_t i = 0; i < plan.size(); i++) {
+        byStation[plan[i].station].push_back(make_pair(plan[i].start, plan[i].end));
+        byNode[plan[i].node] = &plan[i];
+        if (!expect(plan[i].end - plan[i].start == planner.getMatchMinutes() || plan[i].started,
+                    name + ": match " + to_string(plan[i].node) + " planned with the wrong length")) violations++;
+    }
+    for (map<int, vector<pair<int, int> > >::iterator it = byStation.begin(); it != byStation.end(); ++it) {
+        vector<pair<int, int> >& slots = it->second;
+        sort(slots.begin(), slots.end());
+        for (size_t i = 1; i < slots.size(); i++) {
+            if (!expect(slots[i].first >= slots[i - 1].second,
+                        name + ": station " + to_string(it->first) + " double-booked at " + to_string(slots[i].first)))
+                violations++;
+        }
+    }
+
+    vector<int> feeder(bracket.getNodeCount() * 2, -1);
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        const BracketNode& info = bracket.getNode(node);
+        if (info.winnerTo >= 0) feeder[info.winnerTo] = node;
+        if (info.loserTo >= 0) feeder[info.loserTo] = node;
+    }
+    if (bracket.getResetNode() >= 0) {
+        feeder[bracket.getResetNode() * 2] = feeder[bracket.getResetNode() * 2 + 1] = bracket.getGrandFinal();
+    }
+    for (size_t i = 0; i < plan.size(); i++) {
+        if (plan[i].started) continue;
+        if (!expect(plan[i].start >= now, name + ": match " + to_string(plan[i].node) + " planned in the past"))
+            violations++;
+        for (int slot = 0; slot < 2; slot++) {
+            int from = feeder[plan[i].node * 2 + slot];
+            if (from < 0 || byNode.find(from) == byNode.end()) continue;
+            if (!expect(byNode[from]->end + planner.getRestMinutes() <= plan[i].start,
+                        name + ": match " + to_string(plan[i].node) + " starts before its teams have rested"))
+                violations++;
+        }
+    }
+    return violations;
+}
+
+// Follow the plan minute by minute; the third match overruns by 25 minutes
+static void simulateMatchDay(int entrants, BracketFormat format, mt19937& rng, int& replans) {
+    string name = "MatchDayPlanner " + describeBracket(entrants, format, true);
+    const int matchMinutes = 30;
+    Bracket bracket(entrants, format);
+    bracket.start();
+    MatchDayPlanner planner(bracket, 4, matchMinutes, 10);
+
+    map<int, int> endOf;
+    int now = 0;
+    int started = 0;
+    for (int step = 0; !bracket.isFinished(); step++) {
+        if (!expect(step < 10 * bracket.getNodeCount(), name + ": match day does not finish")) return;
+        planner.plan(now);
+        replans++;
+        if (checkPlan(bracket, planner, now, name) > 0) return;
+
+        const vector<PlannedMatch>& plan = planner.getPlan();
+        for (size_t i = 0; i < plan.size(); i++) {
+            const PlannedMatch& match = plan[i];
+            if (match.started || match.start != now || !bracket.isReady(match.node)) continue;
+            if (!planner.startMatch(match.node, match.station, now)) continue;
+            endOf[match.node] = now + matchMinutes + (++started == 3 ? 25 : 0);
+        }
+
+        int next = -1;
+        for (map<int, int>::iterator it = endOf.begin(); it != endOf.end(); ++it) {
+            if (next < 0 || it->second < next) next = it->second;
+        }
+        planner.plan(now);
+        for (size_t i = 0; i < planner.getPlan().size(); i++) {
+            const PlannedMatch& match = planner.getPlan()[i];
+            if (!match.started && match.start > now && (next < 0 || match.start < next)) next = match.start;
+        }
+        if (!expect(next > now, name + ": nothing planned after minute " + to_string(now))) return;
+        now = next;
+        for (map<int, int>::iterator it = endOf.begin(); it != endOf.end();) {
+            if (it->second == now) {
+                planner.finishMatch(it->first, now);
+                bracket.setWinner(it->first, (int)(rng() & 1));
+                endOf.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+    expect(endOf.empty(), name + ": matches still running after the final");
+}
+
+static void checkMatchDay() {
+    mt19937 rng(3);
+    int replans = 0;
+    int sizes[] = { 2, 3, 5, 16, 37, 100 };
+    for (int i = 0; i < 6; i++) {
+        simulateMatchDay(sizes[i], BRACKET_SINGLE_ELIMINATION, rng, replans);
+        simulateMatchDay(sizes[i], BRACKET_DOUBLE_ELIMINATION, rng, replans);
+    }
+    cout << "MatchDayPlanner:     " << replans << " plans checked\n";
+}
+
+// ===== GROUP STAGE =====
+
+static void checkGroups(int entrants, int groups, GroupFormat format, int swissRounds, mt19937& rng) {
+    ostringstream label;
+    label << "GroupStage " << entrants << "/" << groups << (format == GROUP_SWISS ? " Swiss" : " round robin");
+    string name = label.str();
+    GroupStage stage(entrants, groups, format, swissRounds);
+
+    // Snake seeding, so group sizes differ by at most one
+    int g = stage.getGroupCount();
+    for (int i = 0; i < entrants; i++) {
+        int column = i % g;
+        int expected = ((i / g) % 2 == 0) ? column : g - 1 - column;
+        expect(stage.getGroupOf(i) == expected, name + ": seed " + to_string(i) + " in group " + to_string(stage.getGroupOf(i)));
+    }
+
+    set<pair<int, int> > met;
+    vector<int> byes(entrants, 0);
+    vector<GroupFixture> fixtures;
+    int rounds = 0;
+    int matches = 0;
+    int rematches = 0;
+    while (stage.nextRound(fixtures)) {
+        rounds++;
+        vector<int> appearances(entrants, 0);
+        for (size_t i = 0; i < fixtures.size(); i++) {
+            const GroupFixture& fixture = fixtures[i];
+            appearances[fixture.teamA]++;
+            expect(stage.getGroupOf(fixture.teamA) == fixture.group, name + ": fixture outside its group");
+            if (fixture.teamB < 0) {
+                expect(format == GROUP_SWISS && stage.getGroupSize(fixture.group) % 2 == 1,
+                       name + ": bye in an even group");
+                byes[fixture.teamA]++;
+                continue;
+            }
+            appearances[fixture.teamB]++;
+            expect(stage.getGroupOf(fixture.teamB) == fixture.group, name + ": fixture outside its group");
+            pair<int, int> key(min(fixture.teamA, fixture.teamB), max(fixture.teamA, fixture.teamB));
+            if (!met.insert(key).second) rematches++;
+            expect(stage.recordResult(fixture, (rng() & 1) ? fixture.teamA : fixture.teamB), name + ": result refused");
+            matches++;
+        }
+        for (int i = 0; i < entrants; i++) {
+            // Round robin groups smaller than the largest finish early
+            bool idle = format == GROUP_ROUND_ROBIN && appearances[i] == 0;
+            expect(appearances[i] == 1 || idle,
+                   name + ": round " + to_string(rounds) + " has seed " + to_string(i) + " "
+                   + to_string(appearances[i]) + " times");
+        }
+    }
+    expect(rounds == stage.getRoundCount(), name + ": " + to_string(rounds) + " rounds");
+    expect(rematches == stage.getRematches(), name + ": rematch count");
+    expect(rematches == 0, name + ": " + to_string(rematches) + " rematches");
+
+    // A bye is worth a point but is not a win
+    int totalPoints = 0;
+    int totalWins = 0;
+    int totalLosses = 0;
+    for (int i = 0; i < entrants; i++) {
+        totalPoints += stage.getPoints(i);
+        totalWins += stage.getWins(i);
+        totalLosses += stage.getLosses(i);
+        expect(byes[i] <= 1, name + ": seed " + to_string(i) + " had " + to_string(byes[i]) + " byes");
+    }
+    int byeCount = 0;
+    for (int i = 0; i < entrants; i++) byeCount += byes[i];
+    expect(totalWins == matches && totalLosses == matches && totalPoints == matches + byeCount,
+           name + ": standings do not add up");
+
+    if (format == GROUP_ROUND_ROBIN) {
+        int pairs = 0;
+        for (int group = 0; group < g; group++) {
+            int size = stage.getGroupSize(group);
+            pairs += size * (size - 1) / 2;
+        }
+        expect((int)met.size() == pairs, name + ": " + to_string(met.size()) + " of " + to_string(pairs) + " pairs met");
+    }
+}
+
+static void checkGroupStage() {
+    mt19937 rng(4);
+    int stages = 0;
+    int roundRobin[][2] = { { 12, 3 }, { 10, 3 }, { 7, 1 }, { 16, 4 } };
+    for (int i = 0; i < 4; i++, stages++) {
+        checkGroups(roundRobin[i][0], roundRobin[i][1], GROUP_ROUND_ROBIN, 0, rng);
+    }
+    // Rounds stay below what a group can fill without rematches
+    int swiss[][3] = { { 16, 1, 4 }, { 13, 1, 4 }, { 40, 4, 3 }, { 96, 3, 5 }, { 9, 1, 3 } };
+    for (int i = 0; i < 5; i++, stages++) {
+        checkGroups(swiss[i][0], swiss[i][1], GROUP_SWISS, swiss[i][2], rng);
+    }
+    cout << "GroupStage:          " << stages << " stages played\n";
+}
+
+// ===== WHAT-IF =====
+
+// Upper round entrant reached in a bracket whose upper side is played out
+// (getUpperRounds() = won the upper bracket)
+static int reachedRound(const Bracket& bracket, int entrant) {
+    int best = -1;
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        if (bracket.getNode(node).side != SIDE_UPPER) continue;
+        int round = bracket.getNode(node).round;
+        if (bracket.getTeam(node, 0) == entrant || bracket.getTeam(node, 1) == entrant) best = max(best, round);
+        if (bracket.getWinner(node) == entrant) best = max(best, round + 1);
+    }
+    return best;
+}
+
+static bool upperResult(const Bracket& bracket, int winner, int loser) {
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        if (bracket.getNode(node).side == SIDE_UPPER && bracket.getWinner(node) == winner
+            && bracket.getLoser(node) == loser) return true;
+    }
+    return false;
+}
+
+struct Enumeration {
+    const OutcomeModel* model;
+    vector<function<bool(const Bracket&)> > conditions;
+    vector<vector<double> > reach;      // Entrant -> round -> weight
+    double total;
+};
+
+// Every way the open upper matches can go, weighted by the model
+static void enumerate(const Bracket& bracket, double weight, Enumeration& result) {
+    int node = 0;
+    while (node < bracket.getNodeCount() && (bracket.getNode(node).side != SIDE_UPPER || !bracket.isReady(node))) node++;
+    if (node == bracket.getNodeCount()) {
+        for (size_t i = 0; i < result.conditions.size(); i++) {
+            if (!result.conditions[i](bracket)) return;
+        }
+        result.total += weight;
+        for (size_t entrant = 0; entrant < result.reach.size(); entrant++) {
+            int reached = reachedRound(bracket, (int)entrant);
+            for (int round = 0; round <= reached && round < (int)result.reach[entrant].size(); round++) {
+                result.reach[entrant][round] += weight;
+            }
+        }
+        return;
+    }
+    for (int slot = 0; slot < 2; slot++) {
+        Bracket next = bracket;
+        double p = result.model->winProbability(bracket.getTeam(node, slot), bracket.getTeam(node, 1 - slot));
+        next.setWinner(node, slot);
+        enumerate(next, weight * p, result);
+    }
+}
+
+static void checkWhatIf() {
+    mt19937 rng(5);
+    int compared = 0;
+    double worst = 0;
+    for (int trial = 0; trial < 300; trial++) {
+        int entrants = 2 + (int)(rng() % 11);
+        BracketFormat format = (rng() & 1) ? BRACKET_DOUBLE_ELIMINATION : BRACKET_SINGLE_ELIMINATION;
+        string name = "WhatIfEngine trial " + to_string(trial) + " " + describeBracket(entrants, format, true);
+        Bracket bracket(entrants, format);
+        bracket.start();
+        OutcomeModel model(entrants);
+        for (int i = 0; i < entrants; i++) model.setRating(i, 1300 + (int)(rng() % 500));
+
+        // A few upper results already played
+        int played = (int)(rng() % 4);
+        for (int k = 0; k < played; k++) {
+            for (int node = 0; node < bracket.getNodeCount(); node++) {
+                if (bracket.getNode(node).side == SIDE_UPPER && bracket.isReady(node)) {
+                    bracket.setWinner(node, (int)(rng() & 1));
+                    break;
+                }
+            }
+        }
+
+        WhatIfEngine engine(bracket, model);
+        Enumeration reference;
+        reference.model = &model;
+        reference.total = 0;
+        reference.reach.assign(entrants, vector<double>(bracket.getUpperRounds() + 1, 0.0));
+        bool accepted = true;
+        int fixes = (int)(rng() % 3);
+        for (int k = 0; k < fixes && accepted; k++) {
+            int a = (int)(rng() % entrants);
+            int b = (int)(rng() % entrants);
+            if (a == b) continue;
+            if (rng() & 1) {
+                accepted = engine.fix(a, b);
+                reference.conditions.push_back([a, b](const Bracket& x) { return upperResult(x, a, b); });
+            } else {
+                int wins = 0;
+                for (int node = 0; node < bracket.getNodeCount(); node++) {
+                    if (bracket.getNode(node).side == SIDE_UPPER && bracket.getWinner(node) == a) wins++;
+                }
+                accepted = engine.fixNext(a);
+                reference.conditions.push_back([a, wins](const Bracket& x) { return reachedRound(x, a) > wins; });
+            }
+        }
+        if (!accepted) continue;
+
+        enumerate(bracket, 1.0, reference);
+        bool possible = engine.evaluate();
+        if (reference.total < 1e-15) {
+            expect(!possible, name + ": impossible evidence evaluated");
+            continue;
+        }
+        if (!expect(possible, name + ": possible evidence refused")) continue;
+
+        double championTotal = 0;
+        for (int entrant = 0; entrant < entrants; entrant++) {
+            for (int round = 0; round <= bracket.getUpperRounds(); round++) {
+                double exact = reference.reach[entrant][round] / reference.total;
+                worst = max(worst, fabs(engine.getReachProbability(entrant, round) - exact));
+            }
+            championTotal += engine.getReachProbability(entrant, bracket.getUpperRounds());
+        }
+        expect(fabs(championTotal - 1.0) < 1e-9, name + ": champion probabilities sum to " + to_string(championTotal));
+        compared++;
+    }
+    expect(worst < 1e-9, "WhatIfEngine: max error " + to_string(worst));
+    cout << "WhatIfEngine:        " << compared << " evaluations compared, max error " << worst << "\n";
+}
+
+int main() {
+    checkBracketLayout();
+    checkLiveBracket();
+    checkMatchDay();
+    checkGroupStage();
+    checkWhatIf();
+
+    if (failures > 0) {
+        cout << failures << " check(s) failed\n";
+        return 1;
+    }
+    cout << "All engine checks passed\n";
+    return 0;
+}
@@ -0,0 +1,312 @@
+#include "group_stage.hpp"
+#include "apuec_trace.hpp"
+#include <algorithm>
+
+static const int SWISS_REPAIR_DEPTH = 16;   // Earlier pairs tried before accepting a rematch
+
+GroupStage::GroupStage(int entrants, int groups, GroupFormat groupFormat, int swissRounds)
+    : format(groupFormat), entrantCount(entrants < 0 ? 0 : entrants), roundsPlayed(0),
+      tieBreaksCurrent(true), rematches(0) {
+    groupCount = groups < 1 ? 1 : groups;
+    if (entrantCount > 0 && groupCount > entrantCount) {
+        groupCount = entrantCount;
+    }
+
+    // Snake seeding: seeds 1..G go to groups 1..G, seeds G+1..2G to G..1, ...
+    groupOf.resize(entrantCount);
+    vector<int> sizes(groupCount, 0);
+    for (int i = 0; i < entrantCount; i++) {
+        int row = i / groupCount;
+        int column = i % groupCount;
+        int g = (row % 2 == 0) ? column : groupCount - 1 - column;
+        groupOf[i] = g;
+        sizes[g]++;
+    }
+    groupStart.resize(groupCount + 1);
+    groupStart[0] = 0;
+    for (int g = 0; g < groupCount; g++) {
+        groupStart[g + 1] = groupStart[g] + sizes[g];
+    }
+    members.resize(entrantCount);
+    vector<int> next(groupStart.begin(), groupStart.end() - 1);
+    for (int i = 0; i < entrantCount; i++) {
+        members[next[groupOf[i]]++] = i;
+    }
+
+    if (format == GROUP_ROUND_ROBIN) {
+        roundCount = 0;
+        for (int g = 0; g < groupCount; g++) {
+            int size = sizes[g];
+            int rounds = (size % 2 == 0) ? size - 1 : size;
+            if (rounds > roundCount) roundCount = rounds;
+        }
+    } else {
+        roundCount = swissRounds < 0 ? 0 : swissRounds;
+        opponents.assign((size_t)entrantCount * roundCount, -1);
+    }
+
+    points.assign(entrantCount, 0);
+    wins.assign(entrantCount, 0);
+    losses.assign(entrantCount, 0);
+    buchholz.assign(entrantCount, 0);
+    sonnebornBerger.assign(entrantCount, 0);
+    hadBye.assign(entrantCount, 0);
+}
+
+// Circle method: slot 0 stays put, the others rotate one place per
+// round, and slot i meets slot n-1-i. An odd group adds a resting slot.
+void GroupStage::pairRoundRobin(int g, vector<GroupFixture>& fixtures) const {
+    int size = getGroupSize(g);
+    int slots = (size % 2 == 0) ? size : size + 1;
+    if (roundsPlayed >= slots - 1) {
+        return;
+    }
+    const int* group = getGroupMembers(g);
+    for (int i = 0; i < slots / 2; i++) {
+        int j = slots - 1 - i;
+        int a = (i == 0) ? 0 : 1 + (i - 1 + roundsPlayed) % (slots - 1);
+        int b = 1 + (j - 1 + roundsPlayed) % (slots - 1);
+        if (a >= size || b >= size) continue;   // Resting this round
+
+        GroupFixture fixture;
+        fixture.group = g;
+        fixture.round = roundsPlayed;
+        fixture.teamA = group[a];
+        fixture.teamB = group[b];
+        fixtures.push_back(fixture);
+    }
+}
+
+int GroupStage::scoreLevel(int entrant) const {
+    int score = points[entrant] < roundsPlayed ? points[entrant] : roundsPlayed;
+    return roundsPlayed - score;
+}
+
+bool GroupStage::hasMet(int a, int b) const {
+    const int* met = &opponents[(size_t)a * roundCount];
+    for (int r = 0; r < roundsPlayed; r++) {
+        if (met[r] == b) return true;
+    }
+    return false;
+}
+
+// Swiss pairing, near-linear in the group size:
+// 1. Counting sort by score (a score never exceeds the rounds played),
+//    which keeps seed order inside each score group.
+// 2. Walk from the top and give each team the next unpaired team it has
+//    not met. Unpaired teams form a linked list, so paired teams are never
+//    rescanned, and a team has met at most roundsPlayed others, so each
+//    search stops within roundsPlayed + 1 candidates. Teams a score group
+//    cannot pair float down into the next one.
+// 3. A team left with only past opponents swaps partners with one of the
+//    last few pairs instead of taking a rematch, when a swap works.
+void GroupStage::pairSwiss(int g, vector<GroupFixture>& fixtures) {
+    int size = getGroupSize(g);
+    const int* group = getGroupMembers(g);
+    if (size == 0) {
+        return;
+    }
+
+    int levels = roundsPlayed + 1;          // Score level 0 = best possible score
+    vector<int> levelStart(levels + 1, 0);
+    for (int i = 0; i < size; i++) {
+        levelStart[scoreLevel(group[i]) + 1]++;
+    }
+    for (int level = 0; level < levels; level++) {
+        levelStart[level + 1] += levelStart[level];
+    }
+    vector<int> order(size);
+    for (int i = 0; i < size; i++) {
+        order[levelStart[scoreLevel(group[i])]++] = group[i];
+    }
+
+    GroupFixture fixture;
+    fixture.group = g;
+    fixture.round = roundsPlayed;
+
+    int bye = -1;
+    if (size % 2 == 1) {
+        bye = size - 1;
+        for (int i = size - 1; i >= 0; i--) {
+            if (!hadBye[order[i]]) {
+                bye = i;
+                break;
+            }
+        }
+        int team = order[bye];
+        hadBye[team] = 1;
+        points[team]++;
+        tieBreaksCurrent = false;
+        fixture.teamA = team;
+        fixture.teamB = -1;
+        fixtures.push_back(fixture);
+    }
+
+    const int END = size;
+    vector<int> next(size);
+    int head = END;
+    for (int i = size - 1; i >= 0; i--) {
+        if (i == bye) continue;
+        next[i] = head;
+        head = i;
+    }
+
+    vector<int> pairA;
+    vector<int> pairB;
+    pairA.reserve(size / 2);
+    pairB.reserve(size / 2);
+    while (head != END) {
+        int a = order[head];
+        head = next[head];
+
+        int previous = -1;
+        int chosen = -1;
+        for (int pos = head; pos != END; previous = pos, pos = next[pos]) {
+            if (!hasMet(a, order[pos])) {
+                chosen = pos;
+                break;
+            }
+        }
+        bool forced = (chosen < 0);
+        if (forced) {
+            chosen = head;          // Only past opponents are left
+            previous = -1;
+        }
+        if (previous < 0) {
+            head = next[chosen];
+        } else {
+            next[previous] = next[chosen];
+        }
+
+        int b = order[chosen];
+        if (forced && swapIntoRecentPair(a, b, pairA, pairB)) {
+            continue;
+        }
+        if (forced) {
+            rematches++;
+        }
+        pairA.push_back(a);
+        pairB.push_back(b);
+    }
+
+    for (size_t i = 0; i < pairA.size(); i++) {
+        int a = pairA[i];
+        int b = pairB[i];
+        opponents[(size_t)a * roundCount + roundsPlayed] = b;
+        opponents[(size_t)b * roundCount + roundsPlayed] = a;
+        fixture.teamA = a;
+        fixture.teamB = b;
+        fixtures.push_back(fixture);
+    }
+}
+
+// a and b have met and nobody else is left for them. Re-pair them with
+// the two teams of one of the last SWISS_REPAIR_DEPTH pairs if both new
+// pairs are first meetings.
+bool GroupStage::swapIntoRecentPair(int a, int b, vector<int>& pairA, vector<int>& pairB) const {
+    int stop = (int)pairA.size() - SWISS_REPAIR_DEPTH;
+    for (int k = (int)pairA.size() - 1; k >= 0 && k >= stop; k--) {
+        int p = pairA[k];
+        int q = pairB[k];
+        if (!hasMet(a, p) && !hasMet(b, q)) {
+            pairB[k] = a;
+            pairA.push_back(b);
+            pairB.push_back(q);
+            return true;
+        }
+        if (!hasMet(a, q) && !hasMet(b, p)) {
+            pairA[k] = a;
+            pairA.push_back(b);
+            pairB.push_back(p);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GroupStage::nextRound(vector<GroupFixture>& fixtures) {
+    APUEC_TRACE_SCOPE("GroupStage::nextRound");
+    fixtures.clear();
+    if (roundsPlayed >= roundCount) {
+        return false;
+    }
+    for (int g = 0; g < groupCount; g++) {
+        if (format == GROUP_ROUND_ROBIN) {
+            pairRoundRobin(g, fixtures);
+        } else {
+            pairSwiss(g, fixtures);
+        }
+    }
+    roundsPlayed++;
+    return true;
+}
+
+bool GroupStage::recordResult(const GroupFixture& fixture, int winner) {
+    if (fixture.teamB < 0 || (winner != fixture.teamA && winner != fixture.teamB)) {
+        return false;
+    }
+    int loser = (winner == fixture.teamA) ? fixture.teamB : fixture.teamA;
+    points[winner]++;
+    wins[winner]++;
+    losses[loser]++;
+
+    PlayedMatch match;
+    match.winner = winner;
+    match.loser = loser;
+    results.push_back(match);
+    tieBreaksCurrent = false;
+    return true;
+}
+
+void GroupStage::computeTieBreaks() {
+    if (tieBreaksCurrent) {
+        return;
+    }
+    fill(buchholz.begin(), buchholz.end(), 0);
+    fill(sonnebornBerger.begin(), sonnebornBerger.end(), 0);
+    for (size_t i = 0; i < results.size(); i++) {
+        int winner = results[i].winner;
+        int loser = results[i].loser;
+        buchholz[winner] += points[loser];
+        buchholz[loser] += points[winner];
+        sonnebornBerger[winner] += points[loser];
+    }
+    tieBreaksCurrent = true;
+}
+
+int GroupStage::getBuchholz(int entrant) {
+    computeTieBreaks();
+    return buchholz[entrant];
+}
+
+int GroupStage::getSonnebornBerger(int entrant) {
+    computeTieBreaks();
+    return sonnebornBerger[entrant];
+}
+
+void GroupStage::sortByStanding(int* first, int* last) const {
+    sort(first, last, [this](int a, int b) {
+        if (points[a] != points[b]) return points[a] > points[b];
+        if (buchholz[a] != buchholz[b]) return buchholz[a] > buchholz[b];
+        if (sonnebornBerger[a] != sonnebornBerger[b]) return sonnebornBerger[a] > sonnebornBerger[b];
+        return a < b;
+    });
+}
+
+void GroupStage::rankGroup(int g, vector<int>& ranked) {
+    computeTieBreaks();
+    ranked.assign(getGroupMembers(g), getGroupMembers(g) + getGroupSize(g));
+    if (!ranked.empty()) {
+        sortByStanding(&ranked[0], &ranked[0] + ranked.size());
+    }
+}
+
+void GroupStage::getQualifiers(int perGroup, vector<int>& qualifiers) {
+    qualifiers.clear();
+    vector<int> ranked;
+    for (int g = 0; g < groupCount; g++) {
+        rankGroup(g, ranked);
+        int take = perGroup < (int)ranked.size() ? perGroup : (int)ranked.size();
+        qualifiers.insert(qualifiers.end(), ranked.begin(), ranked.begin() + take);
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef GROUP_STAGE_HPP
+#define GROUP_STAGE_HPP
+
+#include <vector>
+using namespace std;
+
+enum GroupFormat {
+    GROUP_ROUND_ROBIN = 0,  // Every pair in a group meets exactly once
+    GROUP_SWISS = 1         // Fixed number of rounds, pairs by score
+};
+
+// One scheduled match. Teams are entrant indices; teamB is -1 for a
+// Swiss bye (already credited as a win, nothing to record).
+struct GroupFixture {
+    int group;
+    int round;
+    int teamA;
+    int teamB;
+};
+
+// Group-stage engine for any number of groups of any size.
+// Entrants are indices 0..n-1 in seeding order (names stay with the
+// caller) and are snake-seeded into the groups, so group sizes differ by
+// at most one and every group gets a fair share of the top seeds.
+//
+// Round robin uses the circle method: a group of k plays k-1 rounds
+// (k if odd, one team resting per round) and every pair meets once.
+// Swiss pairs each group by score every round, in near-linear time, and
+// avoids rematches: every entrant keeps a row of its past opponents (one
+// per round, so a few cache lines at most), and a rematch is only taken
+// when no swap with a recent pair avoids it. An odd group gives its
+// lowest-ranked team that has not had one a bye worth a win.
+//
+// Standings are flat arrays indexed by entrant. Ranking is points, then
+// Buchholz (sum of opponents' points), then Sonneborn-Berger (sum of the
+// points of beaten opponents), then seed; both tie-breaks come from one
+// pass over the results, so ranking a group is a single sort.
+//
+//   GroupStage stage(12, 3, GROUP_ROUND_ROBIN);
+//   vector<GroupFixture> fixtures;
+//   while (stage.nextRound(fixtures)) {
+//       for (...) stage.recordResult(fixtures[i], winner);
+//   }
+//   stage.getQualifiers(2, finalists);
+class GroupStage {
+private:
+    struct PlayedMatch {
+        int winner;
+        int loser;
+    };
+
+    GroupFormat format;
+    int entrantCount;
+    int groupCount;
+    int roundCount;
+    int roundsPlayed;
+    vector<int> groupStart;     // Group g is members[groupStart[g] .. groupStart[g + 1])
+    vector<int> members;        // Entrants grouped, seed order within a group
+    vector<int> groupOf;
+
+    // Standings, indexed by entrant
+    vector<int> points;
+    vector<int> wins;
+    vector<int> losses;
+    vector<int> buchholz;
+    vector<int> sonnebornBerger;
+    vector<char> hadBye;
+    bool tieBreaksCurrent;      // False once a result arrives after the last computation
+
+    vector<PlayedMatch> results;
+    vector<int> opponents;      // Swiss only: entrant * roundCount + round -> opponent (-1 = none)
+    int rematches;              // Swiss pairs that had met before (no alternative left)
+
+    void pairRoundRobin(int g, vector<GroupFixture>& fixtures) const;
+    void pairSwiss(int g, vector<GroupFixture>& fixtures);
+    int scoreLevel(int entrant) const;
+    bool hasMet(int a, int b) const;
+    bool swapIntoRecentPair(int a, int b, vector<int>& pairA, vector<int>& pairB) const;
+    void computeTieBreaks();
+    void sortByStanding(int* first, int* last) const;
+
+public:
+    // groupCount is clamped to 1..entrantCount. swissRounds is only used
+    // by GROUP_SWISS; more rounds than a group can fill allow rematches.
+    GroupStage(int entrants, int groups, GroupFormat groupFormat, int swissRounds = 0);
+
+    int getEntrantCount() const { return entrantCount; }
+    int getGroupCount() const { return groupCount; }
+    int getRoundCount() const { return roundCount; }
+    int getRoundsPlayed() const { return roundsPlayed; }
+    int getRematches() const { return rematches; }
+    int getGroupSize(int g) const { return groupStart[g + 1] - groupStart[g]; }
+    const int* getGroupMembers(int g) const { return members.data() + groupStart[g]; }
+    int getGroupOf(int entrant) const { return groupOf[entrant]; }
+
+    // Replace fixtures with the next round of every group, ordered by
+    // group. False once all rounds are scheduled. Swiss pairings use the
+    // results recorded so far, so record a round before asking for the next.
+    bool nextRound(vector<GroupFixture>& fixtures);
+    // winner must be fixture.teamA or fixture.teamB
+    bool recordResult(const GroupFixture& fixture, int winner);
+
+    int getPoints(int entrant) const { return points[entrant]; }
+    int getWins(int entrant) const { return wins[entrant]; }
+    int getLosses(int entrant) const { return losses[entrant]; }
+    int getBuchholz(int entrant);
+    int getSonnebornBerger(int entrant);
+
+    // Members of group g, best first
+    void rankGroup(int g, vector<int>& ranked);
+    // Top perGroup of every group: group 0's in rank order, then group 1's, ...
+    void getQualifiers(int perGroup, vector<int>& qualifiers);
+};
+
+#endif
@@ -12,13 +12,76 @@
  * - Task 4: Game Result Logging & Performance History [Daniel]
  *
  * Data Structures Used: Stack, Queue, Priority Queue, Circular Queue
+ *
+ * Usage: apuec_system                       interactive menus
+ *        apuec_system --batch FILE [--time] run a command script (FILE "-" = stdin),
+ *                                           --time reports per-command latency
+ *        --trace FILE                       (either mode) write a Chrome trace of the
+ *                                           hot paths on exit; needs -DAPUEC_TRACING=ON
  */
 
  #include "apuec_integrated_system.hpp"
+ #include "batch_runner.hpp"
+ #include "apuec_trace.hpp"
  #include <iostream>
+ #include <cstring>
  using namespace std;
  
- int main() {
+ // Start tracing if a trace file was requested
+ static void startTrace(const char* traceFile) {
+     if (!traceFile) return;
+     if (!Tracer::isCompiledIn()) {
+         cout << "Tracing is not compiled in (configure with -DAPUEC_TRACING=ON); "
+              << traceFile << " will be empty\n";
+     }
+     Tracer::setThreadName("main");
+     Tracer::enable(true);
+ }
+ 
+ static void finishTrace(const char* traceFile) {
+     if (!traceFile) return;
+     Tracer::enable(false);
+     if (!Tracer::writeChromeTrace(traceFile)) {
+         cout << "Unable to write trace file " << traceFile << "\n";
+     } else if (Tracer::getDroppedCount() > 0) {
+         cout << "Trace buffers overflowed; " << Tracer::getDroppedCount() << " spans dropped\n";
+     }
+ }
+ 
+ static int runBatch(const char* filename, bool timing) {
+     APUECCore core;     // Silent: batch output comes from BatchRunner only
+     BatchRunner runner(&core, timing);
+     
+     int failed = (strcmp(filename, "-") == 0) ? runner.run(cin) : runner.runFile(filename);
+     if (failed < 0) return 2;
+     return failed == 0 ? 0 : 1;
+ }
+ 
+ int main(int argc, char* argv[]) {
+     const char* batchFile = nullptr;
+     const char* traceFile = nullptr;
+     bool timing = false;
+     
+     for (int i = 1; i < argc; i++) {
+         if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+             batchFile = argv[++i];
+         } else if (strcmp(argv[i], "--time") == 0) {
+             timing = true;
+         } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+             traceFile = argv[++i];
+         } else {
+             cout << "Usage: apuec_system [--batch FILE [--time]] [--trace FILE]\n";
+             return 2;
+         }
+     }
+     
+     startTrace(traceFile);
+     if (batchFile) {
+         int status = runBatch(batchFile, timing);
+         finishTrace(traceFile);
+         return status;
+     }
+     
      try {
          // Initialize the integrated tournament management system
          APUECIntegratedSystem tournamentSystem;
@@ -29,8 +92,10 @@
      } catch (const exception& e) {
          cout << "System Error: " << e.what() << endl;
          cout << "Please restart the system and try again." << endl;
+         finishTrace(traceFile);
          return 1;
      }
      
+     finishTrace(traceFile);
      return 0;
  }
\ No newline at end of file
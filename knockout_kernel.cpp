@@ -0,0 +1,66 @@
+#include "knockout_kernel.hpp"
+#include "apuec_trace.hpp"
+#include "task_pool.hpp"
+#include <cstring>
+
+static const int PAIR_BLOCK = 256;
+
+// Pairs [first, first + pairs) of the round; their winners go to
+// base[0..pairs), where base = ids + 2 * first
+static void playPairs(int* ids, int first, int pairs, unsigned int seed) {
+    int* base = ids + 2 * first;
+    int winners[PAIR_BLOCK];
+    for (int start = 0; start < pairs; start += PAIR_BLOCK) {
+        int block = (pairs - start < PAIR_BLOCK) ? pairs - start : PAIR_BLOCK;
+        const int* pair = base + 2 * start;
+        for (int k = 0; k < block; k++) {
+            int a = pair[2 * k];
+            int b = pair[2 * k + 1];
+            int takeB = -(int)knockoutDraw(seed, (unsigned int)(first + start + k));
+            winners[k] = a ^ ((a ^ b) & takeB);
+        }
+        memcpy(base + start, winners, block * sizeof(int));
+    }
+}
+
+int KnockoutKernel::playRound(int* ids, int count, unsigned int seed) const {
+    APUEC_TRACE_SCOPE("KnockoutKernel::playRound");
+    if (count < 2) {
+        return count < 0 ? 0 : count;
+    }
+    int pairs = count / 2;
+    int chunks = (pool != nullptr && pairs > KNOCKOUT_PARALLEL_MATCHES) ? pool->getThreadCount() : 1;
+
+    if (chunks <= 1) {
+        playPairs(ids, 0, pairs, seed);
+    } else {
+        int perChunk = (pairs + chunks - 1) / chunks;
+        for (int first = 0; first < pairs; first += perChunk) {
+            int size = (pairs - first < perChunk) ? pairs - first : perChunk;
+            pool->submit([ids, first, size, seed]() { playPairs(ids, first, size, seed); });
+        }
+        pool->wait();
+        // Chunk c left its winners at ids[2 * first]; slide them down to
+        // ids[first]. The targets never reach a later chunk's winners.
+        for (int first = perChunk; first < pairs; first += perChunk) {
+            int size = (pairs - first < perChunk) ? pairs - first : perChunk;
+            memmove(ids + first, ids + 2 * first, size * sizeof(int));
+        }
+    }
+
+    if (count % 2 == 1) {
+        ids[pairs] = ids[count - 1];
+        return pairs + 1;
+    }
+    return pairs;
+}
+
+int KnockoutKernel::playOut(int* ids, int count, unsigned int seed) const {
+    if (count < 1) {
+        return -1;
+    }
+    for (unsigned int round = 0; count > 1; round++) {
+        count = playRound(ids, count, seed + round * 0x85EBCA6Bu);
+    }
+    return ids[0];
+}
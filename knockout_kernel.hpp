@@ -0,0 +1,43 @@
+#ifndef KNOCKOUT_KERNEL_HPP
+#define KNOCKOUT_KERNEL_HPP
+
+class TaskPool;
+
+// Rounds with more pairs than this are split across the pool's threads
+const int KNOCKOUT_PARALLEL_MATCHES = 4096;
+
+// Coin flip of match `match` in a round played with `seed`: the top bit of
+// a counter-based hash, so the result depends only on (seed, match) and
+// any split of the round across threads plays it identically.
+inline unsigned int knockoutDraw(unsigned int seed, unsigned int match) {
+    unsigned int x = seed ^ (match * 0x9E3779B9u);
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x >> 31;
+}
+
+// Knockout rounds over plain team ids (indexes into the caller's table).
+// ids[2i] meets ids[2i+1]; winners are compacted in place into ids[0..],
+// so a round is one branch-free pass over a contiguous int array that the
+// compiler vectorizes, with no per-team copies. The winners of a block of
+// pairs go through a small stack buffer before they are stored, which
+// keeps the reads and writes of one pass from aliasing. With a pool, large
+// rounds are split into one chunk per thread; each chunk compacts into the
+// front of its own input range and the chunks are then moved together.
+class KnockoutKernel {
+private:
+    TaskPool* pool;     // May be null: always single-threaded
+
+public:
+    explicit KnockoutKernel(TaskPool* workers = nullptr) : pool(workers) {}
+
+    // One round: returns the teams left (an odd last team moves on unplayed)
+    int playRound(int* ids, int count, unsigned int seed) const;
+    // Rounds until one team is left; returns it (-1 for no teams)
+    int playOut(int* ids, int count, unsigned int seed) const;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "live_bracket.hpp"
+#include <algorithm>
+
+LiveBracket::LiveBracket(const vector<string>& teamNames, BracketFormat format, bool bracketReset)
+    : bracket((int)teamNames.size(), format, bracketReset), names(teamNames), reported(0) {
+    entrantOf.reserve(names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        entrantOf.insert(make_pair(names[i], (int)i));
+    }
+    readyNode.assign(names.size(), -1);
+    readyIndex.assign(bracket.getNodeCount(), -1);
+    ready.reserve(bracket.getSize() / 2);
+}
+
+LiveMatch LiveBracket::describe(int node) const {
+    LiveMatch match;
+    match.id = node;
+    match.round = bracket.getRoundName(node);
+    int a = bracket.getTeam(node, 0);
+    int b = bracket.getTeam(node, 1);
+    match.teamA = a >= 0 ? names[a] : "TBD";
+    match.teamB = b >= 0 ? names[b] : "TBD";
+    return match;
+}
+
+void LiveBracket::addReady(vector<LiveMatch>& nowReady) {
+    nowReady.clear();
+    for (size_t i = 0; i < scratch.size(); i++) {
+        int node = scratch[i];
+        readyIndex[node] = (int)ready.size();
+        ready.push_back(node);
+        readyNode[bracket.getTeam(node, 0)] = node;
+        readyNode[bracket.getTeam(node, 1)] = node;
+        nowReady.push_back(describe(node));
+    }
+}
+
+// Swap-remove: the last ready node takes the freed position
+void LiveBracket::removeReady(int node) {
+    int position = readyIndex[node];
+    int last = ready.back();
+    ready[position] = last;
+    readyIndex[last] = position;
+    ready.pop_back();
+    readyIndex[node] = -1;
+}
+
+void LiveBracket::start(vector<LiveMatch>& nowReady) {
+    for (size_t i = 0; i < ready.size(); i++) {
+        readyIndex[ready[i]] = -1;
+    }
+    ready.clear();
+    readyNode.assign(names.size(), -1);
+    reported = 0;
+
+    scratch.clear();
+    bracket.start(nullptr, &scratch);
+    addReady(nowReady);
+}
+
+bool LiveBracket::report(const string& winner, const string& loser, LiveMatch& played,
+                         vector<LiveMatch>& nowReady, string& error) {
+    unordered_map<string, int>::const_iterator w = entrantOf.find(winner);
+    unordered_map<string, int>::const_iterator l = entrantOf.find(loser);
+    if (w == entrantOf.end() || l == entrantOf.end()) {
+        error = "Unknown team: " + (w == entrantOf.end() ? winner : loser);
+        return false;
+    }
+    if (w->second == l->second) {
+        error = winner + " cannot beat itself";
+        return false;
+    }
+    int node = readyNode[w->second];
+    if (node < 0 || readyNode[l->second] != node || !bracket.isReady(node)) {
+        error = winner + " and " + loser + " are not playing a ready match";
+        return false;
+    }
+
+    played = describe(node);
+    int winnerSlot = (bracket.getTeam(node, 0) == w->second) ? 0 : 1;
+    removeReady(node);
+    readyNode[w->second] = -1;
+    readyNode[l->second] = -1;
+
+    scratch.clear();
+    bracket.setWinner(node, winnerSlot, &scratch);
+    addReady(nowReady);
+    reported++;
+    return true;
+}
+
+void LiveBracket::getReadyMatches(vector<LiveMatch>& matches) const {
+    vector<int> nodes(ready);
+    sort(nodes.begin(), nodes.end());
+    matches.clear();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        matches.push_back(describe(nodes[i]));
+    }
+}
+
+int LiveBracket::findEntrant(const string& name) const {
+    unordered_map<string, int>::const_iterator it = entrantOf.find(name);
+    return it == entrantOf.end() ? -1 : it->second;
+}
+
+string LiveBracket::getChampion() const {
+    int champion = bracket.getChampion();
+    return champion >= 0 ? names[champion] : string();
+}
@@ -0,0 +1,65 @@
+#ifndef LIVE_BRACKET_HPP
+#define LIVE_BRACKET_HPP
+
+#include "bracket.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// A match whose teams are known and whose result has not been reported
+struct LiveMatch {
+    int id;                 // Bracket node, stable for the whole event
+    string round;           // "Upper Bracket Round 2", "Grand Final", ...
+    string teamA;
+    string teamB;
+};
+
+// Bracket driven by results as referees report them, instead of a
+// simulation of the whole event in one call.
+// A report "winner beat loser" is checked against the ready match the
+// two teams are in (name -> entrant -> its ready node, all O(1)), and
+// only the nodes the two teams move into are advanced: O(1) per report,
+// O(log n) at worst when a team passes through byes. The matches that
+// became playable are handed back, and the ready set is an indexed list
+// so adding and removing a match is O(1) at any bracket size.
+class LiveBracket {
+private:
+    Bracket bracket;
+    vector<string> names;
+    unordered_map<string, int> entrantOf;
+    vector<int> readyNode;      // Entrant -> ready match it plays next (-1 = none)
+    vector<int> ready;          // Ready nodes, unordered
+    vector<int> readyIndex;     // Node -> position in ready (-1 = not ready)
+    vector<int> scratch;        // Nodes made ready by the last advance
+    int reported;
+
+    void addReady(vector<LiveMatch>& nowReady);     // From scratch
+    void removeReady(int node);
+
+public:
+    // teamNames in seed order (see Bracket::start for the placement)
+    LiveBracket(const vector<string>& teamNames, BracketFormat format, bool bracketReset = true);
+
+    // Fill the first round; nowReady is replaced with the playable matches
+    void start(vector<LiveMatch>& nowReady);
+
+    // Apply "winner beat loser". played receives the match it decided and
+    // nowReady is replaced with the matches it made playable. False (with
+    // error set) if a team is unknown or the two are not in a ready match.
+    bool report(const string& winner, const string& loser, LiveMatch& played,
+                vector<LiveMatch>& nowReady, string& error);
+
+    void getReadyMatches(vector<LiveMatch>& matches) const;    // In playing order
+    LiveMatch describe(int node) const;         // Teams not known yet are "TBD"
+    int findEntrant(const string& name) const;  // -1 if not in the bracket
+    const string& getName(int entrant) const { return names[entrant]; }
+    int getEntrantCount() const { return (int)names.size(); }
+    int getReadyCount() const { return (int)ready.size(); }
+    int getReportedCount() const { return reported; }
+    bool isFinished() const { return bracket.isFinished(); }
+    string getChampion() const;                 // Empty until finished
+    const Bracket& getBracket() const { return bracket; }
+};
+
+#endif
@@ -0,0 +1,186 @@
+#include "match_day.hpp"
+#include "apuec_trace.hpp"
+#include <algorithm>
+
+MatchDayPlanner::MatchDayPlanner(const Bracket& plannedBracket, int stations, int minutesPerMatch, int minutesRest)
+    : bracket(plannedBracket), stationCount(stations < 1 ? 1 : stations),
+      matchMinutes(minutesPerMatch < 1 ? 1 : minutesPerMatch), restMinutes(minutesRest < 0 ? 0 : minutesRest),
+      projectedFinish(0), planNow(0) {
+    int nodeCount = bracket.getNodeCount();
+    feeder.assign(nodeCount * 2, -1);
+    for (int node = 0; node < nodeCount; node++) {
+        const BracketNode& info = bracket.getNode(node);
+        if (info.winnerTo >= 0) feeder[info.winnerTo] = node;
+        if (info.loserTo >= 0) feeder[info.loserTo] = node;
+    }
+    if (bracket.getResetNode() >= 0) {
+        feeder[bracket.getResetNode() * 2] = bracket.getGrandFinal();
+        feeder[bracket.getResetNode() * 2 + 1] = bracket.getGrandFinal();
+    }
+    actualStart.assign(nodeCount, -1);
+    actualEnd.assign(nodeCount, -1);
+    stationOf.assign(nodeCount, -1);
+    stationBusy.assign(stationCount, -1);
+    endAt.assign(nodeCount, -1);
+    waiting.assign(nodeCount, 0);
+    emptyAt.assign(nodeCount * 2, 0);
+}
+
+bool MatchDayPlanner::startMatch(int node, int station, int minute) {
+    if (node < 0 || node >= bracket.getNodeCount() || station < 0 || station >= stationCount || minute < 0) {
+        return false;
+    }
+    if (!bracket.isReady(node) || actualStart[node] >= 0 || stationBusy[station] >= 0) {
+        return false;
+    }
+    actualStart[node] = minute;
+    stationOf[node] = station;
+    stationBusy[station] = node;
+    return true;
+}
+
+void MatchDayPlanner::finishMatch(int node, int minute) {
+    if (node < 0 || node >= bracket.getNodeCount() || actualEnd[node] >= 0) {
+        return;
+    }
+    if (minute < 0) {
+        // No time reported: a running match is taken to have ended on schedule
+        if (!isRunning(node)) {
+            return;
+        }
+        minute = actualStart[node] + matchMinutes;
+    }
+    if (stationOf[node] >= 0 && stationBusy[stationOf[node]] == node) {
+        stationBusy[stationOf[node]] = -1;
+    }
+    actualEnd[node] = minute;
+}
+
+// Earliest minute the team in this slot may play: after its last match
+// plus the rest time, and never before now
+int MatchDayPlanner::slotReady(int node, int slot) const {
+    int source = feeder[node * 2 + slot];
+    if (source < 0 || endAt[source] < 0) {
+        return planNow;
+    }
+    int ready = endAt[source] + restMinutes;
+    return ready > planNow ? ready : planNow;
+}
+
+// Both feeding matches are timed. A match with an empty slot is a bye:
+// the other team passes through when its previous match ends, and the
+// bye's loser slot downstream stays empty too.
+void MatchDayPlanner::release(int node) {
+    waiting[node] = -1;     // Released once, even when a bye cascade reaches it first
+    if (emptyAt[node * 2] || emptyAt[node * 2 + 1]) {
+        int end = -1;
+        for (int slot = 0; slot < 2; slot++) {
+            int source = feeder[node * 2 + slot];
+            if (!emptyAt[node * 2 + slot] && source >= 0 && endAt[source] > end) {
+                end = endAt[source];
+            }
+        }
+        const BracketNode& info = bracket.getNode(node);
+        if (info.loserTo >= 0) emptyAt[info.loserTo] = 1;
+        if (info.winnerTo >= 0 && emptyAt[node * 2] && emptyAt[node * 2 + 1]) emptyAt[info.winnerTo] = 1;
+        endAt[node] = end;
+        markTimed(node);
+        return;
+    }
+    int ready = max(slotReady(node, 0), slotReady(node, 1));
+    released.push(TimedNode(ready, node));
+}
+
+void MatchDayPlanner::markTimed(int node) {
+    const BracketNode& info = bracket.getNode(node);
+    int targets[2] = { info.winnerTo, info.loserTo };
+    if (node == bracket.getGrandFinal() && bracket.getResetNode() >= 0) {
+        targets[0] = bracket.getResetNode() * 2;
+        targets[1] = bracket.getResetNode() * 2 + 1;
+    }
+    for (int i = 0; i < 2; i++) {
+        int target = targets[i];
+        if (target < 0 || bracket.getTeam(target / 2, target % 2) != SLOT_PENDING || !isUnplanned(target / 2)) {
+            continue;
+        }
+        if (--waiting[target / 2] == 0) {
+            release(target / 2);
+        }
+    }
+}
+
+void MatchDayPlanner::plan(int now) {
+    APUEC_TRACE_SCOPE("MatchDayPlanner::plan");
+    int nodeCount = bracket.getNodeCount();
+    planNow = now;
+    planned.clear();
+    while (!released.empty()) released.pop();
+    priority_queue<TimedNode, vector<TimedNode>, greater<TimedNode> > stationFree;
+    vector<int> freeAt(stationCount, now);
+
+    // Played and running matches are already timed; nodes come after
+    // their feeders, so a decided bye can take its feeder's end
+    for (int node = 0; node < nodeCount; node++) {
+        endAt[node] = -1;
+        emptyAt[node * 2] = (bracket.getTeam(node, 0) == SLOT_EMPTY);
+        emptyAt[node * 2 + 1] = (bracket.getTeam(node, 1) == SLOT_EMPTY);
+        if (bracket.isDecided(node)) {
+            if (bracket.isBye(node)) {
+                for (int slot = 0; slot < 2; slot++) {
+                    int source = feeder[node * 2 + slot];
+                    if (bracket.getTeam(node, slot) >= 0 && source >= 0) endAt[node] = endAt[source];
+                }
+            } else {
+                endAt[node] = actualEnd[node];
+            }
+        } else if (isRunning(node)) {
+            int end = max(actualStart[node] + matchMinutes, now);
+            endAt[node] = end;
+            freeAt[stationOf[node]] = max(freeAt[stationOf[node]], end);
+            PlannedMatch running = { node, stationOf[node], actualStart[node], end, true };
+            planned.push_back(running);
+        }
+    }
+
+    for (int node = 0; node < nodeCount; node++) {
+        waiting[node] = 0;
+        if (!isUnplanned(node)) continue;
+        for (int slot = 0; slot < 2; slot++) {
+            int source = feeder[node * 2 + slot];
+            if (bracket.getTeam(node, slot) == SLOT_PENDING && isUnplanned(source)) {
+                waiting[node]++;
+            }
+        }
+    }
+    for (int node = 0; node < nodeCount; node++) {
+        if (isUnplanned(node) && waiting[node] == 0) {
+            release(node);
+        }
+    }
+
+    for (int station = 0; station < stationCount; station++) {
+        stationFree.push(TimedNode(freeAt[station], station));
+    }
+    while (!released.empty()) {
+        TimedNode match = released.top();
+        released.pop();
+        TimedNode station = stationFree.top();
+        stationFree.pop();
+
+        int start = max(match.first, station.first);
+        int end = start + matchMinutes;
+        endAt[match.second] = end;
+        PlannedMatch slot = { match.second, station.second, start, end, false };
+        planned.push_back(slot);
+        stationFree.push(TimedNode(end, station.second));
+        markTimed(match.second);
+    }
+
+    projectedFinish = now;
+    for (size_t i = 0; i < planned.size(); i++) {
+        if (planned[i].end > projectedFinish) projectedFinish = planned[i].end;
+    }
+    sort(planned.begin(), planned.end(), [](const PlannedMatch& a, const PlannedMatch& b) {
+        return a.node < b.node;
+    });
+}
@@ -0,0 +1,89 @@
+#ifndef MATCH_DAY_HPP
+#define MATCH_DAY_HPP
+
+#include "bracket.hpp"
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Projected slot of one bracket match. Times are minutes from the start
+// of the match day.
+struct PlannedMatch {
+    int node;
+    int station;
+    int start;
+    int end;
+    bool started;       // Already on a station (start is the actual start)
+};
+
+// Station and time-slot planner for a bracket in progress.
+// Each unplayed match is given a station and a start time so that:
+// - both teams are known, or come from matches planned to end earlier
+//   (the bracket dependencies);
+// - a team rests at least restMinutes between its matches;
+// - a station holds one match at a time.
+// plan() is event-driven list scheduling: a min-heap of station-free
+// events and a min-heap of matches ordered by the time both teams can
+// play. A match is released once the matches feeding it are planned,
+// and the earliest released match goes to the earliest free station.
+// A slot that will stay empty makes its match a bye, passed through at
+// no cost. Planning is O(n log n) over the bracket, so re-planning after
+// every start, result or overrun is cheap; the planner keeps only the
+// actual start and end times, everything else is recomputed.
+class MatchDayPlanner {
+private:
+    const Bracket& bracket;
+    int stationCount;
+    int matchMinutes;
+    int restMinutes;
+    vector<int> feeder;         // node * 2 + slot -> node whose winner or loser fills it (-1 = entrant)
+    vector<int> actualStart;    // -1 = not started
+    vector<int> actualEnd;      // -1 = not finished
+    vector<int> stationOf;      // Station a started match is on
+    vector<int> stationBusy;    // Station -> running match (-1 = free)
+    vector<PlannedMatch> planned;
+    int projectedFinish;
+
+    // plan() working state
+    typedef pair<int, int> TimedNode;      // (minute, node or station)
+    priority_queue<TimedNode, vector<TimedNode>, greater<TimedNode> > released;
+    vector<int> endAt;          // Node -> end of the match that moves its teams on (-1 = none/unknown)
+    vector<int> waiting;        // Node -> feeding matches not yet timed (-1 = released)
+    vector<char> emptyAt;       // node * 2 + slot -> no team will arrive, now or predicted
+    int planNow;
+
+    bool isUnplanned(int node) const { return !bracket.isDecided(node) && !isRunning(node); }
+    int slotReady(int node, int slot) const;
+    void release(int node);
+    void markTimed(int node);
+
+    MatchDayPlanner(const MatchDayPlanner&);
+    MatchDayPlanner& operator=(const MatchDayPlanner&);
+
+public:
+    MatchDayPlanner(const Bracket& plannedBracket, int stations, int minutesPerMatch, int minutesRest);
+
+    int getStationCount() const { return stationCount; }
+    int getMatchMinutes() const { return matchMinutes; }
+    int getRestMinutes() const { return restMinutes; }
+
+    // Actual progress. A match can start once it is ready in the bracket
+    // and the station is not running another match.
+    bool startMatch(int node, int station, int minute);
+    void finishMatch(int node, int minute);     // Called when its result is reported (-1 = time unknown)
+    bool isRunning(int node) const { return actualStart[node] >= 0 && actualEnd[node] < 0; }
+
+    // Project every unfinished match from minute now. A running match is
+    // expected to take matchMinutes; one that has already overrun is
+    // expected to end now, and everything behind it moves accordingly.
+    void plan(int now);
+
+    // Results of the last plan(), in bracket order, for unfinished
+    // matches only (byes are left out). A pending bracket reset is planned as if it is needed.
+    const vector<PlannedMatch>& getPlan() const { return planned; }
+    int getProjectedFinish() const { return projectedFinish; }
+};
+
+#endif
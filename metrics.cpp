@@ -0,0 +1,297 @@
+#include "metrics.hpp"
+#include <chrono>
+#include <iomanip>
+
+static const char* const OP_NAMES[OP_COUNT] = {
+    "register_team", "withdraw_team", "register_player", "check_in", "withdraw_player",
+    "register_spectator", "remove_spectator", "change_ticket", "allocate_seating",
+    "run_tournament", "run_qualifier", "report_result", "plan_match_day", "what_if", "export",
+    "save_snapshot", "load_snapshot"
+};
+static const char* const REGISTRATION_NAMES[REG_COUNT] = { "teams", "players", "spectators" };
+
+// ===== LatencyHistogram =====
+
+LatencyHistogram::LatencyHistogram() : count(0), totalNanos(0), maxNanos(0) {
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        buckets[i] = 0;
+    }
+}
+
+int LatencyHistogram::bucketOf(long long nanos) {
+    if (nanos < 16) {
+        return nanos < 0 ? 0 : (int)nanos;
+    }
+    int octave = 63 - __builtin_clzll((unsigned long long)nanos);
+    int step = (int)(nanos >> (octave - 3)) - 8;
+    int bucket = 16 + (octave - 4) * 8 + step;
+    return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+long long LatencyHistogram::bucketMidpoint(int bucket) {
+    if (bucket < 16) {
+        return bucket;
+    }
+    int octave = (bucket - 16) / 8 + 4;
+    int step = (bucket - 16) % 8;
+    long long width = 1LL << (octave - 3);
+    return (8 + step) * width + width / 2;
+}
+
+void LatencyHistogram::record(long long nanos) {
+    buckets[bucketOf(nanos)]++;
+    count++;
+    totalNanos += nanos;
+    if (nanos > maxNanos) {
+        maxNanos = nanos;
+    }
+}
+
+long long LatencyHistogram::percentileNanos(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    long long rank = (long long)(fraction * count + 0.5);
+    if (rank < 1) rank = 1;
+
+    long long seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            long long value = bucketMidpoint(i);
+            return value < maxNanos ? value : maxNanos;
+        }
+    }
+    return maxNanos;
+}
+
+// ===== RateCounter =====
+
+RateCounter::RateCounter() : total(0), firstSecond(-1) {
+    for (int i = 0; i < RATE_WINDOW_SECONDS; i++) {
+        slots[i] = 0;
+        slotSecond[i] = -1;
+    }
+}
+
+void RateCounter::record(long long second) {
+    int slot = (int)(second % RATE_WINDOW_SECONDS);
+    if (slotSecond[slot] != second) {
+        slotSecond[slot] = second;
+        slots[slot] = 0;
+    }
+    slots[slot]++;
+    total++;
+    if (firstSecond < 0) {
+        firstSecond = second;
+    }
+}
+
+double RateCounter::overallRate(long long nowSecond) const {
+    if (firstSecond < 0) {
+        return 0.0;
+    }
+    return (double)total / (nowSecond - firstSecond + 1);
+}
+
+double RateCounter::recentRate(long long nowSecond) const {
+    if (firstSecond < 0) {
+        return 0.0;
+    }
+    long long events = 0;
+    for (int i = 0; i < RATE_WINDOW_SECONDS; i++) {
+        if (slotSecond[i] > nowSecond - RATE_WINDOW_SECONDS && slotSecond[i] <= nowSecond) {
+            events += slots[i];
+        }
+    }
+    long long span = nowSecond - firstSecond + 1;
+    return (double)events / (span < RATE_WINDOW_SECONDS ? span : RATE_WINDOW_SECONDS);
+}
+
+// ===== SystemMetrics =====
+
+static void writeSample(ostream& os, const UtilizationSample& sample) {
+    double percent = sample.totalSeats > 0 ? 100.0 * sample.occupied / sample.totalSeats : 0.0;
+    os << "- t=" << setw(8) << sample.seconds << " s  " << setw(5) << percent << "%  ("
+       << sample.occupied << "/" << sample.totalSeats << " seated, " << sample.waiting << " waiting)\n";
+}
+
+SystemMetrics::SystemMetrics()
+    : startNanos(nowNanos()), waiting(0), maxWaiting(0), heapDepth(0), maxHeapDepth(0),
+      sampleCount(0), sampleNext(0), matchLogRows(0), matchLogBytes(0), matchLogNanos(0) {
+    for (int i = 0; i < OP_COUNT; i++) {
+        failures[i] = 0;
+    }
+}
+
+long long SystemMetrics::nowNanos() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* SystemMetrics::opName(MetricOp op) {
+    return OP_NAMES[op];
+}
+
+double SystemMetrics::uptimeSeconds() const {
+    return (nowNanos() - startNanos) / 1e9;
+}
+
+void SystemMetrics::recordOperation(MetricOp op, long long nanos, bool ok) {
+    latency[op].record(nanos);
+    if (!ok) {
+        failures[op]++;
+    }
+}
+
+void SystemMetrics::recordRegistration(RegistrationKind kind) {
+    registrations[kind].record((nowNanos() - startNanos) / 1000000000LL);
+}
+
+void SystemMetrics::recordSpectators(int waitingCount, int occupied, int totalSeats) {
+    waiting = waitingCount;
+    if (waiting > maxWaiting) {
+        maxWaiting = waiting;
+    }
+    // A heap of n nodes has floor(log2 n) + 1 levels
+    heapDepth = (waiting > 0) ? 32 - __builtin_clz((unsigned int)waiting) : 0;
+    if (heapDepth > maxHeapDepth) {
+        maxHeapDepth = heapDepth;
+    }
+
+    if (sampleCount > 0) {
+        const UtilizationSample& last = sampleAt(sampleCount - 1);
+        if (last.occupied == occupied && last.totalSeats == totalSeats) {
+            return;
+        }
+    }
+    UtilizationSample& sample = samples[sampleNext];
+    sample.seconds = uptimeSeconds();
+    sample.occupied = occupied;
+    sample.totalSeats = totalSeats;
+    sample.waiting = waiting;
+    sampleNext = (sampleNext + 1) % UTILIZATION_SAMPLES;
+    if (sampleCount < UTILIZATION_SAMPLES) {
+        sampleCount++;
+    }
+}
+
+void SystemMetrics::recordMatchLog(long long rows, long long bytes, long long nanos) {
+    matchLogRows += rows;
+    matchLogBytes += bytes;
+    matchLogNanos += nanos;
+}
+
+const UtilizationSample& SystemMetrics::sampleAt(int index) const {
+    int oldest = (sampleCount < UTILIZATION_SAMPLES) ? 0 : sampleNext;
+    return samples[(oldest + index) % UTILIZATION_SAMPLES];
+}
+
+void SystemMetrics::writeReport(ostream& os) const {
+    long long nowSecond = (nowNanos() - startNanos) / 1000000000LL;
+    os << fixed << setprecision(1);
+    os << "Uptime: " << uptimeSeconds() << " s\n";
+
+    os << "\nOperation latency (microseconds):\n";
+    os << left << setw(20) << "Operation" << right << setw(9) << "Count" << setw(8) << "Failed"
+       << setw(10) << "Mean" << setw(10) << "p50" << setw(10) << "p99" << setw(12) << "Max" << "\n";
+    bool any = false;
+    for (int i = 0; i < OP_COUNT; i++) {
+        const LatencyHistogram& histogram = latency[i];
+        if (histogram.getCount() == 0) continue;
+        any = true;
+        os << left << setw(20) << OP_NAMES[i] << right << setw(9) << histogram.getCount()
+           << setw(8) << failures[i]
+           << setw(10) << histogram.getMeanNanos() / 1000.0
+           << setw(10) << histogram.percentileNanos(0.50) / 1000.0
+           << setw(10) << histogram.percentileNanos(0.99) / 1000.0
+           << setw(12) << histogram.getMaxNanos() / 1000.0 << "\n";
+    }
+    if (!any) {
+        os << "(no operations yet)\n";
+    }
+
+    os << "\nRegistrations:\n";
+    for (int i = 0; i < REG_COUNT; i++) {
+        os << "- " << REGISTRATION_NAMES[i] << ": " << registrations[i].getTotal()
+           << " total, " << registrations[i].recentRate(nowSecond) << "/s over the last "
+           << RATE_WINDOW_SECONDS << " s, " << registrations[i].overallRate(nowSecond) << "/s overall\n";
+    }
+
+    os << "\nSpectator queue:\n";
+    os << "- Waiting: " << waiting << " (peak " << maxWaiting << ")\n";
+    os << "- Heap depth: " << heapDepth << " levels (peak " << maxHeapDepth << ")\n";
+
+    os << "\nSeat utilization over time:\n";
+    if (sampleCount == 0) {
+        os << "(no samples yet)\n";
+    }
+    // About ten evenly spaced rows, always ending with the latest sample
+    int step = (sampleCount + 9) / 10;
+    for (int i = 0; i < sampleCount; i += step) {
+        writeSample(os, sampleAt(i));
+    }
+    if (sampleCount > 0 && (sampleCount - 1) % step != 0) {
+        writeSample(os, sampleAt(sampleCount - 1));
+    }
+
+    os << "\nMatch log (result.csv):\n";
+    if (matchLogRows == 0) {
+        os << "(no matches logged yet)\n";
+    } else {
+        double seconds = matchLogNanos / 1e9;
+        os << "- " << matchLogRows << " rows, " << matchLogBytes << " bytes in "
+           << setprecision(3) << seconds * 1000.0 << " ms of writes (" << setprecision(0)
+           << (seconds > 0 ? matchLogRows / seconds : 0.0) << " rows/s, "
+           << (seconds > 0 ? matchLogBytes / seconds / 1e6 : 0.0) << " MB/s)\n";
+    }
+    os << defaultfloat << setprecision(6);
+}
+
+void SystemMetrics::writeJson(ostream& os) const {
+    long long nowSecond = (nowNanos() - startNanos) / 1000000000LL;
+    os << fixed << setprecision(3);
+    os << "{\"uptime_seconds\":" << uptimeSeconds();
+
+    os << ",\"operations\":{";
+    bool first = true;
+    for (int i = 0; i < OP_COUNT; i++) {
+        const LatencyHistogram& histogram = latency[i];
+        if (histogram.getCount() == 0) continue;
+        os << (first ? "" : ",") << "\"" << OP_NAMES[i] << "\":{\"count\":" << histogram.getCount()
+           << ",\"failures\":" << failures[i]
+           << ",\"mean_us\":" << histogram.getMeanNanos() / 1000.0
+           << ",\"p50_us\":" << histogram.percentileNanos(0.50) / 1000.0
+           << ",\"p90_us\":" << histogram.percentileNanos(0.90) / 1000.0
+           << ",\"p99_us\":" << histogram.percentileNanos(0.99) / 1000.0
+           << ",\"max_us\":" << histogram.getMaxNanos() / 1000.0 << "}";
+        first = false;
+    }
+    os << "}";
+
+    os << ",\"registrations\":{";
+    for (int i = 0; i < REG_COUNT; i++) {
+        os << (i ? "," : "") << "\"" << REGISTRATION_NAMES[i] << "\":{\"total\":" << registrations[i].getTotal()
+           << ",\"per_second_recent\":" << registrations[i].recentRate(nowSecond)
+           << ",\"per_second_overall\":" << registrations[i].overallRate(nowSecond) << "}";
+    }
+    os << "}";
+
+    os << ",\"spectator_queue\":{\"waiting\":" << waiting << ",\"peak_waiting\":" << maxWaiting
+       << ",\"heap_depth\":" << heapDepth << ",\"peak_heap_depth\":" << maxHeapDepth << "}";
+
+    os << ",\"seat_utilization\":[";
+    for (int i = 0; i < sampleCount; i++) {
+        const UtilizationSample& sample = sampleAt(i);
+        os << (i ? "," : "") << "{\"t\":" << sample.seconds << ",\"occupied\":" << sample.occupied
+           << ",\"seats\":" << sample.totalSeats << ",\"waiting\":" << sample.waiting << "}";
+    }
+    os << "]";
+
+    double seconds = matchLogNanos / 1e9;
+    os << ",\"match_log\":{\"rows\":" << matchLogRows << ",\"bytes\":" << matchLogBytes
+       << ",\"write_seconds\":" << setprecision(6) << seconds << setprecision(1)
+       << ",\"rows_per_second\":" << (seconds > 0 ? matchLogRows / seconds : 0.0)
+       << ",\"bytes_per_second\":" << (seconds > 0 ? matchLogBytes / seconds : 0.0) << "}";
+    os << "}\n";
+    os << defaultfloat << setprecision(6);
+}
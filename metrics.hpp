@@ -0,0 +1,139 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// Buckets: values below 16 ns exactly, then 8 linear steps per power of
+// two (at most 1/8 relative error) up to 2^40 ns (about 18 minutes)
+const int HISTOGRAM_BUCKETS = 16 + 8 * 37;
+const int RATE_WINDOW_SECONDS = 60;
+const int UTILIZATION_SAMPLES = 128;
+
+// Operations timed by APUECCore
+enum MetricOp {
+    OP_REGISTER_TEAM,
+    OP_WITHDRAW_TEAM,
+    OP_REGISTER_PLAYER,
+    OP_CHECK_IN,
+    OP_WITHDRAW_PLAYER,
+    OP_REGISTER_SPECTATOR,
+    OP_REMOVE_SPECTATOR,
+    OP_CHANGE_TICKET,
+    OP_ALLOCATE_SEATING,
+    OP_RUN_TOURNAMENT,
+    OP_RUN_QUALIFIER,
+    OP_REPORT_RESULT,
+    OP_PLAN_MATCH_DAY,
+    OP_WHAT_IF,
+    OP_EXPORT,
+    OP_SAVE_SNAPSHOT,
+    OP_LOAD_SNAPSHOT,
+    OP_COUNT
+};
+
+// Registration streams with their own rate counter
+enum RegistrationKind {
+    REG_TEAM,
+    REG_PLAYER,
+    REG_SPECTATOR,
+    REG_COUNT
+};
+
+// Latency distribution of one operation
+class LatencyHistogram {
+private:
+    long long buckets[HISTOGRAM_BUCKETS];
+    long long count;
+    long long totalNanos;
+    long long maxNanos;
+
+    static int bucketOf(long long nanos);
+    static long long bucketMidpoint(int bucket);
+
+public:
+    LatencyHistogram();
+
+    void record(long long nanos);
+    long long getCount() const { return count; }
+    long long getMaxNanos() const { return maxNanos; }
+    double getMeanNanos() const { return count > 0 ? (double)totalNanos / count : 0.0; }
+    long long percentileNanos(double fraction) const;  // 0.5 = median; 0 if empty
+};
+
+// Events per second over the whole run and over the last
+// RATE_WINDOW_SECONDS (one slot per second, reused as time moves on)
+class RateCounter {
+private:
+    long long total;
+    long long firstSecond;          // -1 until the first event
+    long long slots[RATE_WINDOW_SECONDS];
+    long long slotSecond[RATE_WINDOW_SECONDS];
+
+public:
+    RateCounter();
+
+    void record(long long second);
+    long long getTotal() const { return total; }
+    double overallRate(long long nowSecond) const;
+    double recentRate(long long nowSecond) const;
+};
+
+// Seat and queue occupancy at one moment
+struct UtilizationSample {
+    double seconds;                 // Since the metrics were created
+    int occupied;
+    int totalSeats;
+    int waiting;
+};
+
+// Measurements taken by APUECCore while it runs. Recording is a few
+// integer updates, so every core operation is timed; the report and the
+// JSON dump are produced from these values only.
+class SystemMetrics {
+private:
+    long long startNanos;
+    LatencyHistogram latency[OP_COUNT];
+    long long failures[OP_COUNT];
+    RateCounter registrations[REG_COUNT];
+
+    int waiting;
+    int maxWaiting;
+    int heapDepth;                  // Levels of the waiting-queue heap
+    int maxHeapDepth;
+
+    UtilizationSample samples[UTILIZATION_SAMPLES];    // Ring, oldest at sampleNext once full
+    int sampleCount;
+    int sampleNext;
+
+    long long matchLogRows;
+    long long matchLogBytes;
+    long long matchLogNanos;
+
+    const UtilizationSample& sampleAt(int index) const;     // 0 = oldest kept
+
+public:
+    SystemMetrics();
+
+    static long long nowNanos();    // Monotonic clock
+    static const char* opName(MetricOp op);
+    double uptimeSeconds() const;
+
+    void recordOperation(MetricOp op, long long nanos, bool ok);
+    void recordRegistration(RegistrationKind kind);
+    // Queue length and seats after a spectator operation; a utilization
+    // sample is kept whenever the number of occupied seats changes
+    void recordSpectators(int waitingCount, int occupied, int totalSeats);
+    void recordMatchLog(long long rows, long long bytes, long long nanos);
+
+    const LatencyHistogram& getLatency(MetricOp op) const { return latency[op]; }
+    long long getFailures(MetricOp op) const { return failures[op]; }
+    int getHeapDepth() const { return heapDepth; }
+
+    void writeReport(ostream& os) const;    // Human-readable tables
+    void writeJson(ostream& os) const;      // One JSON object
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "seat_map.hpp"
+#include <cstdlib>
+
+// ===== SEAT MAP IMPLEMENTATION =====
+
+SeatMap::SeatMap(int vip, int influencer, int general, int rowWidth) {
+    if (rowWidth < 1) rowWidth = 1;
+    if (rowWidth > MAX_SEATS_PER_ROW) rowWidth = MAX_SEATS_PER_ROW;
+    seatsPerRow = rowWidth;
+
+    int capacities[TIER_COUNT] = { vip, influencer, general };
+    totalRows = 0;
+    for (int t = 0; t < TIER_COUNT; t++) {
+        if (capacities[t] < 0) capacities[t] = 0;
+        sections[t].firstRow = totalRows;
+        sections[t].rowCount = (capacities[t] + seatsPerRow - 1) / seatsPerRow;
+        sections[t].capacity = capacities[t];
+        sections[t].freeSeats = capacities[t];
+        sections[t].freeRowHead = -1;
+        totalRows += sections[t].rowCount;
+    }
+
+    rowFree = new unsigned long long[totalRows > 0 ? totalRows : 1];
+    rowMask = new unsigned long long[totalRows > 0 ? totalRows : 1];
+    rowTier = new int[totalRows > 0 ? totalRows : 1];
+    rowNext = new int[totalRows > 0 ? totalRows : 1];
+    rowPrev = new int[totalRows > 0 ? totalRows : 1];
+
+    for (int t = 0; t < TIER_COUNT; t++) {
+        int remaining = sections[t].capacity;
+        for (int i = 0; i < sections[t].rowCount; i++) {
+            int row = sections[t].firstRow + i;
+            int width = remaining < seatsPerRow ? remaining : seatsPerRow;
+            remaining -= width;
+
+            rowMask[row] = (width == 64) ? ~0ULL : ((1ULL << width) - 1);
+            rowFree[row] = rowMask[row];
+            rowTier[row] = t;
+            rowNext[row] = -1;
+            rowPrev[row] = -1;
+        }
+        // Link rows back to front so the list starts at the front row
+        for (int i = sections[t].rowCount - 1; i >= 0; i--) {
+            linkRow(sections[t].firstRow + i);
+        }
+    }
+}
+
+SeatMap::~SeatMap() {
+    delete[] rowFree;
+    delete[] rowMask;
+    delete[] rowTier;
+    delete[] rowNext;
+    delete[] rowPrev;
+}
+
+void SeatMap::linkRow(int row) {
+    Section& s = sections[rowTier[row]];
+    rowPrev[row] = -1;
+    rowNext[row] = s.freeRowHead;
+    if (s.freeRowHead != -1) {
+        rowPrev[s.freeRowHead] = row;
+    }
+    s.freeRowHead = row;
+}
+
+void SeatMap::unlinkRow(int row) {
+    Section& s = sections[rowTier[row]];
+    if (rowPrev[row] != -1) {
+        rowNext[rowPrev[row]] = rowNext[row];
+    } else {
+        s.freeRowHead = rowNext[row];
+    }
+    if (rowNext[row] != -1) {
+        rowPrev[rowNext[row]] = rowPrev[row];
+    }
+    rowNext[row] = -1;
+    rowPrev[row] = -1;
+}
+
+void SeatMap::takeSeats(int row, unsigned long long bits) {
+    rowFree[row] &= ~bits;
+    sections[rowTier[row]].freeSeats -= __builtin_popcountll(bits);
+    if (rowFree[row] == 0) {
+        unlinkRow(row);
+    }
+}
+
+int SeatMap::allocateSeat(int tier) {
+    if (tier < 0 || tier >= TIER_COUNT) return -1;
+
+    int row = sections[tier].freeRowHead;
+    if (row == -1) return -1;
+
+    int seat = __builtin_ctzll(rowFree[row]);
+    takeSeats(row, 1ULL << seat);
+    return row * seatsPerRow + seat;
+}
+
+bool SeatMap::allocateAdjacent(int tier, int count, int seatIds[]) {
+    if (tier < 0 || tier >= TIER_COUNT) return false;
+    if (count < 1 || count > seatsPerRow) return false;
+    if (sections[tier].freeSeats < count) return false;
+
+    for (int row = sections[tier].freeRowHead; row != -1; row = rowNext[row]) {
+        unsigned long long free = rowFree[row];
+        if (__builtin_popcountll(free) < count) continue;
+
+        // Bit s of runs survives only if seats s..s+count-1 are all free.
+        // Shift by doubling widths so a run of count costs O(log count).
+        unsigned long long runs = free;
+        int covered = 1;
+        while (covered < count && runs != 0) {
+            int step = (covered * 2 <= count) ? covered : count - covered;
+            runs &= runs >> step;
+            covered += step;
+        }
+        if (runs == 0) continue;
+
+        int start = __builtin_ctzll(runs);
+        unsigned long long block = (count == 64) ? ~0ULL : (((1ULL << count) - 1) << start);
+        takeSeats(row, block);
+        for (int i = 0; i < count; i++) {
+            seatIds[i] = row * seatsPerRow + start + i;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool SeatMap::reserveSeat(int seatId) {
+    if (!isFree(seatId)) return false;
+    int row = seatId / seatsPerRow;
+    takeSeats(row, 1ULL << (seatId % seatsPerRow));
+    return true;
+}
+
+void SeatMap::releaseSeat(int seatId) {
+    if (!isValidSeat(seatId) || isFree(seatId)) return;
+
+    int row = seatId / seatsPerRow;
+    bool wasFull = (rowFree[row] == 0);
+    rowFree[row] |= 1ULL << (seatId % seatsPerRow);
+    sections[rowTier[row]].freeSeats++;
+    if (wasFull) {
+        linkRow(row);
+    }
+}
+
+bool SeatMap::isValidSeat(int seatId) const {
+    if (seatId < 0 || seatId >= getSeatIdLimit()) return false;
+    return (rowMask[seatId / seatsPerRow] >> (seatId % seatsPerRow)) & 1ULL;
+}
+
+bool SeatMap::isFree(int seatId) const {
+    if (!isValidSeat(seatId)) return false;
+    return (rowFree[seatId / seatsPerRow] >> (seatId % seatsPerRow)) & 1ULL;
+}
+
+int SeatMap::getTier(int seatId) const {
+    if (!isValidSeat(seatId)) return -1;
+    return rowTier[seatId / seatsPerRow];
+}
+
+string SeatMap::getSeatLabel(int seatId) const {
+    if (!isValidSeat(seatId)) return "ERROR";
+
+    int row = seatId / seatsPerRow;
+    int tier = rowTier[row];
+    return string(getTierCode(tier)) + "-R" + to_string(row - sections[tier].firstRow + 1) +
+           "-S" + to_string(seatId % seatsPerRow + 1);
+}
+
+int SeatMap::findSeatByLabel(const string& label) const {
+    size_t dash = label.find('-');
+    if (dash == string::npos) return -1;
+
+    string code = label.substr(0, dash);
+    int tier = -1;
+    for (int t = 0; t < TIER_COUNT; t++) {
+        if (code == getTierCode(t)) tier = t;
+    }
+    if (tier == -1) return -1;
+
+    const Section& s = sections[tier];
+    string rest = label.substr(dash + 1);
+    int seatId = -1;
+
+    if (!rest.empty() && rest[0] == 'R') {
+        // "VIP-R2-S5" form
+        size_t seatPos = rest.find("-S");
+        if (seatPos == string::npos) return -1;
+        int row = atoi(rest.substr(1, seatPos - 1).c_str()) - 1;
+        int seat = atoi(rest.substr(seatPos + 2).c_str()) - 1;
+        if (row < 0 || row >= s.rowCount || seat < 0 || seat >= seatsPerRow) return -1;
+        seatId = (s.firstRow + row) * seatsPerRow + seat;
+    } else {
+        // Legacy "VIP-3" form: n-th seat of the section
+        int ordinal = atoi(rest.c_str()) - 1;
+        if (ordinal < 0 || ordinal >= s.capacity) return -1;
+        seatId = s.firstRow * seatsPerRow + ordinal;
+    }
+
+    return isValidSeat(seatId) ? seatId : -1;
+}
+
+const char* SeatMap::getTierCode(int tier) {
+    switch (tier) {
+        case TIER_VIP: return "VIP";
+        case TIER_INFLUENCER: return "INF";
+        default: return "GEN";
+    }
+}
+
+int SeatMap::tierFromType(const string& spectatorType) {
+    if (spectatorType == "VIP") return TIER_VIP;
+    if (spectatorType == "Influencer") return TIER_INFLUENCER;
+    return TIER_GENERAL;
+}
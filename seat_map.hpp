@@ -0,0 +1,79 @@
+#ifndef SEAT_MAP_HPP
+#define SEAT_MAP_HPP
+
+#include <string>
+using namespace std;
+
+// Seat tiers (one venue section per tier)
+enum SeatTier {
+    TIER_VIP = 0,
+    TIER_INFLUENCER = 1,
+    TIER_GENERAL = 2,
+    TIER_COUNT = 3
+};
+
+const int MAX_SEATS_PER_ROW = 64;   // One 64-bit free mask per row
+
+// Venue seat map: sections -> rows -> seats.
+// Every row keeps a bitmap of its free seats, and every section keeps a
+// linked list of rows that still have a free seat, so single seat
+// allocation and release are O(1) and adjacent-seat searches only look at
+// rows that can actually hold the group.
+// Seat ids are row * seatsPerRow + seat; the tail row of a section may be
+// shorter, which leaves a few unused ids (see getSeatIdLimit()).
+class SeatMap {
+private:
+    struct Section {
+        int firstRow;       // Index of the section's first row
+        int rowCount;       // Number of rows in the section
+        int capacity;       // Number of seats in the section
+        int freeSeats;      // Currently free seats
+        int freeRowHead;    // First row with a free seat (-1 if full)
+    };
+
+    Section sections[TIER_COUNT];
+    int seatsPerRow;                // Seats in a full row
+    int totalRows;
+    unsigned long long* rowFree;    // Bit s set = seat s of the row is free
+    unsigned long long* rowMask;    // Bits of seats that exist in the row
+    int* rowTier;                   // Section each row belongs to
+    int* rowNext;                   // Free-row list links (-1 = none)
+    int* rowPrev;
+
+    void linkRow(int row);          // Add row to its section's free-row list
+    void unlinkRow(int row);        // Remove row from its section's free-row list
+    void takeSeats(int row, unsigned long long bits);
+
+    // Disable copying (owns raw arrays)
+    SeatMap(const SeatMap&);
+    SeatMap& operator=(const SeatMap&);
+
+public:
+    // Constructor and Destructor
+    SeatMap(int vip, int influencer, int general, int rowWidth = 10);
+    ~SeatMap();
+
+    // Seat allocation
+    int allocateSeat(int tier);                                // Any free seat, -1 if full
+    bool allocateAdjacent(int tier, int count, int seatIds[]); // Block of adjacent seats in one row
+    bool reserveSeat(int seatId);                              // Take a specific seat if free
+    void releaseSeat(int seatId);                              // Return a seat to the pool
+
+    // Queries
+    bool isValidSeat(int seatId) const;
+    bool isFree(int seatId) const;
+    int getTier(int seatId) const;
+    int getFreeSeats(int tier) const { return sections[tier].freeSeats; }
+    int getCapacity(int tier) const { return sections[tier].capacity; }
+    int getSeatsPerRow() const { return seatsPerRow; }
+    int getSeatIdLimit() const { return totalRows * seatsPerRow; }
+
+    // Seat labels, e.g. "VIP-R2-S5"
+    string getSeatLabel(int seatId) const;
+    int findSeatByLabel(const string& label) const;   // -1 if unknown
+
+    static const char* getTierCode(int tier);         // "VIP", "INF", "GEN"
+    static int tierFromType(const string& spectatorType);
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "seeding.hpp"
+#include "bracket.hpp"
+
+static constexpr SeedingTable<2> TABLE_2;
+static constexpr SeedingTable<4> TABLE_4;
+static constexpr SeedingTable<8> TABLE_8;
+static constexpr SeedingTable<16> TABLE_16;
+static constexpr SeedingTable<32> TABLE_32;
+static constexpr SeedingTable<64> TABLE_64;
+static constexpr SeedingTable<128> TABLE_128;
+static constexpr SeedingTable<256> TABLE_256;
+
+static_assert(TABLE_8.order[0] == 0 && TABLE_8.order[1] == 7 && TABLE_8.order[2] == 3 && TABLE_8.order[3] == 4 &&
+              TABLE_8.order[4] == 1 && TABLE_8.order[5] == 6 && TABLE_8.order[6] == 2 && TABLE_8.order[7] == 5,
+              "standard 8-team seeding");
+static_assert(TABLE_256.order[1] == 255 && TABLE_256.order[128] == 1, "seeds 0 and 1 meet only in the final");
+
+// Tables by log2(size)
+static const int* const TABLES[] = { nullptr, TABLE_2.order, TABLE_4.order, TABLE_8.order, TABLE_16.order,
+                                     TABLE_32.order, TABLE_64.order, TABLE_128.order, TABLE_256.order };
+
+BracketSeeding::BracketSeeding(int entrants) : entrantCount(entrants < 0 ? 0 : entrants), table(nullptr) {
+    size = 2;
+    int log = 1;
+    while (size < entrantCount) {
+        size *= 2;
+        log++;
+    }
+    if (size <= SEEDING_TABLE_MAX) {
+        table = TABLES[log];
+    } else {
+        built.resize(size);
+        expandSeeding(built.data(), size);
+    }
+}
+
+void BracketSeeding::place(int* placement, const int* bySeed) const {
+    const int* order = table != nullptr ? table : built.data();
+    for (int p = 0; p < size; p++) {
+        int seed = order[p];
+        if (seed >= entrantCount) {
+            placement[p] = SLOT_EMPTY;
+        } else {
+            placement[p] = bySeed != nullptr ? bySeed[seed] : seed;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef SEEDING_HPP
+#define SEEDING_HPP
+
+#include <vector>
+using namespace std;
+
+// Largest bracket size with a compile-time table
+const int SEEDING_TABLE_MAX = 256;
+
+// Standard seeding of a size-entry bracket (size a power of two), built
+// by doubling: position p of the half-size order splits into positions
+// 2p and 2p + 1, holding seed s and its mirror 2n - 1 - s. For 8:
+// 0 7 3 4 1 6 2 5, so seeds 0 and 1 can only meet in the final, the top
+// four only from the semifinals on, and so on. Usable at compile time.
+constexpr void expandSeeding(int* order, int size) {
+    order[0] = 0;
+    for (int n = 1; n < size; n *= 2) {
+        for (int p = n - 1; p >= 0; p--) {      // From the back: writes land at or after p
+            int seed = order[p];
+            order[2 * p] = seed;
+            order[2 * p + 1] = 2 * n - 1 - seed;
+        }
+    }
+}
+
+template <int N>
+struct SeedingTable {
+    int order[N];
+    constexpr SeedingTable() : order() { expandSeeding(order, N); }
+};
+
+// Position -> seed for a padded bracket of entrants. Power-of-two sizes up
+// to SEEDING_TABLE_MAX use the compile-time tables and never allocate;
+// larger brackets build their order once here. Seeds at or past the
+// entrant count are byes, and they fall opposite the top seeds.
+// place() is one pass with a table lookup per position, cheap enough to
+// reseed a bracket on every Monte Carlo iteration.
+class BracketSeeding {
+private:
+    int entrantCount;
+    int size;               // Power of two >= entrantCount, at least 2
+    const int* table;       // Compile-time table, null when built is used
+    vector<int> built;
+
+public:
+    explicit BracketSeeding(int entrants);
+
+    int getEntrantCount() const { return entrantCount; }
+    int getSize() const { return size; }
+    int getSeedAt(int position) const { return table != nullptr ? table[position] : built[position]; }
+
+    // Fill placement (getSize() entries, for Bracket::start) with the
+    // entrant at every position: bySeed[seed], or the seed itself when
+    // bySeed is null; positions of missing seeds get SLOT_EMPTY.
+    void place(int* placement, const int* bySeed = nullptr) const;
+};
+
+#endif
@@ -0,0 +1,357 @@
+/**
+ * APUEC Server Load Client
+ *
+ * Opens N connections to apuec_server, keeps a fixed number of requests
+ * in flight on each (pipelining) and reports throughput and round-trip
+ * latency percentiles. Requests are drawn from a weighted mix of
+ * operations; "ERR" responses are counted but are not failures (e.g.
+ * check-ins of players that were never registered).
+ *
+ * Usage: apuec_loadclient [options]
+ *   --socket PATH     Unix domain socket (default /tmp/apuec.sock)
+ *   --port N          connect to 127.0.0.1:N instead
+ *   --connections N   concurrent connections (default 8)
+ *   --depth N         requests in flight per connection (default 16)
+ *   --duration S      seconds to run (default 5)
+ *   --mix LIST        op:weight,... from spectator, checkin, allocate,
+ *                     stats, ping (default spectator:80,stats:15,allocate:5)
+ *   --seed N          random seed (default 42)
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+enum LoadOperation { OP_SPECTATOR, OP_CHECKIN, OP_ALLOCATE, OP_STATS, OP_PING, OP_COUNT };
+
+static const char* OPERATION_NAMES[OP_COUNT] = { "spectator", "checkin", "allocate", "stats", "ping" };
+static const char* SPECTATOR_TYPES[3] = { "VIP", "Influencer", "General" };
+
+struct ClientConfig {
+    string socketPath;
+    int port;
+    int connections;
+    int depth;
+    double duration;
+    int weights[OP_COUNT];
+    unsigned int seed;
+};
+
+// Results of one connection thread
+struct ConnectionStats {
+    vector<long long> latencies;    // Round trip per request, nanoseconds
+    long long completed;
+    long long errors;               // "ERR" responses
+    bool failed;                    // Connection could not be used
+};
+
+static bool parseMix(const char* text, int weights[OP_COUNT]) {
+    for (int i = 0; i < OP_COUNT; i++) weights[i] = 0;
+
+    string list = text;
+    size_t start = 0;
+    while (start < list.size()) {
+        size_t comma = list.find(',', start);
+        if (comma == string::npos) comma = list.size();
+        string item = list.substr(start, comma - start);
+        size_t colon = item.find(':');
+        if (colon == string::npos) return false;
+
+        string name = item.substr(0, colon);
+        int op = 0;
+        while (op < OP_COUNT && name != OPERATION_NAMES[op]) op++;
+        if (op == OP_COUNT) return false;
+        weights[op] = atoi(item.c_str() + colon + 1);
+        start = comma + 1;
+    }
+
+    int total = 0;
+    for (int i = 0; i < OP_COUNT; i++) total += weights[i];
+    return total > 0;
+}
+
+static bool parseArgs(int argc, char* argv[], ClientConfig& config) {
+    config.socketPath = "/tmp/apuec.sock";
+    config.port = 0;
+    config.connections = 8;
+    config.depth = 16;
+    config.duration = 5;
+    parseMix("spectator:80,stats:15,allocate:5", config.weights);
+    config.seed = 42;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cout << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--socket") config.socketPath = value;
+        else if (arg == "--port") config.port = atoi(value);
+        else if (arg == "--connections") config.connections = atoi(value);
+        else if (arg == "--depth") config.depth = atoi(value);
+        else if (arg == "--duration") config.duration = atof(value);
+        else if (arg == "--mix") { if (!parseMix(value, config.weights)) return false; }
+        else if (arg == "--seed") config.seed = (unsigned int)atoi(value);
+        else {
+            cout << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+
+    return config.connections > 0 && config.depth > 0 && config.duration > 0;
+}
+
+static int connectToServer(const ClientConfig& config) {
+    int fd;
+    if (config.port > 0) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((unsigned short)config.port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, config.socketPath.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+static bool sendAll(int fd, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+// Generates request lines for one connection; ids are unique per connection
+class RequestGenerator {
+private:
+    mt19937 rng;
+    int weights[OP_COUNT];
+    int totalWeight;
+    int connectionId;
+    long long sequence;
+
+public:
+    RequestGenerator(const ClientConfig& config, int id) : rng(config.seed + id), connectionId(id), sequence(0) {
+        totalWeight = 0;
+        for (int i = 0; i < OP_COUNT; i++) {
+            weights[i] = config.weights[i];
+            totalWeight += weights[i];
+        }
+    }
+
+    void append(string& out) {
+        int roll = (int)(rng() % (unsigned int)totalWeight);
+        int op = 0;
+        while (roll >= weights[op]) roll -= weights[op++];
+
+        string id = to_string(connectionId) + "-" + to_string(sequence++);
+        switch (op) {
+            case OP_SPECTATOR:
+                out += "register spectator load" + id + "@load.test " + SPECTATOR_TYPES[rng() % 3] +
+                       " \"Load Spectator " + id + "\"\n";
+                break;
+            case OP_CHECKIN:
+                out += "check-in P" + to_string(rng() % 100) + "\n";
+                break;
+            case OP_ALLOCATE:
+                out += "allocate\n";
+                break;
+            case OP_STATS:
+                out += "stats\n";
+                break;
+            default:
+                out += "ping\n";
+                break;
+        }
+    }
+};
+
+static void runConnection(const ClientConfig& config, int id, Clock::time_point deadline, ConnectionStats& stats) {
+    stats.completed = 0;
+    stats.errors = 0;
+    stats.failed = false;
+
+    int fd = connectToServer(config);
+    if (fd < 0) {
+        stats.failed = true;
+        return;
+    }
+
+    RequestGenerator generator(config, id);
+    vector<Clock::time_point> sentAt(config.depth);     // Ring of in-flight send times
+    size_t head = 0;
+    size_t inFlight = 0;
+    string request;
+
+    // Fill the pipeline
+    for (int i = 0; i < config.depth; i++) {
+        generator.append(request);
+    }
+    Clock::time_point now = Clock::now();
+    for (int i = 0; i < config.depth; i++) {
+        sentAt[(head + inFlight++) % config.depth] = now;
+    }
+    if (!sendAll(fd, request)) {
+        stats.failed = true;
+        close(fd);
+        return;
+    }
+
+    char buffer[65536];
+    string pending;
+    int bodyLines = 0;      // Output lines still expected for the current "OK n"
+    bool draining = false;
+
+    while (inFlight > 0) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            stats.failed = true;
+            break;
+        }
+        pending.append(buffer, received);
+
+        now = Clock::now();
+        int finished = 0;
+        size_t start = 0;
+        size_t newline;
+        while ((newline = pending.find('\n', start)) != string::npos) {
+            if (bodyLines > 0) {
+                bodyLines--;
+            } else if (pending.compare(start, 3, "OK ") == 0) {
+                bodyLines = atoi(pending.c_str() + start + 3);
+            } else {
+                stats.errors++;
+            }
+            start = newline + 1;
+
+            if (bodyLines == 0) {
+                stats.latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(now - sentAt[head]).count());
+                head = (head + 1) % config.depth;
+                inFlight--;
+                finished++;
+            }
+        }
+        pending.erase(0, start);
+        stats.completed += finished;
+
+        if (!draining && now >= deadline) {
+            draining = true;
+        }
+        if (draining || finished == 0) continue;
+
+        // Replace every completed request in one write
+        request.clear();
+        for (int i = 0; i < finished; i++) {
+            generator.append(request);
+            sentAt[(head + inFlight++) % config.depth] = now;
+        }
+        if (!sendAll(fd, request)) {
+            stats.failed = true;
+            break;
+        }
+    }
+
+    close(fd);
+}
+
+static double percentile(const vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = (size_t)ceil(p * sorted.size());
+    if (index > 0) index--;
+    if (index >= sorted.size()) index = sorted.size() - 1;
+    return sorted[index] / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    ClientConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        cout << "Usage: apuec_loadclient [--socket PATH | --port N] [--connections N] [--depth N]\n"
+             << "                        [--duration S] [--mix op:weight,...] [--seed N]\n";
+        return 2;
+    }
+
+    vector<ConnectionStats> stats(config.connections);
+    vector<thread> threads;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + chrono::microseconds((long long)(config.duration * 1e6));
+    for (int i = 0; i < config.connections; i++) {
+        threads.push_back(thread(runConnection, cref(config), i, deadline, ref(stats[i])));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    double seconds = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count() / 1e9;
+
+    vector<long long> latencies;
+    long long completed = 0;
+    long long errors = 0;
+    int failedConnections = 0;
+    for (size_t i = 0; i < stats.size(); i++) {
+        latencies.insert(latencies.end(), stats[i].latencies.begin(), stats[i].latencies.end());
+        completed += stats[i].completed;
+        errors += stats[i].errors;
+        if (stats[i].failed) failedConnections++;
+    }
+    sort(latencies.begin(), latencies.end());
+
+    cout << "\n=== APUEC SERVER LOAD TEST ===\n";
+    cout << "Target: " << (config.port > 0 ? "127.0.0.1:" + to_string(config.port) : config.socketPath)
+         << ", " << config.connections << " connection(s) x depth " << config.depth << "\n";
+    cout << "Mix:";
+    for (int i = 0; i < OP_COUNT; i++) {
+        if (config.weights[i] > 0) cout << " " << OPERATION_NAMES[i] << ":" << config.weights[i];
+    }
+    cout << "\n";
+    cout << "Requests: " << completed << " in " << fixed << setprecision(2) << seconds << " s = "
+         << setprecision(0) << completed / seconds << " req/s\n";
+    cout << "ERR responses: " << errors << ", failed connections: " << failedConnections << "\n";
+    cout << setprecision(1) << "Latency (us): p50 " << percentile(latencies, 0.50)
+         << ", p99 " << percentile(latencies, 0.99)
+         << ", p999 " << percentile(latencies, 0.999)
+         << ", max " << (latencies.empty() ? 0.0 : latencies.back() / 1000.0) << "\n";
+
+    return failedConnections == 0 ? 0 : 1;
+}
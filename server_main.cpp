@@ -0,0 +1,131 @@
+/**
+ * APUEC Local RPC Server
+ *
+ * Serves the batch command protocol (see CommandProcessor) to local
+ * clients. Each request is one line; each response is "OK <n>" followed
+ * by n output lines, or "ERR <reason>". "ping" and "quit" are handled by
+ * the server itself. Requests may be pipelined.
+ *
+ * Usage: apuec_server [options]
+ *   --socket PATH     Unix domain socket (default /tmp/apuec.sock)
+ *   --port N          also listen on 127.0.0.1:N
+ *   --tcp-only        do not open the Unix socket (requires --port)
+ *   --workers N       connection worker threads (default 4)
+ *   --snapshot FILE   restore from FILE on start (if present), save it on stop
+ *   --trace FILE      write a Chrome trace on stop (needs -DAPUEC_TRACING=ON)
+ *
+ * Stops cleanly on SIGINT/SIGTERM.
+ */
+
+#include "apuec_server.hpp"
+#include "apuec_trace.hpp"
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+using namespace std;
+
+static ApuecServer* activeServer = nullptr;
+
+static void handleStopSignal(int) {
+    if (activeServer) activeServer->stop();
+}
+
+int main(int argc, char* argv[]) {
+    string socketPath = "/tmp/apuec.sock";
+    int port = 0;
+    int workers = 4;
+    bool tcpOnly = false;
+    string snapshotPath;
+    string tracePath;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            snapshotPath = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (strcmp(argv[i], "--tcp-only") == 0) {
+            tcpOnly = true;
+        } else {
+            cout << "Usage: apuec_server [--socket PATH] [--port N [--tcp-only]] [--workers N] "
+                    "[--snapshot FILE] [--trace FILE]\n";
+            return 2;
+        }
+    }
+    if (tcpOnly && port <= 0) {
+        cout << "--tcp-only requires --port\n";
+        return 2;
+    }
+
+    if (!tracePath.empty()) {
+        if (!Tracer::isCompiledIn()) {
+            cout << "Tracing is not compiled in (configure with -DAPUEC_TRACING=ON)\n";
+        }
+        Tracer::setThreadName("main");
+        Tracer::enable(true);
+    }
+
+    APUECCore core;     // Silent: clients only see protocol responses
+    if (!snapshotPath.empty() && access(snapshotPath.c_str(), F_OK) == 0) {
+        auto started = chrono::steady_clock::now();
+        CoreResult restored = core.loadSnapshot(snapshotPath);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        if (!restored.ok) {
+            cout << restored.message << "\n";
+            return 1;
+        }
+        SystemSummary summary = core.getSummary();
+        cout << "Restored " << snapshotPath << " in " << ms << " ms (" << summary.registeredTeams << " teams, "
+             << summary.registeredPlayers << " players, "
+             << summary.waitingSpectators + summary.seatedSpectators << " spectators)" << endl;
+    }
+    ApuecServer server(&core, workers);
+
+    if (!tcpOnly && !server.listenUnix(socketPath)) {
+        cout << "Cannot listen on " << socketPath << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+    if (port > 0 && !server.listenTcp(port)) {
+        cout << "Cannot listen on 127.0.0.1:" << port << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+
+    activeServer = &server;
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    cout << "APUEC server listening on";
+    if (!tcpOnly) cout << " " << socketPath;
+    if (port > 0) cout << " 127.0.0.1:" << port;
+    cout << " with " << workers << " worker(s)" << endl;
+
+    server.run();
+    activeServer = nullptr;
+
+    cout << "Served " << server.getRequestCount() << " request(s)" << endl;
+    if (!snapshotPath.empty()) {
+        CoreResult saved = core.saveSnapshot(snapshotPath);
+        cout << (saved.ok ? "Saved " + snapshotPath : saved.message) << endl;
+        if (!saved.ok) return 1;
+    }
+    if (!tracePath.empty()) {
+        Tracer::enable(false);
+        if (!Tracer::writeChromeTrace(tracePath)) {
+            cout << "Unable to write trace file " << tracePath << endl;
+            return 1;
+        }
+        cout << "Wrote " << Tracer::getEventCount() << " trace span(s) to " << tracePath;
+        if (Tracer::getDroppedCount() > 0) cout << " (" << Tracer::getDroppedCount() << " dropped)";
+        cout << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,356 @@
+#include "spectator_index.hpp"
+
+// ===== EMAIL INDEX IMPLEMENTATION =====
+
+EmailIndex::EmailIndex(int initialCapacity) : size(0), usedSlots(0) {
+    int slots = 16;
+    while (slots < clampCapacity(initialCapacity)) {
+        slots *= 2;
+    }
+    capacity = slots;
+    keys = new string[slots];
+    values = new int[slots];
+    states = new char[slots];
+    for (int i = 0; i < slots; i++) {
+        states[i] = SLOT_EMPTY;
+    }
+}
+
+EmailIndex::~EmailIndex() {
+    delete[] keys;
+    delete[] values;
+    delete[] states;
+}
+
+unsigned int EmailIndex::hashString(const string& key) {
+    // FNV-1a
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < key.size(); i++) {
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int EmailIndex::findSlot(const string& key) const {
+    int mask = capacity - 1;
+    int slot = hashString(key) & mask;
+    while (states[slot] != SLOT_EMPTY) {
+        if (states[slot] == SLOT_USED && keys[slot] == key) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+void EmailIndex::rehash(int newCapacity) {
+    string* oldKeys = keys;
+    int* oldValues = values;
+    char* oldStates = states;
+    int oldCapacity = capacity;
+
+    int slots = clampCapacity(newCapacity);
+    capacity = slots;
+    keys = new string[slots];
+    values = new int[slots];
+    states = new char[slots];
+    for (int i = 0; i < slots; i++) {
+        states[i] = SLOT_EMPTY;
+    }
+    size = 0;
+    usedSlots = 0;
+
+    int mask = capacity - 1;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldStates[i] != SLOT_USED) continue;
+        int slot = hashString(oldKeys[i]) & mask;
+        while (states[slot] != SLOT_EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        keys[slot].swap(oldKeys[i]);
+        values[slot] = oldValues[i];
+        states[slot] = SLOT_USED;
+        size++;
+        usedSlots++;
+    }
+
+    delete[] oldKeys;
+    delete[] oldValues;
+    delete[] oldStates;
+}
+
+void EmailIndex::reserve(int count) {
+    int needed = capacity;
+    while (needed < SPECTATOR_CAPACITY_LIMIT && (long long)count * 10 > (long long)needed * 7) {
+        needed *= 2;
+    }
+    if (needed > capacity) {
+        rehash(needed);
+    }
+}
+
+void EmailIndex::put(const string& key, int value) {
+    int existing = findSlot(key);
+    if (existing != -1) {
+        values[existing] = value;
+        return;
+    }
+
+    // Keep load (including tombstones) under 70%
+    if ((usedSlots + 1) * 10 > capacity * 7) {
+        rehash(size * 2 >= capacity / 2 ? grownCapacity(capacity) : capacity);
+    }
+
+    int mask = capacity - 1;
+    int slot = hashString(key) & mask;
+    while (states[slot] == SLOT_USED) {
+        slot = (slot + 1) & mask;
+    }
+    if (states[slot] == SLOT_EMPTY) {
+        usedSlots++;
+    }
+    keys[slot] = key;
+    values[slot] = value;
+    states[slot] = SLOT_USED;
+    size++;
+}
+
+bool EmailIndex::find(const string& key, int& value) const {
+    int slot = findSlot(key);
+    if (slot == -1) return false;
+    value = values[slot];
+    return true;
+}
+
+bool EmailIndex::erase(const string& key) {
+    int slot = findSlot(key);
+    if (slot == -1) return false;
+    keys[slot].clear();
+    states[slot] = SLOT_DELETED;
+    size--;
+    return true;
+}
+
+void EmailIndex::clear() {
+    for (int i = 0; i < capacity; i++) {
+        keys[i].clear();
+        states[i] = SLOT_EMPTY;
+    }
+    size = 0;
+    usedSlots = 0;
+}
+
+// ===== NAME PREFIX INDEX IMPLEMENTATION =====
+
+static const int INITIAL_ENTRY_CAPACITY = 64;
+
+NamePrefixIndex::NamePrefixIndex(int initialBuckets)
+    : entryCapacity(INITIAL_ENTRY_CAPACITY), entryCount(0), freeEntry(-1), liveEntries(0) {
+    int count = 16;
+    while (count < clampCapacity(initialBuckets)) {
+        count *= 2;
+    }
+    bucketCount = count;
+    buckets = new int[count];
+    for (int i = 0; i < count; i++) {
+        buckets[i] = -1;
+    }
+    entries = new Entry[INITIAL_ENTRY_CAPACITY];
+}
+
+NamePrefixIndex::~NamePrefixIndex() {
+    delete[] entries;
+    delete[] buckets;
+}
+
+string NamePrefixIndex::toLower(const string& text) {
+    string lower = text;
+    for (size_t i = 0; i < lower.size(); i++) {
+        if (lower[i] >= 'A' && lower[i] <= 'Z') {
+            lower[i] = lower[i] - 'A' + 'a';
+        }
+    }
+    return lower;
+}
+
+int NamePrefixIndex::allocEntry() {
+    if (freeEntry != -1) {
+        int index = freeEntry;
+        freeEntry = entries[index].next;
+        return index;
+    }
+
+    if (entryCount >= entryCapacity) {
+        growEntries(grownCapacity(entryCapacity));
+    }
+    return entryCount++;
+}
+
+void NamePrefixIndex::growEntries(int newCapacity) {
+    newCapacity = clampCapacity(newCapacity);
+    Entry* newEntries = new Entry[newCapacity];
+    for (int i = 0; i < entryCount; i++) {
+        newEntries[i].prefix.swap(entries[i].prefix);
+        newEntries[i].name.swap(entries[i].name);
+        newEntries[i].email.swap(entries[i].email);
+        newEntries[i].next = entries[i].next;
+        newEntries[i].prev = entries[i].prev;
+        newEntries[i].sibling = entries[i].sibling;
+    }
+    delete[] entries;
+    entries = newEntries;
+    entryCapacity = newCapacity;
+}
+
+void NamePrefixIndex::reserve(int names) {
+    // Keep the bucket count (needed rounded up past a power of two) in range
+    const int maxNames = SPECTATOR_CAPACITY_LIMIT / (2 * NAME_PREFIX_KEY_LENGTH);
+    if (names < 0) names = 0;
+    if (names > maxNames) names = maxNames;
+    int needed = names * NAME_PREFIX_KEY_LENGTH;
+    if (needed > entryCapacity) {
+        growEntries(needed);
+    }
+    while (bucketCount <= needed) {
+        growBuckets();
+    }
+    owners.reserve(names);
+}
+
+void NamePrefixIndex::growBuckets() {
+    int newCount = grownCapacity(bucketCount);
+    int* newBuckets = new int[newCount];
+    for (int i = 0; i < newCount; i++) {
+        newBuckets[i] = -1;
+    }
+
+    // Relink live entries; recycled entries are not in any chain
+    for (int b = 0; b < bucketCount; b++) {
+        int index = buckets[b];
+        while (index != -1) {
+            int next = entries[index].next;
+            int nb = EmailIndex::hashString(entries[index].prefix) & (newCount - 1);
+            entries[index].prev = -1;
+            entries[index].next = newBuckets[nb];
+            if (newBuckets[nb] != -1) {
+                entries[newBuckets[nb]].prev = index;
+            }
+            newBuckets[nb] = index;
+            index = next;
+        }
+    }
+
+    delete[] buckets;
+    buckets = newBuckets;
+    bucketCount = newCount;
+}
+
+void NamePrefixIndex::add(const string& name, const string& email) {
+    string lowerName = toLower(name);
+    int keyLength = (int)lowerName.size() < NAME_PREFIX_KEY_LENGTH ? (int)lowerName.size() : NAME_PREFIX_KEY_LENGTH;
+
+    int first = -1;
+    if (owners.find(email, first)) {
+        remove(email);
+        first = -1;
+    }
+
+    int last = -1;
+    for (int len = 1; len <= keyLength; len++) {
+        if (liveEntries >= bucketCount) {
+            growBuckets();
+        }
+
+        int index = allocEntry();
+        entries[index].prefix = lowerName.substr(0, len);
+        entries[index].name = lowerName;
+        entries[index].email = email;
+        entries[index].sibling = -1;
+
+        int b = EmailIndex::hashString(entries[index].prefix) & (bucketCount - 1);
+        entries[index].prev = -1;
+        entries[index].next = buckets[b];
+        if (buckets[b] != -1) {
+            entries[buckets[b]].prev = index;
+        }
+        buckets[b] = index;
+        liveEntries++;
+
+        if (last == -1) {
+            first = index;
+        } else {
+            entries[last].sibling = index;
+        }
+        last = index;
+    }
+
+    if (first != -1) {
+        owners.put(email, first);
+    }
+}
+
+void NamePrefixIndex::remove(const string& email) {
+    int index;
+    if (!owners.find(email, index)) return;
+    owners.erase(email);
+
+    while (index != -1) {
+        Entry& e = entries[index];
+        int sibling = e.sibling;
+
+        // Unlink from the bucket chain
+        if (e.prev != -1) {
+            entries[e.prev].next = e.next;
+        } else {
+            int b = EmailIndex::hashString(e.prefix) & (bucketCount - 1);
+            buckets[b] = e.next;
+        }
+        if (e.next != -1) {
+            entries[e.next].prev = e.prev;
+        }
+
+        e.prefix.clear();
+        e.name.clear();
+        e.email.clear();
+        e.prev = -1;
+        e.sibling = -1;
+        e.next = freeEntry;
+        freeEntry = index;
+        liveEntries--;
+
+        index = sibling;
+    }
+}
+
+int NamePrefixIndex::search(const string& prefix, string emails[], int maxResults) const {
+    if (prefix.empty()) return 0;
+
+    string lowerPrefix = toLower(prefix);
+    string key = lowerPrefix.substr(0, NAME_PREFIX_KEY_LENGTH);
+    int b = EmailIndex::hashString(key) & (bucketCount - 1);
+
+    int found = 0;
+    for (int index = buckets[b]; index != -1 && found < maxResults; index = entries[index].next) {
+        const Entry& e = entries[index];
+        if (e.prefix != key) continue;
+        if (e.name.compare(0, lowerPrefix.size(), lowerPrefix) != 0) continue;
+        emails[found++] = e.email;
+    }
+    return found;
+}
+
+void NamePrefixIndex::clear() {
+    for (int i = 0; i < entryCount; i++) {
+        entries[i].prefix.clear();
+        entries[i].name.clear();
+        entries[i].email.clear();
+    }
+    for (int i = 0; i < bucketCount; i++) {
+        buckets[i] = -1;
+    }
+    entryCount = 0;
+    freeEntry = -1;
+    liveEntries = 0;
+    owners.clear();
+}
@@ -0,0 +1,110 @@
+#ifndef SPECTATOR_INDEX_HPP
+#define SPECTATOR_INDEX_HPP
+
+#include <new>
+#include <string>
+using namespace std;
+
+const int NAME_PREFIX_KEY_LENGTH = 3;   // Longest name prefix stored in NamePrefixIndex
+
+// Element limit (a power of two) of the growable spectator arrays and
+// indexes. Sizes are ints, so every `new T[n]` takes a count clamped to
+// [1, SPECTATOR_CAPACITY_LIMIT]; a negative or overflowed count never
+// reaches it.
+const int SPECTATOR_CAPACITY_LIMIT = 1 << 28;
+
+inline int clampCapacity(int requested) {
+    if (requested < 1) return 1;
+    return requested < SPECTATOR_CAPACITY_LIMIT ? requested : SPECTATOR_CAPACITY_LIMIT;
+}
+
+// Doubled capacity for a full array; bad_alloc once it is at the limit
+inline int grownCapacity(int capacity) {
+    if (capacity >= SPECTATOR_CAPACITY_LIMIT) throw bad_alloc();
+    return capacity < 1 ? 1 : clampCapacity(capacity * 2);
+}
+
+// Hash table from email to an integer slot (heap position, seat id, ...)
+// Open addressing with linear probing; erased entries leave tombstones
+// that are dropped on the next resize.
+class EmailIndex {
+private:
+    enum SlotState { SLOT_EMPTY = 0, SLOT_USED = 1, SLOT_DELETED = 2 };
+
+    string* keys;
+    int* values;
+    char* states;
+    int capacity;           // Always a power of two
+    int size;               // Live entries
+    int usedSlots;          // Live entries + tombstones
+
+    int findSlot(const string& key) const;     // Slot holding key, -1 if absent
+    void rehash(int newCapacity);
+
+    // Disable copying (owns raw arrays)
+    EmailIndex(const EmailIndex&);
+    EmailIndex& operator=(const EmailIndex&);
+
+public:
+    EmailIndex(int initialCapacity = 16);
+    ~EmailIndex();
+
+    void put(const string& key, int value);    // Insert or overwrite
+    void reserve(int count);                   // Room for count keys without rehashing
+    bool find(const string& key, int& value) const;
+    bool contains(const string& key) const { return findSlot(key) != -1; }
+    bool erase(const string& key);
+    void clear();
+
+    int getSize() const { return size; }
+
+    static unsigned int hashString(const string& key);
+};
+
+// Hash index from lower-cased name prefixes (1..NAME_PREFIX_KEY_LENGTH
+// characters) to the emails of the spectators carrying that prefix.
+// Lookups with longer prefixes use the longest stored key and filter the
+// bucket by the full prefix. Chains are doubly linked and each email
+// remembers its entries, so removal does not walk shared-prefix buckets.
+class NamePrefixIndex {
+private:
+    struct Entry {
+        string prefix;      // Lower-cased key prefix
+        string name;        // Lower-cased full name
+        string email;
+        int next;           // Next entry in the bucket chain (-1 = end)
+        int prev;           // Previous entry in the bucket chain (-1 = bucket head)
+        int sibling;        // Next entry added for the same email (-1 = end)
+    };
+
+    Entry* entries;         // Entry pool
+    int entryCapacity;
+    int entryCount;
+    int freeEntry;          // Head of recycled entry list (-1 = none)
+    int* buckets;           // Bucket heads into entries
+    int bucketCount;        // Always a power of two
+    int liveEntries;
+    EmailIndex owners;      // Email -> first of its entries
+
+    int allocEntry();
+    void growEntries(int newCapacity);
+    void growBuckets();
+
+    // Disable copying (owns raw arrays)
+    NamePrefixIndex(const NamePrefixIndex&);
+    NamePrefixIndex& operator=(const NamePrefixIndex&);
+
+public:
+    NamePrefixIndex(int initialBuckets = 64);
+    ~NamePrefixIndex();
+
+    void add(const string& name, const string& email);
+    void reserve(int names);    // Room for names without regrowing
+    void remove(const string& email);       // Every prefix entry of email
+    int search(const string& prefix, string emails[], int maxResults) const;
+    void clear();
+
+    static string toLower(const string& text);
+};
+
+#endif
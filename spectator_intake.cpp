@@ -0,0 +1,62 @@
+#include "spectator_intake.hpp"
+#include <ctime>
+
+// ===== SPECTATOR INTAKE QUEUE IMPLEMENTATION =====
+
+SpectatorIntakeQueue::SpectatorIntakeQueue() : pending(0) {
+    Node* dummy = new Node();
+    head.store(dummy, memory_order_relaxed);
+    tail = dummy;
+}
+
+SpectatorIntakeQueue::~SpectatorIntakeQueue() {
+    // No producers may be running during destruction
+    Node* node = tail;
+    while (node != nullptr) {
+        Node* next = node->next.load(memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+void SpectatorIntakeQueue::submit(const string& name, const string& email, const string& type) {
+    SpectatorIntakeRequest request;
+    request.name = name;
+    request.email = email;
+    request.type = type;
+    request.arrivalTime = static_cast<int>(time(nullptr));
+    submit(request);
+}
+
+void SpectatorIntakeQueue::submit(const SpectatorIntakeRequest& request) {
+    Node* node = new Node();
+    node->request = request;
+
+    // Claim the end of the list, then link the previous end to us
+    Node* prev = head.exchange(node, memory_order_acq_rel);
+    prev->next.store(node, memory_order_release);
+    pending.fetch_add(1, memory_order_relaxed);
+}
+
+int SpectatorIntakeQueue::drain(SpectatorIntakeRequest out[], int maxBatch) {
+    int count = 0;
+    while (count < maxBatch) {
+        Node* next = tail->next.load(memory_order_acquire);
+        if (next == nullptr) break;
+
+        // next becomes the new dummy once its request is moved out
+        out[count].name.swap(next->request.name);
+        out[count].email.swap(next->request.email);
+        out[count].type.swap(next->request.type);
+        out[count].arrivalTime = next->request.arrivalTime;
+        count++;
+
+        delete tail;
+        tail = next;
+    }
+
+    if (count > 0) {
+        pending.fetch_sub(count, memory_order_relaxed);
+    }
+    return count;
+}
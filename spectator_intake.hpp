@@ -0,0 +1,53 @@
+#ifndef SPECTATOR_INTAKE_HPP
+#define SPECTATOR_INTAKE_HPP
+
+#include <atomic>
+#include <string>
+using namespace std;
+
+// Registration waiting to be added to the spectator queue
+struct SpectatorIntakeRequest {
+    string name;
+    string email;
+    string type;        // "VIP", "Influencer", "General"
+    int arrivalTime;    // Stamped when the request is submitted
+};
+
+// Multi-producer single-consumer queue for spectator registrations.
+// Any number of front-end threads may call submit() concurrently; a
+// push is one atomic exchange plus one store and never blocks. Only the
+// thread that owns the SpectatorManager may call drain(), which moves
+// requests out in batches so producers never touch the heap.
+// (Linked list with a dummy node; a push that is between its exchange
+// and its link is simply picked up by the next drain.)
+class SpectatorIntakeQueue {
+private:
+    struct Node {
+        atomic<Node*> next;
+        SpectatorIntakeRequest request;
+        Node() : next(nullptr) {}
+    };
+
+    atomic<Node*> head;         // Last pushed node (producers)
+    Node* tail;                 // Dummy node before the oldest request (consumer)
+    atomic<int> pending;        // Submitted but not yet drained
+
+    // Disable copying (owns the node list)
+    SpectatorIntakeQueue(const SpectatorIntakeQueue&);
+    SpectatorIntakeQueue& operator=(const SpectatorIntakeQueue&);
+
+public:
+    SpectatorIntakeQueue();
+    ~SpectatorIntakeQueue();
+
+    // Producer side (thread-safe)
+    void submit(const string& name, const string& email, const string& type);
+    void submit(const SpectatorIntakeRequest& request);
+
+    // Consumer side (owner thread only)
+    int drain(SpectatorIntakeRequest out[], int maxBatch);
+
+    int getPending() const { return pending.load(memory_order_relaxed); }
+};
+
+#endif
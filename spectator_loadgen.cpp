@@ -0,0 +1,367 @@
+/**
+ * APUEC Spectator Load Generator
+ *
+ * Drives SpectatorManager with synthetic gate-opening traffic:
+ * registrations arrive as a Poisson process with a configurable
+ * VIP/Influencer/General mix, seat allocation runs at a fixed rate and
+ * cancellations remove random earlier registrations. Reports
+ * p50/p99/p999 latency per operation and the queue depth over time.
+ *
+ * Usage: spectator_loadgen [options]
+ *   --rate N          registrations per second (default 20000)
+ *   --duration S      seconds to run (default 5)
+ *   --mix V,I,G       percentage of VIP, Influencer, General (default 10,20,70)
+ *   --seats V,I,G     venue capacity per tier (default 2000,3000,45000)
+ *   --allocate-rate N allocateSeating calls per second (default 50)
+ *   --cancel-rate N   cancellations per second (default 0)
+ *   --producers N     register through the intake queue from N threads (default 0 = direct)
+ *   --sample-ms N     queue depth sampling interval (default 250)
+ *   --seed N          random seed (default 42)
+ *   --save FILE       save to FILE every --save-ms (incremental appends) and
+ *                     check that reloading FILE restores the final state
+ *   --save-ms N       save interval (default 200)
+ */
+
+#include "spectator_manager.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+struct LoadConfig {
+    double rate;
+    double duration;
+    int mix[3];
+    int seats[3];
+    double allocateRate;
+    double cancelRate;
+    int producers;
+    int sampleMs;
+    unsigned int seed;
+    string saveFile;
+    int saveMs;
+};
+
+struct DepthSample {
+    double seconds;
+    int waiting;
+    int seated;
+};
+
+// Latency samples for one operation, in nanoseconds
+class LatencyRecorder {
+private:
+    const char* name;
+    vector<long long> samples;
+
+public:
+    LatencyRecorder(const char* opName) : name(opName) {}
+
+    void record(long long nanos) { samples.push_back(nanos); }
+
+    void report() {
+        if (samples.empty()) {
+            cout << left << setw(14) << name << "no samples\n";
+            return;
+        }
+        sort(samples.begin(), samples.end());
+        cout << left << setw(14) << name
+             << right << setw(10) << samples.size()
+             << setw(12) << percentile(0.50)
+             << setw(12) << percentile(0.99)
+             << setw(12) << percentile(0.999)
+             << setw(12) << samples.back() / 1000.0 << "\n";
+    }
+
+    double percentile(double p) const {
+        size_t index = (size_t)ceil(p * samples.size());
+        if (index > 0) index--;
+        if (index >= samples.size()) index = samples.size() - 1;
+        return samples[index] / 1000.0;
+    }
+};
+
+// Three comma-separated counts, none negative
+static bool parseTriple(const char* text, int out[3]) {
+    if (sscanf(text, "%d,%d,%d", &out[0], &out[1], &out[2]) != 3) return false;
+    return out[0] >= 0 && out[1] >= 0 && out[2] >= 0;
+}
+
+static bool parseArgs(int argc, char* argv[], LoadConfig& config) {
+    config.rate = 20000;
+    config.duration = 5;
+    config.mix[0] = 10; config.mix[1] = 20; config.mix[2] = 70;
+    config.seats[0] = 2000; config.seats[1] = 3000; config.seats[2] = 45000;
+    config.allocateRate = 50;
+    config.cancelRate = 0;
+    config.producers = 0;
+    config.sampleMs = 250;
+    config.seed = 42;
+    config.saveMs = 200;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cout << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--rate") config.rate = atof(value);
+        else if (arg == "--duration") config.duration = atof(value);
+        else if (arg == "--mix") { if (!parseTriple(value, config.mix)) return false; }
+        else if (arg == "--seats") { if (!parseTriple(value, config.seats)) return false; }
+        else if (arg == "--allocate-rate") config.allocateRate = atof(value);
+        else if (arg == "--cancel-rate") config.cancelRate = atof(value);
+        else if (arg == "--producers") config.producers = atoi(value);
+        else if (arg == "--sample-ms") config.sampleMs = atoi(value);
+        else if (arg == "--seed") config.seed = (unsigned int)atoi(value);
+        else if (arg == "--save") config.saveFile = value;
+        else if (arg == "--save-ms") config.saveMs = atoi(value);
+        else {
+            cout << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (config.rate <= 0 || config.duration <= 0 || config.sampleMs <= 0 || config.saveMs <= 0) return false;
+    if (config.mix[0] + config.mix[1] + config.mix[2] <= 0) return false;
+    return true;
+}
+
+static const char* pickType(mt19937& rng, const int mix[3]) {
+    int total = mix[0] + mix[1] + mix[2];
+    int roll = (int)(rng() % (unsigned int)total);
+    if (roll < mix[0]) return "VIP";
+    if (roll < mix[0] + mix[1]) return "Influencer";
+    return "General";
+}
+
+static double nextGap(mt19937& rng, double rate) {
+    // Exponential inter-arrival time for a Poisson process, in seconds
+    exponential_distribution<double> gap(rate);
+    return gap(rng);
+}
+
+static long long elapsedNanos(Clock::time_point start) {
+    return chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+// Email -> seat label ("" while waiting) of every spectator in manager
+static void collectState(const SpectatorManager& manager, map<string, string>& state) {
+    vector<Spectator> spectators;
+    manager.copySpectators(spectators);
+    state.clear();
+    for (size_t i = 0; i < spectators.size(); i++) {
+        state[spectators[i].getEmail()] = spectators[i].getIsSeated() ? spectators[i].getSeatSection() : "";
+    }
+}
+
+// Reload the saved file into a fresh venue and compare it with the live state
+static bool checkReload(const SpectatorManager& manager, const LoadConfig& config) {
+    SpectatorManager reloaded(config.seats[0], config.seats[1], config.seats[2], nullptr);
+    if (!reloaded.loadFromFile(config.saveFile)) {
+        cout << "Reload check: unable to read " << config.saveFile << "\n";
+        return false;
+    }
+
+    map<string, string> expected, actual;
+    collectState(manager, expected);
+    collectState(reloaded, actual);
+    cout << "Reload check: " << reloaded.getSeatedCount() << " seated, "
+         << reloaded.getWaitingCount() << " waiting";
+    if (actual == expected) {
+        cout << " (matches)\n";
+        return true;
+    }
+
+    int differences = 0;
+    for (map<string, string>::const_iterator it = expected.begin(); it != expected.end(); ++it) {
+        map<string, string>::const_iterator found = actual.find(it->first);
+        if (found == actual.end() || found->second != it->second) differences++;
+    }
+    for (map<string, string>::const_iterator it = actual.begin(); it != actual.end(); ++it) {
+        if (expected.find(it->first) == expected.end()) differences++;
+    }
+    cout << ", MISMATCH: " << differences << " spectator(s) differ from the live state\n";
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    LoadConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        cout << "Usage: spectator_loadgen [--rate N] [--duration S] [--mix V,I,G] [--seats V,I,G]\n"
+             << "                         [--allocate-rate N] [--cancel-rate N] [--producers N]\n"
+             << "                         [--sample-ms N] [--seed N] [--save FILE] [--save-ms N]\n";
+        return 1;
+    }
+
+    // Silent manager: allocation reports would dominate the measured latency
+    SpectatorManager manager(config.seats[0], config.seats[1], config.seats[2], nullptr);
+    mt19937 rng(config.seed);
+
+    LatencyRecorder insertLatency("insert");
+    LatencyRecorder allocateLatency("allocate");
+    LatencyRecorder cancelLatency("cancel");
+    LatencyRecorder intakeLatency("intake-drain");
+    LatencyRecorder saveLatency("save");
+    vector<DepthSample> depth;
+    vector<string> emails;
+
+    // Optional producer threads feeding the intake queue at rate / producers each
+    atomic<bool> running(true);
+    atomic<long long> submitted(0);
+    vector<thread> producers;
+    for (int p = 0; p < config.producers; p++) {
+        producers.push_back(thread([&, p]() {
+            mt19937 localRng(config.seed + 1 + p);
+            double perThreadRate = config.rate / config.producers;
+            Clock::time_point start = Clock::now();
+            double due = nextGap(localRng, perThreadRate);
+            long long n = 0;
+            while (running.load(memory_order_relaxed)) {
+                double now = elapsedNanos(start) / 1e9;
+                if (now < due) {
+                    this_thread::yield();
+                    continue;
+                }
+                string id = to_string(p) + "-" + to_string(n++);
+                manager.getIntakeQueue()->submit("Spectator" + id, "spec" + id + "@load.test",
+                                                 pickType(localRng, config.mix));
+                submitted.fetch_add(1, memory_order_relaxed);
+                due += nextGap(localRng, perThreadRate);
+            }
+        }));
+    }
+
+    Clock::time_point start = Clock::now();
+    double nextArrival = (config.producers == 0) ? nextGap(rng, config.rate) : config.duration + 1;
+    double allocateInterval = (config.allocateRate > 0) ? 1.0 / config.allocateRate : config.duration + 1;
+    double nextAllocate = allocateInterval;
+    double nextCancel = (config.cancelRate > 0) ? nextGap(rng, config.cancelRate) : config.duration + 1;
+    double saveInterval = config.saveMs / 1000.0;
+    double nextSave = config.saveFile.empty() ? config.duration + 1 : saveInterval;
+    double nextSample = 0;
+    double maxLag = 0;
+    long long registered = 0;
+    int arrivalTime = 0;
+
+    while (true) {
+        double now = elapsedNanos(start) / 1e9;
+        if (now >= config.duration) break;
+
+        if (now >= nextSample) {
+            DepthSample sample;
+            sample.seconds = now;
+            sample.waiting = manager.getWaitingCount();
+            sample.seated = manager.getSeatedCount();
+            depth.push_back(sample);
+            nextSample += config.sampleMs / 1000.0;
+        }
+
+        // Run whichever event is due first
+        double due = min(min(nextArrival, nextAllocate), min(nextCancel, nextSave));
+        if (now < due) {
+            if (config.producers > 0 && manager.getIntakeQueue()->getPending() > 0) {
+                Clock::time_point opStart = Clock::now();
+                manager.processIntake();
+                intakeLatency.record(elapsedNanos(opStart));
+            }
+            continue;
+        }
+        maxLag = max(maxLag, now - due);
+
+        if (due == nextArrival) {
+            string id = to_string(registered);
+            Spectator spectator("Spectator" + id, "spec" + id + "@load.test",
+                                pickType(rng, config.mix), arrivalTime++);
+            emails.push_back(spectator.getEmail());
+
+            Clock::time_point opStart = Clock::now();
+            manager.addSpectator(spectator);
+            insertLatency.record(elapsedNanos(opStart));
+
+            registered++;
+            nextArrival += nextGap(rng, config.rate);
+        } else if (due == nextAllocate) {
+            Clock::time_point opStart = Clock::now();
+            manager.allocateSeating();
+            allocateLatency.record(elapsedNanos(opStart));
+            nextAllocate += allocateInterval;
+        } else if (due == nextSave) {
+            Clock::time_point opStart = Clock::now();
+            manager.saveToFile(config.saveFile);
+            saveLatency.record(elapsedNanos(opStart));
+            nextSave += saveInterval;
+        } else {
+            if (!emails.empty()) {
+                const string& email = emails[rng() % emails.size()];
+                Clock::time_point opStart = Clock::now();
+                manager.removeSpectatorByEmail(email);
+                cancelLatency.record(elapsedNanos(opStart));
+            }
+            nextCancel += nextGap(rng, config.cancelRate);
+        }
+    }
+
+    running.store(false);
+    for (size_t p = 0; p < producers.size(); p++) {
+        producers[p].join();
+    }
+
+    double seconds = elapsedNanos(start) / 1e9;
+    long long arrivals = (config.producers > 0) ? submitted.load() : registered;
+
+    cout << "\n=== SPECTATOR LOAD TEST ===\n";
+    cout << "Duration: " << fixed << setprecision(2) << seconds << " s, target rate "
+         << config.rate << "/s, achieved " << arrivals / seconds << "/s\n";
+    cout << "Mix (VIP/Influencer/General): " << config.mix[0] << "/" << config.mix[1]
+         << "/" << config.mix[2] << ", seats " << config.seats[0] << "/" << config.seats[1]
+         << "/" << config.seats[2] << "\n";
+    cout << "Max schedule lag: " << maxLag * 1000.0 << " ms\n";
+    cout << "Final state: " << manager.getSeatedCount() << " seated, "
+         << manager.getWaitingCount() << " waiting\n";
+
+    cout << "\n" << left << setw(14) << "Operation" << right << setw(10) << "Count"
+         << setw(12) << "p50 (us)" << setw(12) << "p99 (us)" << setw(12) << "p999 (us)"
+         << setw(12) << "max (us)" << "\n";
+    cout << string(72, '-') << "\n";
+    if (config.producers > 0) {
+        intakeLatency.report();
+    } else {
+        insertLatency.report();
+    }
+    allocateLatency.report();
+    if (config.cancelRate > 0) {
+        cancelLatency.report();
+    }
+    if (!config.saveFile.empty()) {
+        saveLatency.report();
+    }
+
+    cout << "\n" << left << setw(12) << "Time (s)" << right << setw(12) << "Waiting"
+         << setw(12) << "Seated" << "\n";
+    cout << string(36, '-') << "\n";
+    for (size_t i = 0; i < depth.size(); i++) {
+        cout << left << setw(12) << depth[i].seconds << right << setw(12) << depth[i].waiting
+             << setw(12) << depth[i].seated << "\n";
+    }
+
+    if (!config.saveFile.empty()) {
+        cout << "\n";
+        if (!manager.saveToFile(config.saveFile) || !checkReload(manager, config)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
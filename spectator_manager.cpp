@@ -1,4 +1,6 @@
 #include "spectator_manager.hpp"
+#include "apuec_trace.hpp"
+#include "spectator_store.hpp"
 #include <ctime>
 #include <sstream>
 
@@ -26,8 +28,8 @@ void Spectator::setSpectatorType(string type) {
     }
 }
 
-void Spectator::displaySpectator() const {
-    cout << left << setw(15) << name 
+void Spectator::displaySpectator(ostream& os) const {
+    os << left << setw(15) << name 
          << setw(25) << email 
          << setw(12) << spectatorType
          << setw(10) << priority
@@ -60,22 +62,39 @@ bool Spectator::operator>(const Spectator& other) const {
 // ===== PRIORITY QUEUE IMPLEMENTATION =====
 
 SpectatorPriorityQueue::SpectatorPriorityQueue(int initialCapacity) 
-    : capacity(initialCapacity), size(0) {
-    heap = new Spectator[capacity];
+    : freeCount(0), nextHandle(0), capacity(clampCapacity(initialCapacity)), size(0),
+      frontier(nullptr), frontierCapacity(0) {
+    int slots = clampCapacity(initialCapacity);
+    nodes = new Spectator[slots];
+    heap = new int[slots];
+    handlePos = new int[slots];
+    freeHandles = new int[slots];
 }
 
 SpectatorPriorityQueue::~SpectatorPriorityQueue() {
+    delete[] nodes;
     delete[] heap;
+    delete[] handlePos;
+    delete[] freeHandles;
+    delete[] frontier;
 }
 
-void SpectatorPriorityQueue::insert(const Spectator& spectator) {
+int SpectatorPriorityQueue::insert(const Spectator& spectator) {
     if (size >= capacity) {
-        resizeHeap();
+        resizeHeap(grownCapacity(capacity));
     }
     
-    heap[size] = spectator;
+    // Reuse a released handle before issuing a new one
+    int handle = (freeCount > 0) ? freeHandles[--freeCount] : nextHandle++;
+    nodes[handle] = spectator;
+    handles.put(spectator.getEmail(), handle);
+    
+    heap[size] = handle;
+    handlePos[handle] = size;
     heapifyUp(size);
     size++;
+    
+    return handle;
 }
 
 Spectator SpectatorPriorityQueue::extractMax() {
@@ -83,32 +102,97 @@ Spectator SpectatorPriorityQueue::extractMax() {
         throw runtime_error("Queue is empty!");
     }
     
-    Spectator maxSpectator = heap[0];
-    heap[0] = heap[size - 1];
+    return removeAt(0);
+}
+
+Spectator SpectatorPriorityQueue::peek() const {
+    if (isEmpty()) {
+        throw runtime_error("Queue is empty!");
+    }
+    return nodes[heap[0]];
+}
+
+Spectator SpectatorPriorityQueue::removeAt(int index) {
+    if (index < 0 || index >= size) {
+        throw runtime_error("Invalid queue position!");
+    }
+    
+    int handle = heap[index];
+    Spectator removed = nodes[handle];
+    handles.erase(removed.getEmail());
+    handlePos[handle] = -1;
+    nodes[handle] = Spectator();
+    freeHandles[freeCount++] = handle;
+    
     size--;
+    if (index < size) {
+        // Fill the hole with the last element and restore heap order
+        heap[index] = heap[size];
+        handlePos[heap[index]] = index;
+        if (index > 0 && higher(index, getParentIndex(index))) {
+            heapifyUp(index);
+        } else {
+            heapifyDown(index);
+        }
+    }
     
-    if (size > 0) {
-        heapifyDown(0);
+    return removed;
+}
+
+bool SpectatorPriorityQueue::contains(int handle) const {
+    return handle >= 0 && handle < nextHandle && handlePos[handle] != -1;
+}
+
+void SpectatorPriorityQueue::updatePriority(int handle, const string& newType) {
+    if (!contains(handle)) {
+        throw runtime_error("Invalid queue handle!");
     }
     
-    return maxSpectator;
+    int oldPriority = nodes[handle].getPriority();
+    nodes[handle].setSpectatorType(newType);
+    
+    // Lower number = higher priority
+    if (nodes[handle].getPriority() < oldPriority) {
+        heapifyUp(handlePos[handle]);
+    } else if (nodes[handle].getPriority() > oldPriority) {
+        heapifyDown(handlePos[handle]);
+    }
 }
 
-Spectator SpectatorPriorityQueue::peek() const {
-    if (isEmpty()) {
-        throw runtime_error("Queue is empty!");
+Spectator SpectatorPriorityQueue::erase(int handle) {
+    if (!contains(handle)) {
+        throw runtime_error("Invalid queue handle!");
+    }
+    return removeAt(handlePos[handle]);
+}
+
+int SpectatorPriorityQueue::findHandle(const string& email) const {
+    int handle;
+    if (handles.find(email, handle)) {
+        return handle;
     }
-    return heap[0];
+    return -1;
+}
+
+int SpectatorPriorityQueue::findIndex(const string& email) const {
+    int handle = findHandle(email);
+    return (handle == -1) ? -1 : handlePos[handle];
+}
+
+void SpectatorPriorityQueue::swapNodes(int a, int b) {
+    int temp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = temp;
+    handlePos[heap[a]] = a;
+    handlePos[heap[b]] = b;
 }
 
 void SpectatorPriorityQueue::heapifyUp(int index) {
     while (index > 0) {
         int parentIndex = getParentIndex(index);
-        if (heap[index] > heap[parentIndex]) {
+        if (higher(index, parentIndex)) {
             // Swap with parent
-            Spectator temp = heap[index];
-            heap[index] = heap[parentIndex];
-            heap[parentIndex] = temp;
+            swapNodes(index, parentIndex);
             index = parentIndex;
         } else {
             break;
@@ -122,77 +206,204 @@ void SpectatorPriorityQueue::heapifyDown(int index) {
         
         // Find the child with higher priority
         if (getRightChildIndex(index) < size && 
-            heap[getRightChildIndex(index)] > heap[maxChildIndex]) {
+            higher(getRightChildIndex(index), maxChildIndex)) {
             maxChildIndex = getRightChildIndex(index);
         }
         
-        if (heap[index] > heap[maxChildIndex]) {
+        if (higher(index, maxChildIndex)) {
             break;
         } else {
             // Swap with max child
-            Spectator temp = heap[index];
-            heap[index] = heap[maxChildIndex];
-            heap[maxChildIndex] = temp;
+            swapNodes(index, maxChildIndex);
             index = maxChildIndex;
         }
     }
 }
 
-void SpectatorPriorityQueue::resizeHeap() {
-    int newCapacity = capacity * 2;
-    Spectator* newHeap = new Spectator[newCapacity];
+void SpectatorPriorityQueue::reserve(int count) {
+    if (count > capacity) {
+        resizeHeap(count);
+    }
+    handles.reserve(count);
+}
+
+void SpectatorPriorityQueue::resizeHeap(int newCapacity) {
+    newCapacity = clampCapacity(newCapacity);
+    Spectator* newNodes = new Spectator[newCapacity];
+    int* newHeap = new int[newCapacity];
+    int* newHandlePos = new int[newCapacity];
+    int* newFreeHandles = new int[newCapacity];
     
+    for (int i = 0; i < nextHandle; i++) {
+        newNodes[i] = nodes[i];
+        newHandlePos[i] = handlePos[i];
+    }
     for (int i = 0; i < size; i++) {
         newHeap[i] = heap[i];
     }
+    for (int i = 0; i < freeCount; i++) {
+        newFreeHandles[i] = freeHandles[i];
+    }
     
+    delete[] nodes;
     delete[] heap;
+    delete[] handlePos;
+    delete[] freeHandles;
+    nodes = newNodes;
     heap = newHeap;
+    handlePos = newHandlePos;
+    freeHandles = newFreeHandles;
     capacity = newCapacity;
 }
 
-void SpectatorPriorityQueue::displayQueue() const {
+void SpectatorPriorityQueue::displayQueue(ostream& os) const {
     if (isEmpty()) {
-        cout << "No spectators in waiting queue.\n";
+        os << "No spectators in waiting queue.\n";
         return;
     }
     
-    cout << "\n=== WAITING QUEUE ===\n";
-    cout << left << setw(15) << "Name" 
+    os << "\n=== WAITING QUEUE ===\n";
+    os << left << setw(15) << "Name" 
          << setw(25) << "Email" 
          << setw(12) << "Type"
          << setw(10) << "Priority"
          << setw(15) << "Seat Section"
          << setw(8) << "Seated" << endl;
-    cout << string(85, '-') << endl;
+    os << string(85, '-') << endl;
     
     for (int i = 0; i < size; i++) {
-        heap[i].displaySpectator();
+        nodes[heap[i]].displaySpectator(os);
     }
 }
 
-void SpectatorPriorityQueue::displayByPriority() const {
-    cout << "\n=== QUEUE BY PRIORITY ORDER ===\n";
+int SpectatorPriorityQueue::getTopK(int k, int result[]) const {
+    if (k > size) k = size;
+    if (k <= 0) return 0;
     
-    // Create temporary copy to show priority order without modifying original
-    SpectatorPriorityQueue tempQueue(*this);
+    // The next best entry is always the root or a child of an entry already
+    // emitted, so walk the heap with a small heap of candidate positions.
+    // Each step emits one entry and adds at most one net candidate, keeping
+    // the frontier under k + 1 entries and the walk at O(k log k).
+    if (frontierCapacity < k + 1) {
+        delete[] frontier;
+        frontierCapacity = k + 1;
+        frontier = new int[frontierCapacity];
+    }
+    
+    int frontierSize = 0;
+    frontier[frontierSize++] = 0;
+    
+    int count = 0;
+    while (count < k) {
+        int best = frontier[0];
+        result[count++] = heap[best];
+        
+        // Replace the root with the left child (or the last candidate)
+        int left = getLeftChildIndex(best);
+        int right = getRightChildIndex(best);
+        if (left < size) {
+            frontier[0] = left;
+        } else {
+            frontier[0] = frontier[--frontierSize];
+        }
+        
+        // Sift the new root down
+        int i = 0;
+        while (frontierSize > 0) {
+            int top = i;
+            int l = 2 * i + 1;
+            int r = 2 * i + 2;
+            if (l < frontierSize && higher(frontier[l], frontier[top])) top = l;
+            if (r < frontierSize && higher(frontier[r], frontier[top])) top = r;
+            if (top == i) break;
+            int temp = frontier[i];
+            frontier[i] = frontier[top];
+            frontier[top] = temp;
+            i = top;
+        }
+        
+        // Push the right child and sift it up
+        if (right < size) {
+            int j = frontierSize++;
+            frontier[j] = right;
+            while (j > 0 && higher(frontier[j], frontier[(j - 1) / 2])) {
+                int parent = (j - 1) / 2;
+                int temp = frontier[j];
+                frontier[j] = frontier[parent];
+                frontier[parent] = temp;
+                j = parent;
+            }
+        }
+    }
+    
+    return count;
+}
+
+void SpectatorPriorityQueue::displayByPriority(ostream& os, int limit) const {
+    if (isEmpty()) {
+        os << "No spectators in waiting queue.\n";
+        return;
+    }
     
-    int count = 1;
-    while (!tempQueue.isEmpty()) {
-        cout << count++ << ". ";
-        Spectator spec = tempQueue.extractMax();
-        spec.displaySpectator();
+    os << "\n=== QUEUE BY PRIORITY ORDER ===\n";
+    
+    int k = (limit < 0 || limit > size) ? size : limit;
+    int* order = new int[k];
+    int count = getTopK(k, order);
+    
+    for (int i = 0; i < count; i++) {
+        os << (i + 1) << ". ";
+        nodes[order[i]].displaySpectator(os);
     }
+    
+    delete[] order;
 }
 
 // ===== SPECTATOR MANAGER IMPLEMENTATION =====
 
-SpectatorManager::SpectatorManager(int vip, int influencer, int general) 
-    : totalSeats(vip + influencer + general), occupiedSeats(0),
-      vipSeats(vip), influencerSeats(influencer), generalSeats(general) {
+// Registrations moved from the intake queue per drain
+static const int INTAKE_BATCH_SIZE = 256;
+
+// Initial length of the change log; it doubles when full
+static const int CHANGE_LOG_CAPACITY = 16;
+
+// Spectator type owning each seat tier's capacity counter
+static const char* const tierTypes[TIER_COUNT] = { "VIP", "Influencer", "General" };
+
+// Seats in one tier: negative counts are empty, and the cap keeps the
+// venue total within SPECTATOR_CAPACITY_LIMIT
+static int clampTierSeats(int seats) {
+    if (seats < 0) return 0;
+    return seats < SPECTATOR_CAPACITY_LIMIT / TIER_COUNT ? seats : SPECTATOR_CAPACITY_LIMIT / TIER_COUNT;
+}
+
+SpectatorManager::SpectatorManager(int vip, int influencer, int general, ostream* output,
+                                   ChangeListener* listener) 
+    : occupiedSeats(0), snapshotRows(0), changeCount(0), changeCapacity(CHANGE_LOG_CAPACITY),
+      out(outputOrDiscard(output)), changes(listener) {
+    vip = clampTierSeats(vip);
+    influencer = clampTierSeats(influencer);
+    general = clampTierSeats(general);
+    int seats = vip + influencer + general;
+    totalSeats = seats;
+    vipSeats = vip;
+    influencerSeats = influencer;
+    generalSeats = general;
     
     waitingQueue = new SpectatorPriorityQueue();
-    seatedSpectators = new Spectator[totalSeats];
+    seatMap = new SeatMap(vip, influencer, general);
+    seatedSpectators = new Spectator[seats];
+    slotSeat = new int[seats];
+    
+    int seatIdLimit = seatMap->getSeatIdLimit();
+    seatSlot = new int[seatIdLimit];
+    for (int i = 0; i < seatIdLimit; i++) {
+        seatSlot[i] = -1;
+    }
+    
+    changeLog = new string[CHANGE_LOG_CAPACITY];
+    intake = new SpectatorIntakeQueue();
+    intakeBatch = new SpectatorIntakeRequest[INTAKE_BATCH_SIZE];
     
     // Initialize seat availability
     seatStatus.vipAvailable = vip;
@@ -202,23 +413,34 @@ SpectatorManager::SpectatorManager(int vip, int influencer, int general)
 
 SpectatorManager::~SpectatorManager() {
     delete waitingQueue;
+    delete seatMap;
     delete[] seatedSpectators;
+    delete[] seatSlot;
+    delete[] slotSeat;
+    delete[] changeLog;
+    delete intake;
+    delete[] intakeBatch;
 }
 
 void SpectatorManager::registerSpectator() {
     string name, email, type;
     
-    cout << "\n=== SPECTATOR REGISTRATION ===\n";
-    cout << "Enter name: ";
+    *out << "\n=== SPECTATOR REGISTRATION ===\n";
+    *out << "Enter name: ";
     cin.ignore();
     getline(cin, name);
     
-    cout << "Enter email: ";
+    *out << "Enter email: ";
     getline(cin, email);
     
-    cout << "Select spectator type:\n";
-    cout << "1. VIP\n2. Influencer\n3. General\n";
-    cout << "Enter choice (1-3): ";
+    if (isRegistered(email)) {
+        *out << "A spectator with email " << email << " is already registered.\n";
+        return;
+    }
+    
+    *out << "Select spectator type:\n";
+    *out << "1. VIP\n2. Influencer\n3. General\n";
+    *out << "Enter choice (1-3): ";
     
     int choice;
     cin >> choice;
@@ -228,7 +450,7 @@ void SpectatorManager::registerSpectator() {
         case 2: type = "Influencer"; break;
         case 3: type = "General"; break;
         default: 
-            cout << "Invalid choice. Defaulting to General.\n";
+            *out << "Invalid choice. Defaulting to General.\n";
             type = "General";
     }
     
@@ -237,21 +459,86 @@ void SpectatorManager::registerSpectator() {
     Spectator newSpectator(name, email, type, currentTime);
     
     // Add to waiting queue
-    waitingQueue->insert(newSpectator);
+    addSpectator(newSpectator);
+    
+    *out << "\nSpectator registered successfully!\n";
+    *out << "Name: " << name << "\n";
+    *out << "Type: " << type << "\n";
+    *out << "Position in queue: " << waitingQueue->getSize() << "\n";
+}
+
+bool SpectatorManager::addSpectator(const Spectator& spectator) {
+    if (isRegistered(spectator.getEmail())) {
+        return false;
+    }
     
-    cout << "\nSpectator registered successfully!\n";
-    cout << "Name: " << name << "\n";
-    cout << "Type: " << type << "\n";
-    cout << "Position in queue: " << waitingQueue->getSize() << "\n";
+    waitingQueue->insert(spectator);
+    nameIndex.add(spectator.getName(), spectator.getEmail());
+    markChanged(spectator.getEmail());
+    if (changes) changes->onChange(SPECTATOR_QUEUED, spectator.getEmail(), spectator.getSpectatorType());
+    return true;
 }
 
-void SpectatorManager::allocateSeating() {
+// Put a spectator back exactly where a saved image had them. Waiting
+// spectators supplied in heap order are appended without any sifting.
+bool SpectatorManager::restoreSpectator(const Spectator& spectator, int seatId) {
+    if (isRegistered(spectator.getEmail())) {
+        return false;
+    }
+    if (seatId != -1) {
+        if (!seatMap->reserveSeat(seatId)) {
+            return false;
+        }
+        Spectator seated = spectator;
+        nameIndex.add(seated.getName(), seated.getEmail());
+        seatSpectator(seated, seatId);
+        return true;
+    }
+    
+    waitingQueue->insert(spectator);
+    nameIndex.add(spectator.getName(), spectator.getEmail());
+    markChanged(spectator.getEmail());
+    if (changes) changes->onChange(SPECTATOR_QUEUED, spectator.getEmail(), spectator.getSpectatorType());
+    return true;
+}
+
+void SpectatorManager::reserveSpectators(int count) {
+    waitingQueue->reserve(count);
+    nameIndex.reserve(count);
+    seatedByEmail.reserve(totalSeats);
+    changedEmails.reserve(count);
+}
+
+int SpectatorManager::processIntake() {
+    int added = 0;
+    int count;
+    
+    // Only drain what was pending on entry so a busy intake cannot starve the caller
+    int budget = intake->getPending();
+    while (budget > 0 && (count = intake->drain(intakeBatch, INTAKE_BATCH_SIZE)) > 0) {
+        for (int i = 0; i < count; i++) {
+            Spectator spectator(intakeBatch[i].name, intakeBatch[i].email,
+                                intakeBatch[i].type, intakeBatch[i].arrivalTime);
+            if (addSpectator(spectator)) {
+                added++;
+            }
+        }
+        budget -= count;
+    }
+    
+    return added;
+}
+
+int SpectatorManager::allocateSeating() {
+    APUEC_TRACE_SCOPE("SpectatorManager::allocateSeating");
+    processIntake();
+    
     if (waitingQueue->isEmpty()) {
-        cout << "No spectators in waiting queue.\n";
-        return;
+        *out << "No spectators in waiting queue.\n";
+        return 0;
     }
     
-    cout << "\n=== SEAT ALLOCATION PROCESS ===\n";
+    *out << "\n=== SEAT ALLOCATION PROCESS ===\n";
     int allocated = 0;
     
     while (!waitingQueue->isEmpty()) {
@@ -261,33 +548,33 @@ void SpectatorManager::allocateSeating() {
             if (hasAvailableSeats(nextSpectator.getSpectatorType())) {
                 // Remove from queue and assign seat
                 nextSpectator = waitingQueue->extractMax();
-                string seatSection = assignSeatSection(nextSpectator.getSpectatorType());
-                nextSpectator.setSeatSection(seatSection);
-                nextSpectator.setIsSeated(true);
-                
-                // Add to seated spectators array
-                seatedSpectators[occupiedSeats] = nextSpectator;
-                occupiedSeats++;
+                if (changes) {
+                    changes->onChange(SPECTATOR_DEQUEUED, nextSpectator.getEmail(),
+                                      nextSpectator.getSpectatorType());
+                }
+                int seatId = assignSeat(nextSpectator.getSpectatorType());
+                seatSpectator(nextSpectator, seatId);
                 allocated++;
                 
-                cout << "✓ Allocated seat to: " << nextSpectator.getName() 
+                *out << "✓ Allocated seat to: " << nextSpectator.getName() 
                      << " (Type: " << nextSpectator.getSpectatorType() 
-                     << ", Section: " << seatSection << ")\n";
+                     << ", Section: " << nextSpectator.getSeatSection() << ")\n";
             } else {
-                cout << "✗ No available seats for " << nextSpectator.getSpectatorType() 
+                *out << "✗ No available seats for " << nextSpectator.getSpectatorType() 
                      << " spectator: " << nextSpectator.getName() << "\n";
                 break;
             }
         } catch (const exception& e) {
-            cout << "Error during allocation: " << e.what() << "\n";
+            *out << "Error during allocation: " << e.what() << "\n";
             break;
         }
     }
     
-    cout << "\nAllocation Summary:\n";
-    cout << "- Total allocated: " << allocated << " spectators\n";
-    cout << "- Remaining in queue: " << waitingQueue->getSize() << " spectators\n";
-    cout << "- Total seated: " << occupiedSeats << "/" << totalSeats << " seats\n";
+    *out << "\nAllocation Summary:\n";
+    *out << "- Total allocated: " << allocated << " spectators\n";
+    *out << "- Remaining in queue: " << waitingQueue->getSize() << " spectators\n";
+    *out << "- Total seated: " << occupiedSeats << "/" << totalSeats << " seats\n";
+    return allocated;
 }
 
 bool SpectatorManager::hasAvailableSeats(const string& spectatorType) {
@@ -300,66 +587,395 @@ bool SpectatorManager::hasAvailableSeats(const string& spectatorType) {
     }
 }
 
-string SpectatorManager::assignSeatSection(const string& spectatorType) {
-    if (spectatorType == "VIP" && seatStatus.vipAvailable > 0) {
-        seatStatus.vipAvailable--;
-        return "VIP-" + to_string(vipSeats - seatStatus.vipAvailable);
+bool SpectatorManager::allocateGroupSeating(Spectator group[], int groupSize) {
+    APUEC_TRACE_SCOPE("SpectatorManager::allocateGroupSeating");
+    if (groupSize <= 0) return false;
+    
+    // A repeated email would take two seats but leave one registration
+    EmailIndex groupEmails(groupSize);
+    for (int i = 0; i < groupSize; i++) {
+        if (isRegistered(group[i].getEmail())) return false;
+        if (groupEmails.contains(group[i].getEmail())) return false;
+        groupEmails.put(group[i].getEmail(), i);
+    }
+    
+    // The group is seated in the tier of its first member
+    string spectatorType = group[0].getSpectatorType();
+    int* seatIds = new int[groupSize];
+    
+    bool found = seatMap->allocateAdjacent(SeatMap::tierFromType(spectatorType), groupSize, seatIds);
+    if (!found && spectatorType == "Influencer") {
+        // Influencers may overflow into general admission
+        found = seatMap->allocateAdjacent(TIER_GENERAL, groupSize, seatIds);
+    }
+    
+    if (found) {
+        for (int i = 0; i < groupSize; i++) {
+            seatSpectator(group[i], seatIds[i]);
+            nameIndex.add(group[i].getName(), group[i].getEmail());
+        }
+    }
+    
+    delete[] seatIds;
+    return found;
+}
+
+int SpectatorManager::assignSeat(const string& spectatorType) {
+    int seatId = -1;
+    if (spectatorType == "VIP") {
+        seatId = seatMap->allocateSeat(TIER_VIP);
+    } else if (spectatorType == "Influencer") {
+        seatId = seatMap->allocateSeat(TIER_INFLUENCER);
+        if (seatId == -1) {
+            seatId = seatMap->allocateSeat(TIER_GENERAL);
+        }
+    } else {
+        seatId = seatMap->allocateSeat(TIER_GENERAL);
+    }
+    return seatId;
+}
+
+void SpectatorManager::updateSeatStatus(const string& spectatorType, bool occupy) {
+    int delta = occupy ? -1 : 1;
+    if (spectatorType == "VIP") {
+        seatStatus.vipAvailable += delta;
     } else if (spectatorType == "Influencer") {
-        if (seatStatus.influencerAvailable > 0) {
-            seatStatus.influencerAvailable--;
-            return "INF-" + to_string(influencerSeats - seatStatus.influencerAvailable);
-        } else if (seatStatus.generalAvailable > 0) {
-            seatStatus.generalAvailable--;
-            return "GEN-" + to_string(generalSeats - seatStatus.generalAvailable);
+        seatStatus.influencerAvailable += delta;
+    } else {
+        seatStatus.generalAvailable += delta;
+    }
+}
+
+void SpectatorManager::seatSpectator(Spectator& spectator, int seatId) {
+    spectator.setSeatSection(seatMap->getSeatLabel(seatId));
+    spectator.setIsSeated(true);
+    
+    // Capacity is counted against the tier of the seat, not the spectator
+    updateSeatStatus(tierTypes[seatMap->getTier(seatId)], true);
+    
+    seatedSpectators[occupiedSeats] = spectator;
+    slotSeat[occupiedSeats] = seatId;
+    seatSlot[seatId] = occupiedSeats;
+    seatedByEmail.put(spectator.getEmail(), seatId);
+    markChanged(spectator.getEmail());
+    occupiedSeats++;
+    if (changes) changes->onChange(SPECTATOR_SEATED, spectator.getEmail(), tierTypes[seatMap->getTier(seatId)]);
+}
+
+void SpectatorManager::releaseSeat(int seatId) {
+    int slot = seatSlot[seatId];
+    if (slot == -1) return;
+    
+    // Move the last seated spectator into the freed slot
+    seatedByEmail.erase(seatedSpectators[slot].getEmail());
+    markChanged(seatedSpectators[slot].getEmail());
+    if (changes) {
+        changes->onChange(SPECTATOR_UNSEATED, seatedSpectators[slot].getEmail(),
+                          tierTypes[seatMap->getTier(seatId)]);
+    }
+    
+    int last = occupiedSeats - 1;
+    if (slot != last) {
+        seatedSpectators[slot] = seatedSpectators[last];
+        slotSeat[slot] = slotSeat[last];
+        seatSlot[slotSeat[slot]] = slot;
+    }
+    seatSlot[seatId] = -1;
+    occupiedSeats--;
+    
+    seatMap->releaseSeat(seatId);
+    updateSeatStatus(tierTypes[seatMap->getTier(seatId)], false);
+}
+
+bool SpectatorManager::isRegistered(const string& email) const {
+    return seatedByEmail.contains(email) || waitingQueue->findHandle(email) != -1;
+}
+
+bool SpectatorManager::removeSpectatorByEmail(const string& email) {
+    int seatId;
+    if (seatedByEmail.find(email, seatId)) {
+        nameIndex.remove(email);
+        releaseSeat(seatId);
+        return true;
+    }
+    
+    int handle = waitingQueue->findHandle(email);
+    if (handle != -1) {
+        Spectator removed = waitingQueue->erase(handle);
+        nameIndex.remove(email);
+        markChanged(email);
+        if (changes) changes->onChange(SPECTATOR_DEQUEUED, email, removed.getSpectatorType());
+        return true;
+    }
+    
+    return false;
+}
+
+bool SpectatorManager::findSpectatorByEmail(const string& email, Spectator& result) const {
+    int seatId;
+    if (seatedByEmail.find(email, seatId)) {
+        result = seatedSpectators[seatSlot[seatId]];
+        return true;
+    }
+    
+    int handle = waitingQueue->findHandle(email);
+    if (handle != -1) {
+        result = waitingQueue->get(handle);
+        return true;
+    }
+    
+    return false;
+}
+
+int SpectatorManager::findSpectatorsByName(const string& prefix, Spectator results[], int maxResults) const {
+    if (maxResults <= 0) return 0;
+    
+    string* emails = new string[maxResults];
+    int matches = nameIndex.search(prefix, emails, maxResults);
+    
+    int found = 0;
+    for (int i = 0; i < matches; i++) {
+        if (findSpectatorByEmail(emails[i], results[found])) {
+            found++;
+        }
+    }
+    
+    delete[] emails;
+    return found;
+}
+
+bool SpectatorManager::changeSpectatorType(const string& email, const string& newType) {
+    int handle = waitingQueue->findHandle(email);
+    if (handle == -1) {
+        return false;
+    }
+    string oldType = waitingQueue->get(handle).getSpectatorType();
+    waitingQueue->updatePriority(handle, newType);
+    markChanged(email);
+    if (changes) {
+        // A retype is a move between tiers of the waiting queue
+        changes->onChange(SPECTATOR_DEQUEUED, email, oldType);
+        changes->onChange(SPECTATOR_QUEUED, email, waitingQueue->get(handle).getSpectatorType());
+    }
+    return true;
+}
+
+void SpectatorManager::upgradeSpectator() {
+    string email, type;
+    
+    *out << "\n=== UPGRADE TICKET ===\n";
+    *out << "Enter email of waiting spectator: ";
+    cin.ignore();
+    getline(cin, email);
+    
+    int handle = waitingQueue->findHandle(email);
+    if (handle == -1) {
+        if (seatedByEmail.contains(email)) {
+            *out << "Spectator is already seated; only waiting spectators can change tickets.\n";
+        } else {
+            *out << "No waiting spectator found with email " << email << ".\n";
         }
-    } else if (spectatorType == "General" && seatStatus.generalAvailable > 0) {
-        seatStatus.generalAvailable--;
-        return "GEN-" + to_string(generalSeats - seatStatus.generalAvailable);
+        return;
+    }
+    
+    *out << "Current type: " << waitingQueue->get(handle).getSpectatorType() << "\n";
+    *out << "Select new spectator type:\n";
+    *out << "1. VIP\n2. Influencer\n3. General\n";
+    *out << "Enter choice (1-3): ";
+    
+    int choice;
+    cin >> choice;
+    
+    switch (choice) {
+        case 1: type = "VIP"; break;
+        case 2: type = "Influencer"; break;
+        case 3: type = "General"; break;
+        default:
+            *out << "Invalid choice. Ticket unchanged.\n";
+            return;
+    }
+    
+    changeSpectatorType(email, type);
+    *out << "Ticket for " << waitingQueue->get(handle).getName() << " changed to " << type << ".\n";
+}
+
+void SpectatorManager::removeSpectator() {
+    string email;
+    
+    *out << "\n=== REMOVE SPECTATOR ===\n";
+    *out << "Enter email of spectator to remove: ";
+    cin.ignore();
+    getline(cin, email);
+    
+    Spectator spectator;
+    if (!findSpectatorByEmail(email, spectator)) {
+        *out << "No spectator found with email " << email << ".\n";
+        return;
+    }
+    
+    removeSpectatorByEmail(email);
+    
+    *out << "\nSpectator removed successfully!\n";
+    *out << "Name: " << spectator.getName() << "\n";
+    if (spectator.getIsSeated()) {
+        *out << "Released seat: " << spectator.getSeatSection() << "\n";
+    } else {
+        *out << "Removed from waiting queue.\n";
     }
-    return "ERROR";
+}
+
+void SpectatorManager::searchSpectator() {
+    const int MAX_RESULTS = 50;
+    
+    *out << "\n=== SEARCH SPECTATOR ===\n";
+    *out << "1. Search by Email\n2. Search by Name\n";
+    *out << "Enter choice (1-2): ";
+    
+    int choice;
+    cin >> choice;
+    cin.ignore();
+    
+    Spectator results[MAX_RESULTS];
+    int found = 0;
+    
+    if (choice == 1) {
+        string email;
+        *out << "Enter email: ";
+        getline(cin, email);
+        if (findSpectatorByEmail(email, results[0])) {
+            found = 1;
+        }
+    } else if (choice == 2) {
+        string prefix;
+        *out << "Enter name (or the beginning of it): ";
+        getline(cin, prefix);
+        found = findSpectatorsByName(prefix, results, MAX_RESULTS);
+    } else {
+        *out << "Invalid choice!\n";
+        return;
+    }
+    
+    if (found == 0) {
+        *out << "No matching spectators found.\n";
+        return;
+    }
+    
+    *out << left << setw(15) << "Name" 
+         << setw(25) << "Email" 
+         << setw(12) << "Type"
+         << setw(10) << "Priority"
+         << setw(15) << "Seat Section"
+         << setw(8) << "Seated" << endl;
+    *out << string(85, '-') << endl;
+    for (int i = 0; i < found; i++) {
+        results[i].displaySpectator(*out);
+    }
+    *out << "\n" << found << " spectator(s) found.\n";
 }
 
 void SpectatorManager::displayWaitingQueue() {
-    cout << "\n=== CURRENT WAITING QUEUE ===\n";
-    waitingQueue->displayQueue();
-    cout << "\nQueue size: " << waitingQueue->getSize() << " spectators\n";
+    processIntake();
+    *out << "\n=== CURRENT WAITING QUEUE ===\n";
+    waitingQueue->displayByPriority(*out);
+    *out << "\nQueue size: " << waitingQueue->getSize() << " spectators\n";
+}
+
+int SpectatorManager::getTopWaiting(int k, Spectator results[]) const {
+    if (k <= 0) return 0;
+    
+    int* order = new int[k];
+    int count = waitingQueue->getTopK(k, order);
+    for (int i = 0; i < count; i++) {
+        results[i] = waitingQueue->get(order[i]);
+    }
+    
+    delete[] order;
+    return count;
 }
 
 void SpectatorManager::displaySeatedSpectators() {
     if (occupiedSeats == 0) {
-        cout << "No spectators currently seated.\n";
+        *out << "No spectators currently seated.\n";
         return;
     }
     
-    cout << "\n=== SEATED SPECTATORS ===\n";
-    cout << left << setw(15) << "Name" 
+    *out << "\n=== SEATED SPECTATORS ===\n";
+    *out << left << setw(15) << "Name" 
          << setw(25) << "Email" 
          << setw(12) << "Type"
          << setw(15) << "Seat Section" << endl;
-    cout << string(67, '-') << endl;
+    *out << string(67, '-') << endl;
     
     for (int i = 0; i < occupiedSeats; i++) {
-        seatedSpectators[i].displaySpectator();
+        seatedSpectators[i].displaySpectator(*out);
     }
-    cout << "\nTotal seated: " << occupiedSeats << " spectators\n";
+    *out << "\nTotal seated: " << occupiedSeats << " spectators\n";
 }
 
 void SpectatorManager::displayVenueStatus() {
-    cout << "\n=== VENUE STATUS ===\n";
-    cout << "VIP Seats: " << (vipSeats - seatStatus.vipAvailable) << "/" << vipSeats 
+    *out << "\n=== VENUE STATUS ===\n";
+    *out << "VIP Seats: " << (vipSeats - seatStatus.vipAvailable) << "/" << vipSeats 
          << " occupied (" << seatStatus.vipAvailable << " available)\n";
-    cout << "Influencer Seats: " << (influencerSeats - seatStatus.influencerAvailable) << "/" << influencerSeats 
+    *out << "Influencer Seats: " << (influencerSeats - seatStatus.influencerAvailable) << "/" << influencerSeats 
          << " occupied (" << seatStatus.influencerAvailable << " available)\n";
-    cout << "General Seats: " << (generalSeats - seatStatus.generalAvailable) << "/" << generalSeats 
+    *out << "General Seats: " << (generalSeats - seatStatus.generalAvailable) << "/" << generalSeats 
          << " occupied (" << seatStatus.generalAvailable << " available)\n";
-    cout << string(50, '-') << endl;
-    cout << "TOTAL: " << occupiedSeats << "/" << totalSeats 
+    *out << string(50, '-') << endl;
+    *out << "TOTAL: " << occupiedSeats << "/" << totalSeats 
          << " occupied (" << (totalSeats - occupiedSeats) << " available)\n";
-    cout << "Queue Length: " << waitingQueue->getSize() << " waiting\n";
+    *out << "Queue Length: " << waitingQueue->getSize() << " waiting\n";
+}
+
+VenueStatus SpectatorManager::getVenueStatus() const {
+    VenueStatus status;
+    status.totalSeats = totalSeats;
+    status.occupiedSeats = occupiedSeats;
+    status.waiting = waitingQueue->getSize();
+    status.vipAvailable = seatStatus.vipAvailable;
+    status.influencerAvailable = seatStatus.influencerAvailable;
+    status.generalAvailable = seatStatus.generalAvailable;
+    return status;
+}
+
+void SpectatorManager::countByTier(int waitingByType[3], int seatedByTier[3]) const {
+    for (int i = 0; i < 3; i++) {
+        waitingByType[i] = 0;
+    }
+    for (int i = 0; i < waitingQueue->getSize(); i++) {
+        waitingByType[waitingQueue->getAt(i).getPriority() - 1]++;
+    }
+    
+    seatedByTier[0] = vipSeats - seatStatus.vipAvailable;
+    seatedByTier[1] = influencerSeats - seatStatus.influencerAvailable;
+    seatedByTier[2] = generalSeats - seatStatus.generalAvailable;
+}
+
+void SpectatorManager::copySpectators(vector<Spectator>& spectators, vector<int>* seatIds) const {
+    spectators.clear();
+    spectators.reserve(occupiedSeats + waitingQueue->getSize());
+    for (int i = 0; i < occupiedSeats; i++) {
+        spectators.push_back(seatedSpectators[i]);
+    }
+    for (int i = 0; i < waitingQueue->getSize(); i++) {
+        spectators.push_back(waitingQueue->getAt(i));
+    }
+    
+    if (seatIds) {
+        seatIds->assign(spectators.size(), -1);
+        for (int i = 0; i < occupiedSeats; i++) {
+            (*seatIds)[i] = slotSeat[i];
+        }
+    }
+}
+
+void SpectatorManager::getSeatCapacity(int seatsByTier[3]) const {
+    seatsByTier[0] = vipSeats;
+    seatsByTier[1] = influencerSeats;
+    seatsByTier[2] = generalSeats;
 }
 
 void SpectatorManager::displayStatistics() {
-    cout << "\n=== SYSTEM STATISTICS ===\n";
+    *out << "\n=== SYSTEM STATISTICS ===\n";
     
     // Count by type in seated spectators
     int vipSeated = 0, influencerSeated = 0, generalSeated = 0;
@@ -376,48 +992,152 @@ void SpectatorManager::displayStatistics() {
     double generalUtilization = (double)(generalSeats - seatStatus.generalAvailable) / generalSeats * 100;
     double overallUtilization = (double)occupiedSeats / totalSeats * 100;
     
-    cout << fixed << setprecision(1);
-    cout << "Seat Utilization:\n";
-    cout << "- VIP: " << vipUtilization << "% (" << vipSeated << " seated)\n";
-    cout << "- Influencer: " << influencerUtilization << "% (" << influencerSeated << " seated)\n";
-    cout << "- General: " << generalUtilization << "% (" << generalSeated << " seated)\n";
-    cout << "- Overall: " << overallUtilization << "% (" << occupiedSeats << "/" << totalSeats << ")\n";
-    cout << "\nQueue Status:\n";
-    cout << "- Waiting spectators: " << waitingQueue->getSize() << "\n";
-    cout << "- Queue capacity utilization: " << (waitingQueue->getSize() > 0 ? "Active" : "Empty") << "\n";
+    *out << fixed << setprecision(1);
+    *out << "Seat Utilization:\n";
+    *out << "- VIP: " << vipUtilization << "% (" << vipSeated << " seated)\n";
+    *out << "- Influencer: " << influencerUtilization << "% (" << influencerSeated << " seated)\n";
+    *out << "- General: " << generalUtilization << "% (" << generalSeated << " seated)\n";
+    *out << "- Overall: " << overallUtilization << "% (" << occupiedSeats << "/" << totalSeats << ")\n";
+    *out << "\nQueue Status:\n";
+    *out << "- Waiting spectators: " << waitingQueue->getSize() << "\n";
+    *out << "- Queue capacity utilization: " << (waitingQueue->getSize() > 0 ? "Active" : "Empty") << "\n";
 }
 
-void SpectatorManager::saveToFile(const string& filename) {
-    ofstream file(filename);
-    if (!file.is_open()) {
-        cout << "Error: Unable to create file " << filename << endl;
-        return;
+void SpectatorManager::markChanged(const string& email) {
+    if (changedEmails.contains(email)) return;
+    
+    if (changeCount >= changeCapacity) {
+        int newCapacity = grownCapacity(changeCapacity);
+        string* newLog = new string[newCapacity];
+        for (int i = 0; i < changeCount; i++) {
+            newLog[i].swap(changeLog[i]);
+        }
+        delete[] changeLog;
+        changeLog = newLog;
+        changeCapacity = newCapacity;
+    }
+    
+    changeLog[changeCount++] = email;
+    changedEmails.put(email, 1);
+}
+
+void SpectatorManager::clearChanges() {
+    for (int i = 0; i < changeCount; i++) {
+        changeLog[i].clear();
+    }
+    changeCount = 0;
+    changedEmails.clear();
+}
+
+bool SpectatorManager::writeSnapshot(const string& filename) {
+    APUEC_TRACE_SCOPE("SpectatorManager::writeSnapshot");
+    SpectatorCsvWriter writer;
+    if (!writer.open(filename, false)) {
+        return false;
     }
     
-    // Write header
-    file << "Name,Email,Type,ArrivalTime,SeatSection,IsSeated\n";
+    writer.writeHeader();
     
-    // Write seated spectators
+    // Seated spectators first, then the waiting queue in heap order
     for (int i = 0; i < occupiedSeats; i++) {
-        file << seatedSpectators[i].toString() << "\n";
+        writer.writeSpectator(seatedSpectators[i]);
+    }
+    for (int i = 0; i < waitingQueue->getSize(); i++) {
+        writer.writeSpectator(waitingQueue->getAt(i));
     }
     
-    file.close();
-    cout << "Data saved to " << filename << " successfully!\n";
+    int rows = writer.getRowsWritten();
+    if (!writer.close()) {
+        return false;
+    }
+    
+    snapshotFile = filename;
+    snapshotRows = rows;
+    clearChanges();
+    return true;
+}
+
+bool SpectatorManager::appendChanges(const string& filename) {
+    APUEC_TRACE_SCOPE("SpectatorManager::appendChanges");
+    if (filename != snapshotFile) {
+        // Changes are relative to the last snapshot of this file only
+        return writeSnapshot(filename);
+    }
+    if (changeCount == 0) {
+        return true;
+    }
+    
+    SpectatorCsvWriter writer;
+    if (!writer.open(filename, true)) {
+        return false;
+    }
+    
+    // Later rows override earlier rows with the same email when loading
+    Spectator spectator;
+    for (int i = 0; i < changeCount; i++) {
+        if (findSpectatorByEmail(changeLog[i], spectator)) {
+            writer.writeSpectator(spectator);
+        } else {
+            writer.writeRemoval(changeLog[i]);
+        }
+    }
+    
+    int rows = writer.getRowsWritten();
+    if (!writer.close()) {
+        return false;
+    }
+    
+    snapshotRows += rows;
+    clearChanges();
+    return true;
+}
+
+bool SpectatorManager::saveToFile(const string& filename) {
+    processIntake();
+    
+    // Append only the changes while the file has not grown to more than
+    // twice the live data; otherwise rewrite it to drop superseded rows
+    int liveRows = occupiedSeats + waitingQueue->getSize();
+    bool incremental = (filename == snapshotFile) &&
+                       (snapshotRows + changeCount <= 2 * liveRows + 64);
+    
+    int changes = changeCount;
+    bool saved = incremental ? appendChanges(filename) : writeSnapshot(filename);
+    if (!saved) {
+        *out << "Error: Unable to write file " << filename << endl;
+        return false;
+    }
+    
+    if (incremental) {
+        *out << "Saved " << changes << " changed spectator(s) to " << filename << " successfully!\n";
+    } else {
+        *out << "Data saved to " << filename << " successfully!\n";
+    }
+    return true;
 }
 
-void SpectatorManager::loadFromFile(const string& filename) {
+bool SpectatorManager::loadFromFile(const string& filename) {
+    APUEC_TRACE_SCOPE("SpectatorManager::loadFromFile");
     ifstream file(filename);
     if (!file.is_open()) {
-        cout << "Error: Unable to open file " << filename << endl;
-        return;
+        *out << "Error: Unable to open file " << filename << endl;
+        return false;
     }
     
+    bool wasEmpty = (occupiedSeats == 0 && waitingQueue->isEmpty());
+    
     string line;
     // Skip header
     getline(file, line);
     
-    int loadedCount = 0;
+    // Appended rows are ordered by each email's first change, so a seat
+    // may be listed for its new holder before the row that frees it.
+    // Only the last row of each email counts: read them all, then apply
+    // removals and queued rows before placing anyone in a saved seat.
+    vector<Spectator> rows;
+    vector<string> rowSeats;
+    vector<char> rowStates;     // 'D' removed, '1' seated, '0' waiting
+    EmailIndex lastRow;
     while (getline(file, line)) {
         stringstream ss(line);
         string name, email, type, arrivalTimeStr, seatSection, isSeatedStr;
@@ -431,68 +1151,116 @@ void SpectatorManager::loadFromFile(const string& filename) {
         getline(ss, isSeatedStr, ',');
         
         // Convert string to int
-        int arrivalTime = stoi(arrivalTimeStr);
-        bool isSeated = (isSeatedStr == "1");
+        int arrivalTime = arrivalTimeStr.empty() ? 0 : stoi(arrivalTimeStr);
+        char state = '0';
+        if (isSeatedStr == "D") {
+            state = 'D';
+        } else if (isSeatedStr == "1" && !seatSection.empty()) {
+            state = '1';
+        }
         
-        // Create spectator object
-        Spectator spectator(name, email, type, arrivalTime);
+        lastRow.put(email, (int)rows.size());
+        rows.push_back(Spectator(name, email, type, arrivalTime));
+        rowSeats.push_back(seatSection);
+        rowStates.push_back(state);
+    }
+    int rowCount = (int)rows.size();
+    
+    // Pass 1: later rows replace earlier registrations, free their seats
+    // and queue the spectators saved as waiting
+    int loadedCount = 0;
+    for (int i = 0; i < rowCount; i++) {
+        const string& email = rows[i].getEmail();
+        int last;
+        if (!lastRow.find(email, last) || last != i) {
+            continue;
+        }
+        if (isRegistered(email)) {
+            removeSpectatorByEmail(email);
+            loadedCount--;
+        }
+        if (rowStates[i] != '0') {
+            continue;
+        }
         
-        if (isSeated && !seatSection.empty()) {
-            // Add to seated spectators
-            spectator.setSeatSection(seatSection);
-            spectator.setIsSeated(true);
-            
-            // Check if we have space
-            if (occupiedSeats < totalSeats) {
-                seatedSpectators[occupiedSeats] = spectator;
-                occupiedSeats++;
-                
-                // Update seat availability
-                if (type == "VIP") {
-                    seatStatus.vipAvailable--;
-                } else if (type == "Influencer") {
-                    seatStatus.influencerAvailable--;
-                } else {
-                    seatStatus.generalAvailable--;
-                }
-            }
+        Spectator& spectator = rows[i];
+        nameIndex.add(spectator.getName(), email);
+        markChanged(email);
+        waitingQueue->insert(spectator);
+        if (changes) changes->onChange(SPECTATOR_QUEUED, email, spectator.getSpectatorType());
+        loadedCount++;
+    }
+    
+    // Pass 2: seat the spectators saved as seated
+    for (int i = 0; i < rowCount; i++) {
+        const string& email = rows[i].getEmail();
+        int last;
+        if (rowStates[i] != '1' || !lastRow.find(email, last) || last != i) {
+            continue;
+        }
+        
+        Spectator& spectator = rows[i];
+        nameIndex.add(spectator.getName(), email);
+        markChanged(email);
+        
+        // Keep the saved seat if it is still free, otherwise reseat by tier
+        int seatId = seatMap->findSeatByLabel(rowSeats[i]);
+        if (seatId == -1 || !seatMap->reserveSeat(seatId)) {
+            seatId = assignSeat(spectator.getSpectatorType());
+        }
+        
+        if (seatId != -1) {
+            seatSpectator(spectator, seatId);
         } else {
-            // Add to waiting queue
+            spectator.setSeatSection("");
+            spectator.setIsSeated(false);
             waitingQueue->insert(spectator);
+            if (changes) changes->onChange(SPECTATOR_QUEUED, email, spectator.getSpectatorType());
         }
-        
         loadedCount++;
     }
     
     file.close();
-    cout << "Loaded " << loadedCount << " spectators from " << filename << endl;
-    cout << "- Seated: " << occupiedSeats << endl;
-    cout << "- In queue: " << waitingQueue->getSize() << endl;
+    
+    // A load into an empty manager mirrors the file exactly
+    if (wasEmpty) {
+        snapshotFile = filename;
+        snapshotRows = rowCount;
+        clearChanges();
+    }
+    
+    *out << "Loaded " << loadedCount << " spectators from " << filename << endl;
+    *out << "- Seated: " << occupiedSeats << endl;
+    *out << "- In queue: " << waitingQueue->getSize() << endl;
+    return true;
 }
 
 void SpectatorManager::displayMenu() {
-    cout << "\n" << string(50, '=') << "\n";
-    cout << "   APUEC SPECTATOR MANAGEMENT SYSTEM\n";
-    cout << string(50, '=') << "\n";
-    cout << "1. Register New Spectator\n";
-    cout << "2. Allocate Seating (Process Queue)\n";
-    cout << "3. Display Waiting Queue\n";
-    cout << "4. Display Seated Spectators\n";
-    cout << "5. Display Venue Status\n";
-    cout << "6. Display System Statistics\n";
-    cout << "7. Save Data to File\n";
-    cout << "8. Load Data from File\n";
-    cout << "9. Exit System\n";
-    cout << string(50, '-') << "\n";
-    cout << "Enter your choice (1-9): ";
+    *out << "\n" << string(50, '=') << "\n";
+    *out << "   APUEC SPECTATOR MANAGEMENT SYSTEM\n";
+    *out << string(50, '=') << "\n";
+    *out << "1. Register New Spectator\n";
+    *out << "2. Allocate Seating (Process Queue)\n";
+    *out << "3. Display Waiting Queue\n";
+    *out << "4. Display Seated Spectators\n";
+    *out << "5. Display Venue Status\n";
+    *out << "6. Display System Statistics\n";
+    *out << "7. Save Data to File\n";
+    *out << "8. Load Data from File\n";
+    *out << "9. Remove Spectator\n";
+    *out << "10. Search Spectator\n";
+    *out << "11. Upgrade Ticket\n";
+    *out << "12. Exit System\n";
+    *out << string(50, '-') << "\n";
+    *out << "Enter your choice (1-12): ";
 }
 
 void SpectatorManager::runSystem() {
     int choice;
     string filename;
     
-    cout << "Welcome to APUEC Spectator Management System!\n";
-    cout << "Venue Capacity: " << totalSeats << " seats (VIP: " << vipSeats 
+    *out << "Welcome to APUEC Spectator Management System!\n";
+    *out << "Venue Capacity: " << totalSeats << " seats (VIP: " << vipSeats 
          << ", Influencer: " << influencerSeats << ", General: " << generalSeats << ")\n";
     
     do {
@@ -519,27 +1287,36 @@ void SpectatorManager::runSystem() {
                 displayStatistics();
                 break;
             case 7:
-                cout << "Enter filename to save (e.g., spectators.csv): ";
+                *out << "Enter filename to save (e.g., spectators.csv): ";
                 cin >> filename;
                 saveToFile(filename);
                 break;
             case 8:
-                cout << "Enter filename to load (e.g., spectators.csv): ";
+                *out << "Enter filename to load (e.g., spectators.csv): ";
                 cin >> filename;
                 loadFromFile(filename);
                 break;
             case 9:
-                cout << "Thank you for using APUEC Spectator Management System!\n";
+                removeSpectator();
+                break;
+            case 10:
+                searchSpectator();
+                break;
+            case 11:
+                upgradeSpectator();
+                break;
+            case 12:
+                *out << "Thank you for using APUEC Spectator Management System!\n";
                 break;
             default:
-                cout << "Invalid choice! Please enter 1-9.\n";
+                *out << "Invalid choice! Please enter 1-12.\n";
         }
         
-        if (choice != 9) {
-            cout << "\nPress Enter to continue...";
+        if (choice != 12) {
+            *out << "\nPress Enter to continue...";
             cin.ignore();
             cin.get();
         }
         
-    } while (choice != 9);
+    } while (choice != 12);
 }
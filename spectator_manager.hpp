@@ -5,6 +5,12 @@
 #include <string>
 #include <fstream>
 #include <iomanip>
+#include <vector>
+#include "seat_map.hpp"
+#include "spectator_index.hpp"
+#include "spectator_intake.hpp"
+#include "apuec_output.hpp"
+#include "apuec_events.hpp"
 using namespace std;
 
 // Spectator class to represent each viewer
@@ -24,12 +30,12 @@ public:
     Spectator(string n, string e, string type, int arrival);
     
     // Getters
-    string getName() const { return name; }
-    string getEmail() const { return email; }
-    string getSpectatorType() const { return spectatorType; }
+    const string& getName() const { return name; }
+    const string& getEmail() const { return email; }
+    const string& getSpectatorType() const { return spectatorType; }
     int getPriority() const { return priority; }
     int getArrivalTime() const { return arrivalTime; }
-    string getSeatSection() const { return seatSection; }
+    const string& getSeatSection() const { return seatSection; }
     bool getIsSeated() const { return isSeated; }
     
     // Setters
@@ -40,7 +46,7 @@ public:
     void setIsSeated(bool seated) { isSeated = seated; }
     
     // Utility functions
-    void displaySpectator() const;
+    void displaySpectator(ostream& os = cout) const;
     string toString() const;
     
     // Comparison operators for priority queue
@@ -48,21 +54,39 @@ public:
     bool operator>(const Spectator& other) const;
 };
 
-// Priority Queue implementation using Max Heap
+// Indexed Priority Queue implementation using Max Heap
+// Spectators are stored in stable slots addressed by handles; the heap
+// only orders handles. insert() returns the handle, which stays valid
+// until the spectator leaves the queue, so priority changes and
+// cancellations run in O(log n) without searching the heap.
 class SpectatorPriorityQueue {
 private:
-    Spectator* heap;        // Dynamic array to store spectators
+    Spectator* nodes;       // Spectator storage indexed by handle
+    int* heap;              // Max heap of handles
+    int* handlePos;         // Handle -> index in heap (-1 = free handle)
+    int* freeHandles;       // Stack of released handles
+    int freeCount;
+    int nextHandle;         // Handles below this have been issued
     int capacity;           // Maximum capacity of heap
     int size;               // Current number of elements
+    EmailIndex handles;     // Email -> handle
+    mutable int* frontier;          // Reusable index heap for ordered walks
+    mutable int frontierCapacity;
     
     // Helper functions for heap operations
     int getParentIndex(int index) const { return (index - 1) / 2; }
     int getLeftChildIndex(int index) const { return 2 * index + 1; }
     int getRightChildIndex(int index) const { return 2 * index + 2; }
+    bool higher(int a, int b) const { return nodes[heap[a]] > nodes[heap[b]]; }
     
     void heapifyUp(int index);      // Maintain heap property upward
     void heapifyDown(int index);    // Maintain heap property downward
-    void resizeHeap();              // Resize heap when capacity exceeded
+    void swapNodes(int a, int b);   // Swap two heap slots and their positions
+    void resizeHeap(int newCapacity);   // Grow storage when capacity exceeded
+    
+    // Disable copying (owns raw arrays)
+    SpectatorPriorityQueue(const SpectatorPriorityQueue&);
+    SpectatorPriorityQueue& operator=(const SpectatorPriorityQueue&);
 
 public:
     // Constructor and Destructor
@@ -70,9 +94,25 @@ public:
     ~SpectatorPriorityQueue();
     
     // Core queue operations
-    void insert(const Spectator& spectator);    // Add spectator to queue
+    int insert(const Spectator& spectator);     // Add spectator to queue, returns handle
+    void reserve(int count);                    // Room for count spectators without regrowing
     Spectator extractMax();                     // Remove highest priority spectator
     Spectator peek() const;                     // View highest priority without removing
+    Spectator removeAt(int index);              // Remove spectator at heap index in O(log n)
+    
+    // Handle-based operations
+    bool contains(int handle) const;
+    const Spectator& get(int handle) const { return nodes[handle]; }
+    void updatePriority(int handle, const string& newType);  // Change ticket type in O(log n)
+    Spectator erase(int handle);                              // Remove spectator in O(log n)
+    
+    // Lookup
+    int findHandle(const string& email) const;  // Handle of spectator, -1 if absent
+    int findIndex(const string& email) const;   // Heap index of spectator, -1 if absent
+    const Spectator& getAt(int index) const { return nodes[heap[index]]; }
+    
+    // Ordered iteration without modifying or copying the heap
+    int getTopK(int k, int result[]) const;     // Handles of the k best spectators, best first
     
     // Utility functions
     bool isEmpty() const { return size == 0; }
@@ -80,15 +120,30 @@ public:
     int getCapacity() const { return capacity; }
     
     // Display functions
-    void displayQueue() const;
-    void displayByPriority() const;
+    void displayQueue(ostream& os = cout) const;
+    void displayByPriority(ostream& os = cout, int limit = -1) const;   // Top `limit` spectators (-1 = all)
+};
+
+// Seat and queue counters reported by SpectatorManager::getVenueStatus()
+struct VenueStatus {
+    int totalSeats;
+    int occupiedSeats;
+    int waiting;
+    int vipAvailable;
+    int influencerAvailable;
+    int generalAvailable;
 };
 
 // Main Spectator Management System
 class SpectatorManager {
 private:
     SpectatorPriorityQueue* waitingQueue;    // Queue for spectators waiting for seats
-    Spectator* seatedSpectators;             // Array of seated spectators
+    SeatMap* seatMap;                        // Venue sections, rows and seats
+    Spectator* seatedSpectators;             // Dense array of seated spectators
+    int* seatSlot;                           // Seat id -> index in seatedSpectators (-1 = empty)
+    int* slotSeat;                           // Index in seatedSpectators -> seat id
+    EmailIndex seatedByEmail;                // Email -> seat id of seated spectators
+    NamePrefixIndex nameIndex;               // Name prefix -> emails of all spectators
     int totalSeats;                          // Total venue capacity
     int occupiedSeats;                       // Currently occupied seats
     int vipSeats;                           // Reserved VIP seats
@@ -101,35 +156,87 @@ private:
         int influencerAvailable;
         int generalAvailable;
     } seatStatus;
+    
+    // Incremental snapshot state
+    string snapshotFile;                     // File written by the last full snapshot
+    int snapshotRows;                        // Data rows currently in snapshotFile
+    string* changeLog;                       // Emails changed since the last save
+    int changeCount;
+    int changeCapacity;
+    EmailIndex changedEmails;                // Emails already in changeLog
+    
+    // Concurrent registration intake
+    SpectatorIntakeQueue* intake;            // Filled by any thread, drained by the owner
+    SpectatorIntakeRequest* intakeBatch;     // Reusable drain buffer
+    
+    ostream* out;                            // Progress messages (never null)
+    ChangeListener* changes;                 // Queue and seat deltas (may be null)
+
+    void markChanged(const string& email);
+    void clearChanges();
+    void seatSpectator(Spectator& spectator, int seatId);   // Place spectator in a taken seat
+    void releaseSeat(int seatId);                           // Free a seat and its slot
 
 public:
     // Constructor and Destructor
-    SpectatorManager(int vip = 20, int influencer = 30, int general = 100);
+    SpectatorManager(int vip = 20, int influencer = 30, int general = 100, ostream* output = &cout,
+                     ChangeListener* listener = nullptr);
     ~SpectatorManager();
     
+    void setOutput(ostream* output) { out = outputOrDiscard(output); }   // nullptr = silent
+    void setListener(ChangeListener* listener) { changes = listener; }
+    
     // Main operations
     void registerSpectator();               // Register new spectator
-    void allocateSeating();                 // Process queue and assign seats
-    void removeSpectator();                 // Remove seated spectator
+    bool addSpectator(const Spectator& spectator);   // Queue a spectator, false if email taken
+    bool restoreSpectator(const Spectator& spectator, int seatId);  // Seat (or queue if -1) as saved
+    void reserveSpectators(int count);      // Presize queue and indexes before a bulk restore
+    int allocateSeating();                  // Process queue and assign seats, returns seats filled
+    bool allocateGroupSeating(Spectator group[], int groupSize);  // Seat a group side by side
+    void removeSpectator();                 // Remove seated or waiting spectator
     void searchSpectator();                 // Find spectator by name/email
     
+    // Indexed lookup
+    bool removeSpectatorByEmail(const string& email);
+    bool findSpectatorByEmail(const string& email, Spectator& result) const;
+    int findSpectatorsByName(const string& prefix, Spectator results[], int maxResults) const;
+    bool isRegistered(const string& email) const;
+    
+    // Ticket changes for waiting spectators
+    void upgradeSpectator();                // Change ticket type of a waiting spectator
+    bool changeSpectatorType(const string& email, const string& newType);
+    
+    // Concurrent intake (submit from any thread, process on the owner thread)
+    SpectatorIntakeQueue* getIntakeQueue() { return intake; }
+    int processIntake();                    // Drain pending registrations, returns number added
+    
     // Display functions
     void displayWaitingQueue();             // Show all waiting spectators
+    int getTopWaiting(int k, Spectator results[]) const;  // Next k spectators to be seated
     void displaySeatedSpectators();         // Show all seated spectators
     void displayVenueStatus();              // Show seat availability
     void displayStatistics();               // Show system statistics
     
     // File operations
-    void saveToFile(const string& filename);        // Save spectator data to CSV
-    void loadFromFile(const string& filename);      // Load spectator data from CSV
+    bool saveToFile(const string& filename);        // Save spectator data to CSV
+    bool loadFromFile(const string& filename);      // Load spectator data from CSV
+    bool writeSnapshot(const string& filename);     // Rewrite file with all spectators
+    bool appendChanges(const string& filename);     // Append rows changed since last save
+    int getPendingChanges() const { return changeCount; }
     
     // System management
     void displayMenu();                     // Main menu interface
     void runSystem();                       // Main system loop
     
     // Utility functions
+    int getWaitingCount() const { return waitingQueue->getSize(); }
+    int getSeatedCount() const { return occupiedSeats; }
+    VenueStatus getVenueStatus() const;
+    void countByTier(int waitingByType[3], int seatedByTier[3]) const;    // Scans the waiting queue
+    void copySpectators(vector<Spectator>& spectators, vector<int>* seatIds = nullptr) const;  // Seated, then waiting in heap order
+    void getSeatCapacity(int seatsByTier[3]) const;
     bool hasAvailableSeats(const string& spectatorType);
-    string assignSeatSection(const string& spectatorType);
+    int assignSeat(const string& spectatorType);    // Take a seat, -1 if none
     void updateSeatStatus(const string& spectatorType, bool occupy);
 };
 
@@ -0,0 +1,115 @@
+#include "spectator_store.hpp"
+#include <cstring>
+#include <unistd.h>
+
+// ===== SPECTATOR CSV WRITER IMPLEMENTATION =====
+
+SpectatorCsvWriter::SpectatorCsvWriter()
+    : file(nullptr), used(0), failed(false), rowsWritten(0) {
+    buffer = new char[SPECTATOR_WRITE_BUFFER_SIZE];
+}
+
+SpectatorCsvWriter::~SpectatorCsvWriter() {
+    close();
+    delete[] buffer;
+}
+
+bool SpectatorCsvWriter::open(const string& filename, bool appendMode) {
+    close();
+    file = fopen(filename.c_str(), appendMode ? "ab" : "wb");
+    used = 0;
+    failed = false;
+    rowsWritten = 0;
+    return file != nullptr;
+}
+
+bool SpectatorCsvWriter::close(bool durable) {
+    if (file == nullptr) return !failed;
+
+    flush();
+    if (durable && (fflush(file) != 0 || fsync(fileno(file)) != 0)) {
+        failed = true;
+    }
+    if (fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
+
+bool SpectatorCsvWriter::flush() {
+    if (used > 0 && file != nullptr) {
+        if (fwrite(buffer, 1, used, file) != (size_t)used) {
+            failed = true;
+        }
+    }
+    used = 0;
+    return !failed;
+}
+
+void SpectatorCsvWriter::append(const char* data, int length) {
+    while (length > 0) {
+        if (used == SPECTATOR_WRITE_BUFFER_SIZE) {
+            flush();
+        }
+        int chunk = SPECTATOR_WRITE_BUFFER_SIZE - used;
+        if (chunk > length) chunk = length;
+        memcpy(buffer + used, data, chunk);
+        used += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+void SpectatorCsvWriter::appendChar(char c) {
+    if (used == SPECTATOR_WRITE_BUFFER_SIZE) {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+void SpectatorCsvWriter::appendInt(int value) {
+    char digits[12];
+    int length = 0;
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+
+    do {
+        digits[length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (value < 0) {
+        appendChar('-');
+    }
+    while (length > 0) {
+        appendChar(digits[--length]);
+    }
+}
+
+void SpectatorCsvWriter::writeHeader() {
+    static const char header[] = "Name,Email,Type,ArrivalTime,SeatSection,IsSeated\n";
+    append(header, (int)sizeof(header) - 1);
+}
+
+void SpectatorCsvWriter::writeSpectator(const Spectator& spectator) {
+    append(spectator.getName());
+    appendChar(',');
+    append(spectator.getEmail());
+    appendChar(',');
+    append(spectator.getSpectatorType());
+    appendChar(',');
+    appendInt(spectator.getArrivalTime());
+    appendChar(',');
+    append(spectator.getSeatSection());
+    appendChar(',');
+    appendChar(spectator.getIsSeated() ? '1' : '0');
+    appendChar('\n');
+    rowsWritten++;
+}
+
+void SpectatorCsvWriter::writeRemoval(const string& email) {
+    appendChar(',');
+    append(email);
+    append(",General,0,,D\n", 14);
+    rowsWritten++;
+}
@@ -0,0 +1,50 @@
+#ifndef SPECTATOR_STORE_HPP
+#define SPECTATOR_STORE_HPP
+
+#include <cstdio>
+#include <string>
+#include "spectator_manager.hpp"
+using namespace std;
+
+const int SPECTATOR_WRITE_BUFFER_SIZE = 64 * 1024;
+
+// Streaming CSV writer for spectator rows.
+// Rows are formatted straight into one reusable buffer that is written
+// out in large blocks, instead of building a temporary string per row.
+// Row layout: Name,Email,Type,ArrivalTime,SeatSection,IsSeated
+// IsSeated is "1" (seated), "0" (waiting) or "D" (removed since an
+// earlier row; only written by incremental snapshots).
+class SpectatorCsvWriter {
+private:
+    FILE* file;
+    char* buffer;
+    int used;               // Bytes currently buffered
+    bool failed;            // A write to the file failed
+    int rowsWritten;
+
+    void append(const char* data, int length);
+    void append(const string& text) { append(text.data(), (int)text.size()); }
+    void appendChar(char c);
+    void appendInt(int value);
+    bool flush();
+
+    // Disable copying (owns the file and buffer)
+    SpectatorCsvWriter(const SpectatorCsvWriter&);
+    SpectatorCsvWriter& operator=(const SpectatorCsvWriter&);
+
+public:
+    SpectatorCsvWriter();
+    ~SpectatorCsvWriter();
+
+    bool open(const string& filename, bool appendMode);
+    bool close(bool durable = false);   // Flush (and fsync if durable) and close, false if any write failed
+
+    void writeHeader();
+    void writeSpectator(const Spectator& spectator);
+    void writeRemoval(const string& email);
+
+    bool isOpen() const { return file != nullptr; }
+    int getRowsWritten() const { return rowsWritten; }
+};
+
+#endif
@@ -0,0 +1,139 @@
+#include "system_state.hpp"
+
+SystemState::SystemState()
+    : teams(0), wildcardTeams(0), teamsSelected(false),
+      players(0), checkedInPlayers(0), wildcardPlayers(0),
+      matchesPlayed(0), tournamentRunning(false), eventsApplied(0) {
+    for (int i = 0; i < 3; i++) {
+        waiting[i] = 0;
+        seated[i] = 0;
+    }
+}
+
+int SystemState::tierIndex(const string& type) {
+    if (type == "VIP") return 0;
+    if (type == "Influencer") return 1;
+    return 2;
+}
+
+TeamRecord& SystemState::teamRecord(const string& name) {
+    unordered_map<string, TeamRecord>::iterator it = teamRecords.find(name);
+    if (it != teamRecords.end()) {
+        return it->second;
+    }
+    TeamRecord& record = teamRecords[name];
+    record.registered = false;
+    record.wins = 0;
+    record.losses = 0;
+    return record;
+}
+
+bool SystemState::findTeam(const string& name, TeamRecord& record) const {
+    unordered_map<string, TeamRecord>::const_iterator it = teamRecords.find(name);
+    if (it == teamRecords.end()) {
+        return false;
+    }
+    record = it->second;
+    return true;
+}
+
+void SystemState::onChange(ChangeKind kind, const string& subject, const string& detail) {
+    eventsApplied++;
+
+    switch (kind) {
+        case TEAM_REGISTERED: {
+            TeamRecord& record = teamRecord(subject);
+            record.status = detail;
+            record.registered = true;
+            teams++;
+            if (detail == "wild card") wildcardTeams++;
+            break;
+        }
+        case TEAM_WITHDRAWN:
+            teams--;
+            if (detail == "wild card") wildcardTeams--;
+            teamRecords.erase(subject);
+            break;
+        case TEAM_RENAMED: {
+            TeamRecord record = teamRecord(subject);
+            teamRecords.erase(subject);
+            teamRecords[detail] = record;
+            break;
+        }
+        case TEAMS_SELECTED:
+            teamsSelected = true;
+            selectedTeamsFile = subject;
+            break;
+
+        case PLAYERS_CLEARED:
+            players = 0;
+            checkedInPlayers = 0;
+            wildcardPlayers = 0;
+            break;
+        case PLAYER_REGISTERED:
+            players++;
+            break;
+        case PLAYER_WITHDRAWN:
+            players--;
+            if (detail == "checked-in") checkedInPlayers--;
+            break;
+        case PLAYER_CHECKED_IN:
+            checkedInPlayers++;
+            break;
+        case WILDCARD_ADDED:
+            wildcardPlayers++;
+            break;
+        case WILDCARD_REMOVED:
+            wildcardPlayers--;
+            break;
+
+        case SPECTATOR_QUEUED:
+            waiting[tierIndex(detail)]++;
+            break;
+        case SPECTATOR_DEQUEUED:
+            waiting[tierIndex(detail)]--;
+            break;
+        case SPECTATOR_SEATED:
+            seated[tierIndex(detail)]++;
+            break;
+        case SPECTATOR_UNSEATED:
+            seated[tierIndex(detail)]--;
+            break;
+
+        case TOURNAMENT_STARTED:
+            // Results describe the current tournament only
+            for (unordered_map<string, TeamRecord>::iterator it = teamRecords.begin();
+                 it != teamRecords.end(); ++it) {
+                it->second.wins = 0;
+                it->second.losses = 0;
+            }
+            matchesPlayed = 0;
+            tournamentRunning = true;
+            champion.clear();
+            break;
+        case MATCH_READY:
+            break;              // Ready matches are listed by the scheduler
+        case MATCH_PLAYED:
+            teamRecord(subject).wins++;
+            teamRecord(detail).losses++;
+            matchesPlayed++;
+            break;
+        case TOURNAMENT_FINISHED:
+            tournamentRunning = false;
+            champion = subject;
+            break;
+    }
+}
+
+void SystemState::resetPlayers(int roster, int checkedIn, int wildcards) {
+    players = roster;
+    checkedInPlayers = checkedIn;
+    wildcardPlayers = wildcards;
+}
+
+void SystemState::resetSpectators(const int waitingByTier[3], const int seatedByTier[3]) {
+    for (int i = 0; i < 3; i++) {
+        waiting[i] = waitingByTier[i];
+        seated[i] = seatedByTier[i];
+    }
+}
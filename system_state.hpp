@@ -0,0 +1,78 @@
+#ifndef SYSTEM_STATE_HPP
+#define SYSTEM_STATE_HPP
+
+#include "apuec_events.hpp"
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// Registration status and current-tournament results of one team
+struct TeamRecord {
+    string status;          // "early bird", "normal", "wild card"; "" if not registered here
+    bool registered;
+    int wins;
+    int losses;
+};
+
+// Cross-module view of the tournament, maintained from module deltas.
+// Every query is O(1) (team lookups are one hash probe); nothing here
+// reads module containers or files. APUECCore compares these counts
+// with the modules only when asked to synchronize or validate.
+class SystemState : public ChangeListener {
+private:
+    int teams;
+    int wildcardTeams;
+    bool teamsSelected;             // Tournament teams written by endRegistration
+    string selectedTeamsFile;
+
+    int players;                    // Early-bird and normal roster
+    int checkedInPlayers;
+    int wildcardPlayers;            // Waiting on the wildcard stack
+
+    int waiting[3];                 // By spectator type: VIP, Influencer, General
+    int seated[3];                  // By seat tier
+
+    int matchesPlayed;
+    bool tournamentRunning;
+    string champion;
+
+    long long eventsApplied;
+    unordered_map<string, TeamRecord> teamRecords;
+
+    static int tierIndex(const string& type);
+    TeamRecord& teamRecord(const string& name);
+
+public:
+    SystemState();
+
+    void onChange(ChangeKind kind, const string& subject, const string& detail) override;
+
+    int getTeamCount() const { return teams; }
+    int getWildcardTeamCount() const { return wildcardTeams; }
+    bool areTeamsSelected() const { return teamsSelected; }
+    const string& getSelectedTeamsFile() const { return selectedTeamsFile; }
+
+    int getPlayerCount() const { return players; }
+    int getCheckedInCount() const { return checkedInPlayers; }
+    int getWildcardPlayerCount() const { return wildcardPlayers; }
+
+    int getWaitingCount() const { return waiting[0] + waiting[1] + waiting[2]; }
+    int getSeatedCount() const { return seated[0] + seated[1] + seated[2]; }
+    int getWaitingCount(int tier) const { return waiting[tier]; }
+    int getSeatedCount(int tier) const { return seated[tier]; }
+
+    int getMatchesPlayed() const { return matchesPlayed; }
+    bool isTournamentRunning() const { return tournamentRunning; }
+    const string& getChampion() const { return champion; }
+
+    long long getEventsApplied() const { return eventsApplied; }
+    bool findTeam(const string& name, TeamRecord& record) const;
+    const unordered_map<string, TeamRecord>& getTeamRecords() const { return teamRecords; }
+
+    // Overwrite counters with values recounted from the modules
+    void resetPlayers(int roster, int checkedIn, int wildcards);
+    void resetSpectators(const int waitingByTier[3], const int seatedByTier[3]);
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "task_pool.hpp"
+#include "apuec_trace.hpp"
+
+TaskPool::TaskPool(int threadCount) : running(0), stopping(false) {
+    if (threadCount < 1) threadCount = 1;
+    for (int i = 0; i < threadCount; i++) {
+        threads.push_back(thread(&TaskPool::workerLoop, this));
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+void TaskPool::submit(const function<void()>& task) {
+    {
+        lock_guard<mutex> guard(lock);
+        tasks.push_back(task);
+    }
+    workReady.notify_one();
+}
+
+void TaskPool::wait() {
+    unique_lock<mutex> guard(lock);
+    while (!tasks.empty() || running > 0) {
+        idle.wait(guard);
+    }
+}
+
+void TaskPool::workerLoop() {
+    Tracer::setThreadName("task pool");
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        while (tasks.empty() && !stopping) {
+            workReady.wait(guard);
+        }
+        if (tasks.empty()) {
+            return;     // Stopping and drained
+        }
+
+        function<void()> task = tasks.front();
+        tasks.pop_front();
+        running++;
+        guard.unlock();
+
+        task();
+
+        guard.lock();
+        running--;
+        if (running == 0 && tasks.empty()) {
+            idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef TASK_POOL_HPP
+#define TASK_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Fixed set of worker threads running submitted tasks in FIFO order.
+// wait() blocks until every task submitted so far has finished, so one
+// pool can be reused for successive batches of work.
+class TaskPool {
+private:
+    vector<thread> threads;
+    deque<function<void()> > tasks;
+    mutex lock;
+    condition_variable workReady;   // Signalled on submit and shutdown
+    condition_variable idle;        // Signalled when the last running task ends
+    int running;                    // Tasks taken but not finished
+    bool stopping;
+
+    void workerLoop();
+
+    // Disable copying (owns threads)
+    TaskPool(const TaskPool&);
+    TaskPool& operator=(const TaskPool&);
+
+public:
+    TaskPool(int threadCount);
+    ~TaskPool();                    // Finishes queued tasks, then joins
+
+    void submit(const function<void()>& task);
+    void wait();
+
+    int getThreadCount() const { return (int)threads.size(); }
+};
+
+#endif
@@ -0,0 +1,233 @@
+#include "what_if.hpp"
+#include "apuec_trace.hpp"
+#include <cmath>
+
+OutcomeModel::OutcomeModel(int entrants, double defaultRating) {
+    rating.assign(entrants < 0 ? 0 : entrants, defaultRating);
+    strength.assign(rating.size(), pow(10.0, defaultRating / 400.0));
+}
+
+void OutcomeModel::setRating(int entrant, double value) {
+    if (entrant < 0 || entrant >= (int)rating.size()) {
+        return;
+    }
+    rating[entrant] = value;
+    strength[entrant] = pow(10.0, value / 400.0);
+}
+
+WhatIfEngine::WhatIfEngine(const Bracket& plannedBracket, const OutcomeModel& outcomes)
+    : bracket(plannedBracket), model(outcomes), size(plannedBracket.getSize()),
+      rounds(plannedBracket.getUpperRounds()), evidenceProbability(0.0) {
+    entrantAt.assign(size, SLOT_EMPTY);
+    positionOf.assign(bracket.getEntrantCount(), -1);
+    teamsBefore.assign(size + 1, 0);
+    upperNode.assign(rounds * (size / 2), -1);
+    assumed.assign(upperNode.size(), -1);
+    evidence.assign(upperNode.size(), -1);
+    inside.assign(rounds * size, 0.0);
+    outside.assign(rounds * size, 0.0);
+
+    // Upper nodes of a round are stored in match order
+    vector<int> nextMatch(rounds, 0);
+    for (int node = 0; node < bracket.getNodeCount(); node++) {
+        const BracketNode& info = bracket.getNode(node);
+        if (info.side == SIDE_UPPER) {
+            upperNode[info.round * (size / 2) + nextMatch[info.round]++] = node;
+        }
+    }
+}
+
+bool WhatIfEngine::hasTeams(int first, int count) const {
+    return teamsBefore[first + count] > teamsBefore[first];
+}
+
+bool WhatIfEngine::allows(int round, int position) const {
+    int winner = evidence[matchIndex(round, position)];
+    return winner < 0 || winner == entrantAt[position];
+}
+
+bool WhatIfEngine::assume(int round, int position, int winner) {
+    int match = matchIndex(round, position);
+    int played = bracket.getWinner(upperNode[match]);
+    if ((played >= 0 && played != winner) || (assumed[match] >= 0 && assumed[match] != winner)) {
+        return false;
+    }
+    assumed[match] = winner;
+    return true;
+}
+
+// First-round position of an entrant, as placed by Bracket::start
+int WhatIfEngine::findPosition(int entrant) const {
+    if (entrant < 0 || entrant >= bracket.getEntrantCount()) {
+        return -1;
+    }
+    for (int p = 0; p < size; p++) {
+        if (bracket.getTeam(p / 2, p % 2) == entrant) return p;
+    }
+    return -1;
+}
+
+bool WhatIfEngine::fix(int winner, int loser) {
+    int a = findPosition(winner);
+    int b = findPosition(loser);
+    if (a < 0 || b < 0 || a == b) {
+        return false;
+    }
+    // They meet in the round of the highest bit where their positions differ
+    int round = 0;
+    while ((a ^ b) >> (round + 1)) {
+        round++;
+    }
+    bool ok = assume(round, a, winner);
+    if (ok && round > 0) {
+        ok = assume(round - 1, b, loser);
+    }
+    return ok;
+}
+
+bool WhatIfEngine::fixNext(int entrant) {
+    int position = findPosition(entrant);
+    if (position < 0) {
+        return false;
+    }
+    for (int round = 0; round < rounds; round++) {
+        int played = bracket.getWinner(upperNode[matchIndex(round, position)]);
+        if (played < 0) {
+            return assume(round, position, entrant);
+        }
+        if (played != entrant) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool WhatIfEngine::inUpperBracket(int entrant) const {
+    int position = findPosition(entrant);
+    if (position < 0) {
+        return false;
+    }
+    for (int round = 0; round < rounds; round++) {
+        int played = bracket.getWinner(upperNode[matchIndex(round, position)]);
+        if (played < 0) {
+            return true;
+        }
+        if (played != entrant) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WhatIfEngine::clearFixes() {
+    for (size_t i = 0; i < assumed.size(); i++) {
+        assumed[i] = -1;
+    }
+}
+
+bool WhatIfEngine::evaluate() {
+    APUEC_TRACE_SCOPE("WhatIfEngine::evaluate");
+    for (size_t i = 0; i < positionOf.size(); i++) {
+        positionOf[i] = -1;
+    }
+    for (int p = 0; p < size; p++) {
+        int entrant = bracket.getTeam(p / 2, p % 2);
+        entrantAt[p] = entrant >= 0 ? entrant : SLOT_EMPTY;
+        if (entrant >= 0) positionOf[entrant] = p;
+        teamsBefore[p + 1] = teamsBefore[p] + (entrant >= 0 ? 1 : 0);
+    }
+    for (size_t i = 0; i < evidence.size(); i++) {
+        int played = upperNode[i] >= 0 ? bracket.getWinner(upperNode[i]) : -1;
+        evidence[i] = played >= 0 ? played : assumed[i];
+    }
+
+    // Inside, bottom-up. Below round 0 a position holds its entrant for sure.
+    for (int round = 0; round < rounds; round++) {
+        int half = 1 << round;
+        double* current = &inside[round * size];
+        const double* below = (round > 0) ? &inside[(round - 1) * size] : nullptr;
+        for (int first = 0; first < size; first += 2 * half) {
+            for (int side = 0; side < 2; side++) {
+                int own = first + side * half;
+                int other = first + (1 - side) * half;
+                bool opponent = hasTeams(other, half);
+                for (int p = own; p < own + half; p++) {
+                    double reach = (entrantAt[p] < 0) ? 0.0 : (below ? below[p] : 1.0);
+                    if (reach == 0.0 || !allows(round, p)) {
+                        current[p] = 0.0;
+                        continue;
+                    }
+                    if (!opponent) {
+                        current[p] = reach;     // Bye
+                        continue;
+                    }
+                    double win = 0.0;
+                    for (int q = other; q < other + half; q++) {
+                        double theirs = (entrantAt[q] < 0) ? 0.0 : (below ? below[q] : 1.0);
+                        if (theirs != 0.0) win += theirs * model.winProbability(entrantAt[p], entrantAt[q]);
+                    }
+                    current[p] = reach * win;
+                }
+            }
+        }
+    }
+
+    evidenceProbability = 0.0;
+    const double* top = &inside[(rounds - 1) * size];
+    for (int p = 0; p < size; p++) {
+        evidenceProbability += top[p];
+    }
+    if (evidenceProbability <= 0.0) {
+        return false;
+    }
+
+    // Outside, top-down: the match a range feeds is decided against the
+    // winner of the sibling range, then everything above it must hold
+    double* last = &outside[(rounds - 1) * size];
+    for (int p = 0; p < size; p++) {
+        last[p] = 1.0;
+    }
+    for (int round = rounds - 2; round >= 0; round--) {
+        int span = 2 << round;      // Positions under one round-`round` match
+        double* current = &outside[round * size];
+        const double* above = &outside[(round + 1) * size];
+        const double* winners = &inside[round * size];
+        for (int first = 0; first < size; first += span) {
+            int sibling = first ^ span;
+            bool opponent = hasTeams(sibling, span);
+            for (int p = first; p < first + span; p++) {
+                double ifWins = allows(round + 1, p) ? above[p] : 0.0;
+                if (entrantAt[p] < 0) {
+                    current[p] = 0.0;
+                } else if (!opponent) {
+                    current[p] = ifWins;
+                } else {
+                    double total = 0.0;
+                    for (int q = sibling; q < sibling + span; q++) {
+                        if (winners[q] == 0.0) continue;
+                        double pWins = model.winProbability(entrantAt[p], entrantAt[q]);
+                        double ifLoses = allows(round + 1, q) ? above[q] : 0.0;
+                        total += winners[q] * (pWins * ifWins + (1.0 - pWins) * ifLoses);
+                    }
+                    current[p] = total;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+double WhatIfEngine::getReachProbability(int entrant, int round) const {
+    if (entrant < 0 || entrant >= (int)positionOf.size() || round < 0 || round > rounds ||
+        evidenceProbability <= 0.0) {
+        return 0.0;
+    }
+    int p = positionOf[entrant];
+    if (p < 0) {
+        return 0.0;
+    }
+    if (round == 0) {
+        return 1.0;
+    }
+    return inside[(round - 1) * size + p] * outside[(round - 1) * size + p] / evidenceProbability;
+}
@@ -0,0 +1,94 @@
+#ifndef WHAT_IF_HPP
+#define WHAT_IF_HPP
+
+#include "bracket.hpp"
+#include <vector>
+using namespace std;
+
+// Chance that one entrant beats another: Elo ratings, where a 400 point
+// gap is 10:1 odds. Equal ratings (the default) give the coin flip the
+// scheduler simulates with.
+class OutcomeModel {
+private:
+    vector<double> strength;    // 10^(rating / 400), so a wins with strength[a] / (strength[a] + strength[b])
+    vector<double> rating;
+
+public:
+    explicit OutcomeModel(int entrants, double defaultRating = 1500.0);
+
+    int getEntrantCount() const { return (int)rating.size(); }
+    void setRating(int entrant, double value);
+    double getRating(int entrant) const { return rating[entrant]; }
+    double winProbability(int a, int b) const { return strength[a] / (strength[a] + strength[b]); }
+};
+
+// Exact "what if" probabilities for the upper bracket of a Bracket (the
+// whole bracket for single elimination), by dynamic programming over its
+// tree instead of sampling. Played results and the assumed results (fix)
+// are evidence; every answer is conditional on all of it.
+//
+// inside[r][p]: probability that the entrant at first-round position p
+// wins its round-r match and every result fixed below that match holds.
+// Built bottom-up: a team's chance times its chance to beat each possible
+// opponent from the other half of the match's range.
+// outside[r][p]: probability that every result fixed outside that match's
+// range holds, given p won it. Built top-down from the sibling range.
+// P(p wins round r | evidence) = inside * outside / P(evidence).
+// Both passes touch every pair of positions that can meet once, O(n^2)
+// for n entrants (about 16k pair terms for 128), with no allocation per
+// evaluation.
+//
+// Lower bracket and grand final results are not covered: which teams drop
+// into the lower bracket depends on the same upper matches the other
+// lower bracket slot does, so those matches do not form a tree. For a
+// double-elimination bracket the last answer is "wins the upper bracket".
+class WhatIfEngine {
+private:
+    const Bracket& bracket;
+    const OutcomeModel& model;
+    int size;
+    int rounds;                 // Upper bracket rounds
+    vector<int> entrantAt;      // Position -> entrant or SLOT_EMPTY
+    vector<int> positionOf;     // Entrant -> position
+    vector<int> teamsBefore;    // Position -> entrants at earlier positions
+    vector<int> upperNode;      // round * size / 2 + match -> bracket node
+    vector<int> assumed;        // Same index -> entrant fixed to win (-1 = none)
+    vector<int> evidence;       // Played or assumed winner (-1 = open)
+    vector<double> inside;      // round * size + position
+    vector<double> outside;
+    double evidenceProbability;
+
+    int matchIndex(int round, int position) const { return round * (size / 2) + (position >> (round + 1)); }
+    int findPosition(int entrant) const;
+    bool hasTeams(int first, int count) const;
+    bool allows(int round, int position) const;
+    bool assume(int round, int position, int winner);
+
+public:
+    WhatIfEngine(const Bracket& plannedBracket, const OutcomeModel& outcomes);
+
+    int getRounds() const { return rounds; }
+    int getUpperNode(int round, int match) const { return upperNode[round * (size / 2) + match]; }
+
+    // Assume winner beats loser in the upper match where they would meet
+    // (so both reach it). False if that contradicts a result already
+    // played or assumed, or either is not an entrant.
+    bool fix(int winner, int loser);
+    // Assume entrant wins its next unplayed upper match. False if it is
+    // out of the upper bracket or has no match left.
+    bool fixNext(int entrant);
+    void clearFixes();
+    // False once entrant has lost a played upper match (in double
+    // elimination it may still be alive in the lower bracket)
+    bool inUpperBracket(int entrant) const;
+
+    // Run both passes against the bracket's current results. False if
+    // the evidence is impossible (an assumed winner cannot get there).
+    bool evaluate();
+    double getEvidenceProbability() const { return evidenceProbability; }   // Played results included
+    // Probability that entrant plays in upper round `round` (0-based);
+    // round == getRounds() means winning the whole (upper) bracket
+    double getReachProbability(int entrant, int round) const;
+};
+
+#endif